@@ -1,10 +1,27 @@
 ﻿#include "pch.h"
 
+#include <algorithm>
 #include <array>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <shared_mutex>
+#include <thread>
 
 #include "Stopwatch.h"
 #include "CallMe.Event.h"
+#include "CallMe.AsyncEvent.h"
+#include "CallMe.ConcurrentEvent.h"
+#include "CallMe.DelegateMailbox.h"
+#include "CallMe.TaskPool.h"
+#include "CallMe.TimerWheel.h"
+#include "CallMe.WorkStealingPool.h"
 
 #if defined(_MSC_VER) && !defined(CMAKE)
 import pretty;
@@ -57,6 +74,11 @@ struct TargetObject
 		*o2 = i2.size();
 	}
 
+	int NOINLINE NonInlinedValue(const std::string& i2) const
+	{
+		return _i + int(i2.size());
+	}
+
 	int _i = 1;
 };
 
@@ -78,6 +100,9 @@ NOINLINE void NoninlinedFreeFunction(std::string& i2, volatile int* o1, volatile
 }
 
 using OwningDelegateT = OwningDelegate<FreeSignature>;
+using InlineOwningDelegateT = OwningDelegate<FreeSignature, 4 * sizeof(void*)>;
+using SharedDelegateT = SharedDelegate<FreeSignature>;
+using NonAtomicSharedDelegateT = SharedDelegate<FreeSignature, RefCounting::NonAtomic>;
 using DelegateT = Delegate<FreeSignature>;
 using bitwizDelegate = cpp::delegate<void(std::string&, int*, std::size_t*)>;
 
@@ -410,6 +435,97 @@ struct OwningDelegateMoveCtorBenchmark
 	}
 };
 
+//@make is a factory of OwningDelegate objects with different storage of targets
+struct OwningDelegateStorageBenchmark
+{
+	static DurationT BenchmarkConstruction(auto make)
+	{
+		Stopwatch time;
+		time.start();
+		for (auto i = nIters; i; --i)
+		{
+			auto delegate = make();
+			delegate(I2, &O1, &O2);
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	static DurationT BenchmarkMove(auto make)
+	{
+		auto delegateA = make();
+		auto delegateB = make();
+
+		Stopwatch time;
+		time.start();
+		MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
+		for (auto i = nIters; i; --i)
+		{
+			delegateB = std::move(delegateA);
+			delegateB(I2, &O1, &O2);
+			delegateA = std::move(delegateB);
+		}
+		MSVC_SUPPRESS_WARNING_POP
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	static DurationT BenchmarkInvocation(auto make)
+	{
+		auto delegate = make();
+		return BenchmarkInvocableDynamic(delegate);
+	}
+
+	static void AddRow(pretty::Table& table, std::string&& name, auto make)
+	{
+		table.addRow(std::move(name),
+					 toString(BenchmarkConstruction(make)),
+					 toString(BenchmarkMove(make)),
+					 toString(BenchmarkInvocation(make)));
+	}
+};
+
+//the common workaround for sharing a callback without SharedDelegate
+struct SharedStdFunction
+{
+	std::shared_ptr<std::function<FreeSignature>> function;
+
+	void operator()(std::string& i2, volatile int* o1, volatile std::size_t* o2) const
+	{
+		(*function)(i2, o1, o2);
+	}
+};
+
+//@make is a factory of shared callbacks
+struct SharedDelegateBenchmark
+{
+	static DurationT BenchmarkCopy(auto make)
+	{
+		auto original = make();
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nIters; i; --i)
+		{
+			auto copy = original;
+			copy(I2, &O1, &O2);
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	static void AddRow(pretty::Table& table, std::string&& name, auto make)
+	{
+		table.addRow(std::move(name),
+					 toString(OwningDelegateStorageBenchmark::BenchmarkConstruction(make)),
+					 toString(BenchmarkCopy(make)),
+					 toString(OwningDelegateStorageBenchmark::BenchmarkInvocation(make)));
+	}
+};
+
 struct OwningDelegateMoveAssignedBenchmark
 {
     static std::string Name() { return "ODelegate(nonempty)=move()"; }
@@ -824,167 +940,1629 @@ struct EventBenchmark
 
 		return time.elapsed();
 	}
-};
 
-struct ArgumentPassingBenchmark
-{
-	static NOINLINE void FunctionWithRefArgs(std::string&& a, std::string& b)
+	template<TargetMethod method>
+	static DurationT BenchmarkBatchedEventRaise()
 	{
-		b = std::move(a);
-	}
+		CallMe::Event<FreeSignature, nEventSubscriptions> event(nEventSubscriptions);
+
+		std::vector<TargetObject> targets(nEventSubscriptions);
+
+		std::vector<Subscription> subscriptions;
+		subscriptions.reserve(nEventSubscriptions);
+
+		for (auto& t : targets)
+		{
+			event.subscribe<method>(t, subscriptions);
+		}
+		assert(subscriptions.size() == targets.size());
 
-	template<typename Callable>
-	static DurationT Benchmark(Callable& callable)
-	{
 		Stopwatch time;
-		std::string a = "1234567890-=qwertyuiop[]asdfghjkl;'zxcvbnm,./";
-		std::string b;
 		time.start();
-
-		MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
-		for (auto i = nIters; i; --i)
+		for (auto i = nEventIters; i; --i)
 		{
-			callable(std::move(a), b);
-			callable(std::move(b), a);
+			event.raise(I2, &O1, &O2);
 		}
 		time.stop();
-		MSVC_SUPPRESS_WARNING_POP
 
 		return time.elapsed();
 	}
 
-	static DurationT BenchmarkDirectCall()
+	//sum the results of all subscribers with a combiner
+	static DurationT BenchmarkCollectSum()
 	{
-		return Benchmark(FunctionWithRefArgs);
-	}
+		CallMe::Event<int(const std::string&), nEventSubscriptions> event(nEventSubscriptions);
 
-	static DurationT BenchmarkDelegate()
-	{
-		Delegate d{tag<FunctionWithRefArgs>()};
-		return Benchmark(d);
+		std::vector<TargetObject> targets(nEventSubscriptions);
+
+		std::vector<Subscription> subscriptions;
+		subscriptions.reserve(nEventSubscriptions);
+
+		for (auto& t : targets)
+			event.subscribe(fromMethod<&TargetObject::NonInlinedValue>(t), subscriptions);
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nEventIters; i; --i)
+			O1 = event.collect(combiners::Sum<int>{}, I2);
+		time.stop();
+
+		return time.elapsed();
 	}
 
-	static DurationT BenchmarkEvent()
+	//sum the results of all subscribers gathered into a vector by void callbacks
+	static DurationT BenchmarkCollectIntoVector()
 	{
-		using signature = void(std::string&& a, std::string& b);
-		CallMe::Event<signature, 1> e;
-		auto sub = e.subscribe(fromFunction<FunctionWithRefArgs>());
-		return Benchmark(e);
-	}
-};
+		struct Collector
+		{
+			TargetObject* _target;
+			std::vector<int>* _results;
 
-int main()
-{
-	int i1 = 1;
+			void operator()(const std::string& i2)
+			{
+				_results->push_back(_target->NonInlinedValue(i2));
+			}
+		};
 
-	//when compiled with optimizations (Release mode),
-	//MSVC++ inlines this lambda
-	auto λInline = [&i1](std::string& i2,
-						volatile int* o1,
-						volatile std::size_t* o2) 
-	{
-		*o1 = i1;
-		*o2 = i2.size();
-	};
-	auto λNoninlined = [&i1](std::string& i2,
-							volatile int* o1,
-							volatile std::size_t* o2) NOINLINE
-	{
-		*o1 = i1;
-		*o2 = i2.size();
-	};
-	auto λCapturelessInline = [](std::string& i2,
-								  volatile int* o1,
-								  volatile std::size_t* o2) 
-	{
-		*o1 = I1;
-		*o2 = i2.size();
-	};
-	auto λCapturelessNoninlined = [](std::string& i2,
-									 volatile int* o1,
-									 volatile std::size_t* o2) NOINLINE
-	{
-		*o1 = I1;
-		*o2 = i2.size();
-	};
+		CallMe::Event<void(const std::string&), nEventSubscriptions> event(nEventSubscriptions);
 
-	pretty::Table tableInline;
-	pretty::Table tableNoninlined;
-	pretty::Table tableMoved;
-	pretty::Table tableInlineHeap;
-	pretty::Table tableDelegateAsParameter;
-	pretty::Table tableEvent;
-	pretty::Table tableArgumentPassing;
-	std::vector tables = 
-	{
-		&tableInline,
-		&tableNoninlined,
-		&tableInlineHeap,
-		&tableMoved,
-		&tableDelegateAsParameter
-	};
-	for(auto t : tables)
-		t->addRow("invocable", "λ with capture", "captureless λ", "method", "function");
+		std::vector<TargetObject> targets(nEventSubscriptions);
+		std::vector<int> results;
+		std::vector<Collector> collectors;
+		for (auto& t : targets)
+			collectors.push_back({&t, &results});
 
-	Benchmarks<std::tuple<
-		DirectCallBenchmark,
-		DelegateBenchmark,
-		OwningDelegateBenchmark/*,
-		BitwizeshiftDelegateBenchmark*/>> benchmarks;
+		std::vector<Subscription> subscriptions;
+		subscriptions.reserve(nEventSubscriptions);
 
-	pretty::RowN row{1};//skip header row
-	pretty::ColN col{};
+		for (auto& c : collectors)
+			event.subscribe(fromFunctor(c), subscriptions);
 
-	tableInline.title("Stack-allocated delegates, inlinable target");
-	tableNoninlined.title("Stack-allocated delegates, noninlinable target");
-	
-	{ //column: delegate names
-		{
-			ResultHandler h{ tableInline, row, col };
-			benchmarks.GatherNames(h);
-		}
+		Stopwatch time;
+		time.start();
+		for (auto i = nEventIters; i; --i)
 		{
-			ResultHandler h{ tableNoninlined, row, col };
-			benchmarks.GatherNames(h);
+			results.clear();
+			event.raise(I2);
+			O1 = std::accumulate(results.begin(), results.end(), 0);
 		}
+		time.stop();
+
+		return time.elapsed();
 	}
 
-	{ //column: lambda with capture
-		++col;
+	template<TargetMethod method>
+	static DurationT BenchmarkMethodEventRaise()
+	{
+		CallMe::MethodEvent<method, nEventSubscriptions> event(nEventSubscriptions);
+
+		std::vector<TargetObject> targets(nEventSubscriptions);
+
+		std::vector<Subscription> subscriptions;
+		subscriptions.reserve(nEventSubscriptions);
+
+		for (auto& t : targets)
 		{
-			ResultHandler h{ tableInline, row, col };
-			benchmarks.BenchmarkFunctor(λInline, h);
+			event.subscribe(t, subscriptions);
 		}
+		assert(subscriptions.size() == targets.size());
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nEventIters; i; --i)
 		{
-			ResultHandler h{ tableNoninlined, row, col };
-			benchmarks.BenchmarkFunctor(λNoninlined, h);
+			event.raise(I2, &O1, &O2);
 		}
+		time.stop();
+
+		return time.elapsed();
 	}
 
-	{ //column: captureless lambda
-		++col;
-		{
-			ResultHandler h{ tableInline, row, col };
-			benchmarks.BenchmarkFunctor(λCapturelessInline, h);
-		}
+	//one of the callbacks unsubscribes and subscribes a target during each dispatch
+	template<TargetMethod method>
+	static DurationT BenchmarkReentrantEventRaise()
+	{
+		using EventT = CallMe::Event<FreeSignature, nEventSubscriptions + 1>;
+		EventT event;
+
+		std::vector<TargetObject> targets(nEventSubscriptions);
+
+		std::vector<Subscription> subscriptions;
+		subscriptions.reserve(nEventSubscriptions);
+
+		for (auto i = 1; i != nEventSubscriptions; ++i)
 		{
-			ResultHandler h{ tableNoninlined, row, col };
-			benchmarks.BenchmarkFunctor(λCapturelessNoninlined, h);
+			event.subscribe(fromMethod<method>(targets[i]), subscriptions);
 		}
-	}
 
-	{ //column: method
-		++col;
-		TargetObject targetObj;
+		std::optional<Subscription> resubscribed{
+			std::in_place, event.subscribe(fromMethod<method>(targets[0])) };
+		auto resubscribe = [&](std::string&, volatile int*, volatile std::size_t*)
 		{
-			ResultHandler h{ tableInline, row, col };
-			benchmarks.BenchmarkMethod<&TargetObject::InlineMethod>(targetObj, h);
-		}
+			resubscribed.reset();
+			resubscribed.emplace(event.subscribe(fromMethod<method>(targets[0])));
+		};
+		auto resubscriber = event.subscribe(fromFunctor(resubscribe));
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nEventIters; i; --i)
 		{
-			ResultHandler h{ tableNoninlined, row, col };
-			benchmarks.BenchmarkMethod<&TargetObject::NonInlinedMethod>(targetObj, h);
+			event.raise(I2, &O1, &O2);
 		}
-	}
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	template<TargetMethod method, std::size_t...I>
+	static DurationT BenchmarkStaticEventRaise(std::index_sequence<I...>)
+	{
+		std::vector<TargetObject> targets(sizeof...(I));
+
+		auto event = makeStaticEvent<FreeSignature>(callMethod<method>(targets[I])...);
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nEventIters; i; --i)
+		{
+			event.raise(I2, &O1, &O2);
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	//sweep of the number of subscriptions, the total number of callback invocations is constant
+	static DurationT BenchmarkDirectCallSweep(std::ptrdiff_t nSubscriptions)
+	{
+		std::vector<TargetObject> targets(nSubscriptions);
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nIters / nSubscriptions; i; --i)
+		{
+			for (auto& t : targets)
+				t.InlineMethod(I2, &O1, &O2);
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	//Event's layout before the hot/cold split: {delegate, Subscription*} records
+	static DurationT BenchmarkArrayOfRecordsSweep(std::ptrdiff_t nSubscriptions)
+	{
+		struct SubscriptionRecord
+		{
+			Delegate<FreeSignature> _delegate;
+			CallMe::Subscription* _owner{ nullptr };
+		};
+
+		std::vector<TargetObject> targets(nSubscriptions);
+		std::vector<SubscriptionRecord> records;
+		records.reserve(nSubscriptions);
+		for (auto& t : targets)
+			records.push_back({ fromMethod<&TargetObject::InlineMethod>(t) });
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nIters / nSubscriptions; i; --i)
+		{
+			for (std::ptrdiff_t r = 0; r != std::ssize(records); ++r)
+				records[r]._delegate(I2, &O1, &O2);
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	static DurationT BenchmarkEventRaiseSweep(std::ptrdiff_t nSubscriptions)
+	{
+		//heap-allocated subscriptions, as 1M records don't fit the stack
+		CallMe::Event<FreeSignature, 1> event(static_cast<unsigned>(nSubscriptions));
+
+		std::vector<TargetObject> targets(nSubscriptions);
+
+		std::vector<Subscription> subscriptions;
+		subscriptions.reserve(nSubscriptions);
+		for (auto& t : targets)
+			event.subscribe(fromMethod<&TargetObject::InlineMethod>(t), subscriptions);
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nIters / nSubscriptions; i; --i)
+			event.raise(I2, &O1, &O2);
+		time.stop();
+
+		return time.elapsed();
+	}
+};
+
+//growth of vectors of callbacks by reallocation
+struct RelocationBenchmark
+{
+	//the same as Delegate, but not trivially relocatable, so it is moved element-wise
+	struct MovedDelegate : Delegate<FreeSignature>
+	{
+		explicit MovedDelegate(Delegate<FreeSignature>&& d) :
+			Delegate<FreeSignature>(std::move(d))
+		{
+		}
+	};
+
+	template<typename Callback>
+	static void Grow(std::ptrdiff_t nCallbacks, TargetObject& target)
+	{
+		gch::small_vector<Callback, 1> callbacks;
+		for (auto c = nCallbacks; c; --c)
+			callbacks.emplace_back(fromMethod<&TargetObject::InlineMethod>(&target));
+	}
+
+	template<typename Callback>
+	static DurationT BenchmarkGrowth(std::ptrdiff_t nCallbacks)
+	{
+		TargetObject target;
+
+		//the first growth to a new size is much slower, whatever the callbacks
+		Grow<Callback>(nCallbacks, target);
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nIters / nCallbacks / 10; i; --i)
+			Grow<Callback>(nCallbacks, target);
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	static DurationT BenchmarkEventGrowth(std::ptrdiff_t nSubscriptions)
+	{
+		std::vector<TargetObject> targets(nSubscriptions);
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nIters / nSubscriptions / 10; i; --i)
+		{
+			CallMe::Event<FreeSignature, 1> event;
+			std::vector<Subscription> subscriptions;
+			subscriptions.reserve(nSubscriptions);
+			for (auto& t : targets)
+				event.subscribe(fromMethod<&TargetObject::InlineMethod>(&t), subscriptions);
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+};
+
+//relocation of vectors of subscriptions to several events
+struct SubscriptionVectorBenchmark
+{
+	static constexpr auto nSubscriptions = 1000;
+	static constexpr auto nEvents = 4;
+
+	std::vector<TargetObject> _targets = std::vector<TargetObject>(nSubscriptions);
+	std::vector<CallMe::Event<FreeSignature, 1>> _events;
+
+	SubscriptionVectorBenchmark()
+	{
+		_events.reserve(nEvents);
+		for (auto i = 0; i != nEvents; ++i)
+			_events.emplace_back(nSubscriptions);
+	}
+
+	/* subscribe to @nUsedEvents events, either interleaved or in blocks,
+	then relocate the subscriptions twice per iteration */
+	template<typename VectorOfSubscriptions>
+	DurationT BenchmarkRelocation(int nUsedEvents, bool interleaved)
+	{
+		VectorOfSubscriptions subscriptions;
+		for (auto i = 0; i != nSubscriptions; ++i)
+		{
+			auto e = interleaved ? i % nUsedEvents : i * nUsedEvents / nSubscriptions;
+			_events[e].subscribe(fromMethod<&TargetObject::InlineMethod>(&_targets[i]), subscriptions);
+		}
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nIters / nSubscriptions / 10; i; --i)
+		{
+			subscriptions.reserve(2 * subscriptions.size());
+			subscriptions.shrink_to_fit();
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	void AddRow(pretty::Table& table, std::string&& name, int nUsedEvents, bool interleaved)
+	{
+		auto vector = BenchmarkRelocation<std::vector<Subscription>>(nUsedEvents, interleaved);
+		auto smallVector = BenchmarkRelocation<gch::small_vector<Subscription, 1>>(nUsedEvents, interleaved);
+		auto subscriptionVector = BenchmarkRelocation<SubscriptionVector>(nUsedEvents, interleaved);
+
+		table.addRow(std::move(name), toString(vector), toString(smallVector),
+					 toString(subscriptionVector));
+	}
+};
+
+//moving and destroying events with many subscriptions
+struct EventLifetimeBenchmark
+{
+	static constexpr auto nMoves = 100;
+	static constexpr auto nDestructions = 10;
+
+	template<EventStorage Storage>
+	using EventT = CallMe::Event<FreeSignature, 1, DispatchOrder::Unspecified, Storage>;
+
+	/* the subscriptions are shuffled, so that the records of the event
+	refer to Subscription objects in random order, like subscriptions
+	scattered around the heap */
+	template<EventStorage Storage>
+	static void Subscribe(EventT<Storage>& event,
+						  std::vector<TargetObject>& targets,
+						  std::vector<Subscription>& subscriptions)
+	{
+		subscriptions.reserve(targets.size());
+		for (auto& t : targets)
+			event.subscribe(fromMethod<&TargetObject::InlineMethod>(&t), subscriptions);
+
+		std::shuffle(subscriptions.begin(), subscriptions.end(), std::mt19937{ 42 });
+	}
+
+	template<EventStorage Storage>
+	static DurationT BenchmarkMove(std::ptrdiff_t nSubscriptions)
+	{
+		EventT<Storage> event1(static_cast<unsigned>(nSubscriptions));
+		EventT<Storage> event2;
+
+		std::vector<TargetObject> targets(nSubscriptions);
+		std::vector<Subscription> subscriptions;
+		Subscribe(event1, targets, subscriptions);
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nMoves / 2; i; --i)
+		{
+			event2 = std::move(event1);
+			event1 = std::move(event2);
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	template<EventStorage Storage>
+	static DurationT BenchmarkDestruction(std::ptrdiff_t nSubscriptions)
+	{
+		std::vector<TargetObject> targets(nSubscriptions);
+
+		DurationT elapsed{};
+		for (auto i = nDestructions; i; --i)
+		{
+			std::vector<Subscription> subscriptions;
+			Stopwatch time;
+			{
+				EventT<Storage> event(static_cast<unsigned>(nSubscriptions));
+				Subscribe(event, targets, subscriptions);
+
+				time.start();
+			}
+			time.stop();
+			elapsed += time.elapsed();
+		}
+
+		return elapsed;
+	}
+};
+
+//callbacks of 4 kinds of targets subscribed in random order
+struct EventDispatchOrderBenchmark
+{
+	static constexpr auto nSubscriptions = 1000;
+
+	struct TargetFunctor
+	{
+		void operator()(std::string& i2, volatile int* o1, volatile std::size_t* o2)
+		{
+			*o1 = _i;
+			*o2 = i2.size();
+		}
+
+		int _i = 2;
+	};
+
+	std::vector<TargetObject> _objects = std::vector<TargetObject>(nSubscriptions);
+	std::vector<TargetFunctor> _functors = std::vector<TargetFunctor>(nSubscriptions);
+	std::vector<Delegate<FreeSignature>> _callbacks;
+
+	EventDispatchOrderBenchmark()
+	{
+		_callbacks.reserve(nSubscriptions);
+		for (auto i = 0; i != nSubscriptions; ++i)
+		{
+			switch (i % 4)
+			{
+			case 0: _callbacks.push_back(fromMethod<&TargetObject::InlineMethod>(_objects[i])); break;
+			case 1: _callbacks.push_back(fromMethod<&TargetObject::NonInlinedMethod>(_objects[i])); break;
+			case 2: _callbacks.push_back(fromFunctor(_functors[i])); break;
+			default: _callbacks.push_back(fromFunction<&NoninlinedFreeFunction>()); break;
+			}
+		}
+
+		std::shuffle(_callbacks.begin(), _callbacks.end(), std::mt19937{ 42 });
+	}
+
+	template<DispatchOrder Order>
+	DurationT BenchmarkEventRaise(bool optimizeOrder)
+	{
+		CallMe::Event<FreeSignature, 1, Order> event(nSubscriptions);
+
+		std::vector<Subscription> subscriptions;
+		subscriptions.reserve(nSubscriptions);
+		for (std::size_t i = 0; i != _callbacks.size(); ++i)
+		{
+			if constexpr (Order == DispatchOrder::Priority)
+				event.subscribe(Delegate(_callbacks[i]), int(i % 4), subscriptions);
+			else
+				event.subscribe(Delegate(_callbacks[i]), subscriptions);
+		}
+
+		if constexpr (Order == DispatchOrder::Unspecified || Order == DispatchOrder::Grouped)
+		{
+			if (optimizeOrder)
+				event.optimizeOrder();
+		}
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nIters / nSubscriptions; i; --i)
+			event.raise(I2, &O1, &O2);
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	//unsubscribe and resubscribe a subscription in the middle, raise now and then
+	template<DispatchOrder Order, EventStorage Storage = EventStorage::BackPointers>
+	DurationT BenchmarkChurn()
+	{
+		CallMe::Event<FreeSignature, 1, Order, Storage> event(nSubscriptions);
+
+		std::vector<decltype(event.subscribe(Delegate(_callbacks[0])))> subscriptions;
+		subscriptions.reserve(nSubscriptions);
+		for (auto& c : _callbacks)
+			event.subscribe(Delegate(c), subscriptions);
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nIters / 10; i; --i)
+		{
+			auto& s = subscriptions[i % nSubscriptions];
+			s = event.subscribe(Delegate(_callbacks[i % nSubscriptions]));
+			if (i % nSubscriptions == 0)
+				event.raise(I2, &O1, &O2);
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	//subscribe all callbacks one by one, then unsubscribe them one by one
+	DurationT BenchmarkSubscribeEach()
+	{
+		Stopwatch time;
+		time.start();
+		for (auto i = nIters / nSubscriptions / 10; i; --i)
+		{
+			CallMe::Event<FreeSignature, 1> event;
+			std::vector<Subscription> subscriptions;
+			for (auto& c : _callbacks)
+				event.subscribe(Delegate(c), subscriptions);
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	/* subscribe all callbacks one by one into a vector that is not reserved,
+	so that it reallocates and moves the subscriptions, then unsubscribe all */
+	template<EventStorage Storage>
+	DurationT BenchmarkVectorGrowth()
+	{
+		Stopwatch time;
+		time.start();
+		for (auto i = nIters / nSubscriptions / 10; i; --i)
+		{
+			CallMe::Event<FreeSignature, 1, DispatchOrder::Unspecified, Storage> event(nSubscriptions);
+			std::vector<decltype(event.subscribe(Delegate(_callbacks[0])))> subscriptions;
+			for (auto& c : _callbacks)
+				event.subscribe(Delegate(c)).move(subscriptions);
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+
+	//subscribe all callbacks at once, then unsubscribe them at once
+	DurationT BenchmarkSubscribeMany()
+	{
+		Stopwatch time;
+		time.start();
+		for (auto i = nIters / nSubscriptions / 10; i; --i)
+		{
+			CallMe::Event<FreeSignature, 1> event;
+			SubscriptionGroup group;
+			event.subscribeMany(_callbacks, group);
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+};
+
+/* reader threads raise an event with 100 subscriptions, while writer threads
+subscribe and unsubscribe a callback over and over again */
+struct ConcurrentEventBenchmark
+{
+	static constexpr auto nSubscriptions = 100;
+	static constexpr auto nRaises = nIters / nSubscriptions / 10;
+
+	//Event shared by threads under a reader-writer lock
+	struct LockedEvent
+	{
+		CallMe::Event<FreeSignature, nSubscriptions + 8> _event;
+		std::shared_mutex _mutex;
+
+		void raise(std::string& i2, volatile int* o1, volatile std::size_t* o2)
+		{
+			std::shared_lock lock(_mutex);
+			_event.raise(i2, o1, o2);
+		}
+
+		Subscription subscribe(DelegateT&& callback)
+		{
+			std::unique_lock lock(_mutex);
+			return _event.subscribe(std::move(callback));
+		}
+
+		void unsubscribe(Subscription& subscription)
+		{
+			std::unique_lock lock(_mutex);
+			Subscription ended = std::move(subscription);
+		}
+	};
+
+	struct FreeEvent
+	{
+		CallMe::ConcurrentEvent<FreeSignature> _event;
+
+		void raise(std::string& i2, volatile int* o1, volatile std::size_t* o2)
+		{
+			_event.raise(i2, o1, o2);
+		}
+
+		Subscription subscribe(DelegateT&& callback)
+		{
+			return _event.subscribe(std::move(callback));
+		}
+
+		static void unsubscribe(Subscription& subscription)
+		{
+			Subscription ended = std::move(subscription);
+		}
+	};
+
+	//the time it takes @nReaders to raise the event nRaises times in total
+	template<typename EventT>
+	static DurationT Benchmark(int nReaders, int nWriters)
+	{
+		EventT event;
+		std::vector<TargetObject> targets(nSubscriptions + nWriters);
+		std::vector<Subscription> subscriptions;
+		for (auto i = 0; i != nSubscriptions; ++i)
+			subscriptions.push_back(event.subscribe(fromMethod<&TargetObject::InlineMethod>(&targets[i])));
+
+		std::atomic<int> running{ nReaders };
+		std::atomic<bool> go{ false };
+
+		std::vector<std::thread> threads;
+		for (auto r = 0; r != nReaders; ++r)
+		{
+			threads.emplace_back([&]
+			{
+				std::string i2 = I2;
+				int o1;
+				std::size_t o2;
+				while (!go.load())
+					std::this_thread::yield();
+
+				for (auto i = nRaises / nReaders; i; --i)
+					event.raise(i2, &o1, &o2);
+				--running;
+			});
+		}
+		for (auto w = 0; w != nWriters; ++w)
+		{
+			threads.emplace_back([&, w]
+			{
+				auto callback = fromMethod<&TargetObject::InlineMethod>(&targets[nSubscriptions + w]);
+				while (!go.load())
+					std::this_thread::yield();
+
+				while (running.load() != 0)
+				{
+					Subscription s = event.subscribe(DelegateT(callback));
+					event.unsubscribe(s);
+				}
+			});
+		}
+
+		Stopwatch time;
+		time.start();
+		go = true;
+		for (std::thread& t : threads)
+			t.join();
+		time.stop();
+
+		return time.elapsed();
+	}
+};
+
+struct ShardedEventBenchmark
+{
+	static constexpr auto nSubscriptions = 100;
+	static constexpr auto nBatch = 10;
+	static constexpr auto nResubscriptions = nIters / 100;
+
+	struct LockedEvent
+	{
+		CallMe::Event<FreeSignature> _event;
+		std::mutex _mutex;
+
+		void subscribe(DelegateT&& callback, std::vector<Subscription>& dst)
+		{
+			std::lock_guard lock(_mutex);
+			_event.subscribe(std::move(callback), dst);
+		}
+
+		void unsubscribe(std::vector<Subscription>& subscriptions)
+		{
+			std::lock_guard lock(_mutex);
+			subscriptions.clear();
+		}
+	};
+
+	template<typename Event>
+	struct FreeEvent
+	{
+		Event _event;
+
+		void subscribe(DelegateT&& callback, std::vector<Subscription>& dst)
+		{
+			_event.subscribe(std::move(callback), dst);
+		}
+
+		static void unsubscribe(std::vector<Subscription>& subscriptions)
+		{
+			subscriptions.clear();
+		}
+	};
+
+	/* the time it takes @nThreads to subscribe and unsubscribe
+	nResubscriptions times in total, in batches of nBatch subscriptions */
+	template<typename EventT>
+	static DurationT Benchmark(int nThreads)
+	{
+		EventT event;
+		TargetObject target;
+		std::vector<Subscription> permanent;
+		for (auto i = 0; i != nSubscriptions; ++i)
+			event.subscribe(fromMethod<&TargetObject::InlineMethod>(&target), permanent);
+
+		std::atomic<bool> go{ false };
+		std::vector<std::thread> threads;
+		for (auto t = 0; t != nThreads; ++t)
+		{
+			threads.emplace_back([&]
+			{
+				std::vector<Subscription> subscriptions;
+				subscriptions.reserve(nBatch);
+				while (!go.load())
+					std::this_thread::yield();
+
+				for (auto i = nResubscriptions / nBatch / nThreads; i; --i)
+				{
+					for (auto j = 0; j != nBatch; ++j)
+						event.subscribe(fromMethod<&TargetObject::InlineMethod>(&target), subscriptions);
+					event.unsubscribe(subscriptions);
+				}
+			});
+		}
+
+		Stopwatch time;
+		time.start();
+		go = true;
+		for (std::thread& t : threads)
+			t.join();
+		time.stop();
+
+		event.unsubscribe(permanent);
+		return time.elapsed();
+	}
+};
+
+struct ParallelRaiseBenchmark
+{
+	static constexpr auto nInvocations = 200'000;
+
+	//a subscriber that does @_cost steps of work per notification
+	struct Tenant
+	{
+		int _cost = 0;
+		std::uint64_t _state = 0;
+
+		void recompute(const std::uint64_t& seed)
+		{
+			std::uint64_t x = _state;
+			for (auto i = _cost; i; --i)
+				x = x * 6364136223846793005ull + seed;
+			_state = x;
+		}
+	};
+
+	//the time to invoke nInvocations callbacks of @nSubscribers with the @cost each
+	static DurationT Benchmark(WorkStealingPool* pool, int nSubscribers, int cost)
+	{
+		std::vector<Tenant> tenants(nSubscribers, Tenant{ cost });
+		CallMe::Event<void(const std::uint64_t&)> event;
+		std::vector<Subscription> subscriptions;
+		for (Tenant& t : tenants)
+			event.subscribe(fromMethod<&Tenant::recompute>(&t), subscriptions);
+
+		Stopwatch time;
+		time.start();
+		for (auto i = nInvocations / nSubscribers; i; --i)
+		{
+			if (pool != nullptr)
+				event.raiseParallel(*pool, std::uint64_t(i));
+			else
+				event.raise(std::uint64_t(i));
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+};
+
+struct AsyncEventBenchmark
+{
+	static constexpr auto nRaises = 100'000;
+	static constexpr auto nBurst = 500;
+
+	using Tenant = ParallelRaiseBenchmark::Tenant;
+
+	struct Result
+	{
+		DurationT _producer{};
+		DurationT _delivered{};
+	};
+
+	/* @nRaises raises in bursts of @nBurst, the time spent in the raises
+	by the producer and the time until the callbacks return */
+	template<typename EventT>
+	static Result Benchmark(int nSubscribers, int cost)
+	{
+		std::vector<Tenant> tenants(nSubscribers, Tenant{ cost });
+		EventT event;
+		std::vector<Subscription> subscriptions;
+		for (Tenant& t : tenants)
+			event.subscribe(fromMethod<&Tenant::recompute>(&t), subscriptions);
+
+		Result result;
+		Stopwatch delivered;
+		delivered.start();
+		for (auto burst = nRaises / nBurst; burst; --burst)
+		{
+			Stopwatch producer;
+			producer.start();
+			for (std::uint64_t i = nBurst; i; --i)
+				event.raise(i);
+			producer.stop();
+			result._producer += producer.elapsed();
+
+			if constexpr (requires { event.waitIdle(); })
+				event.waitIdle();
+		}
+		delivered.stop();
+		result._delivered = delivered.elapsed();
+
+		return result;
+	}
+};
+
+struct DelegateMailboxBenchmark
+{
+	static constexpr auto nPosts = nIters / 10;
+	static constexpr auto nLatencyPosts = 10'000;
+	static constexpr auto nBatch = 64;
+
+	struct Sink
+	{
+		std::int64_t _sum = 0;
+		std::int64_t _count = 0;
+
+		void consume(std::int64_t value)
+		{
+			_sum += value;
+			++_count;
+		}
+
+		//@postedAt is the time of posting in ticks of HiresClockT
+		void consumeLatency(std::int64_t postedAt)
+		{
+			consume(HiresClockT::now().time_since_epoch().count() - postedAt);
+		}
+	};
+
+	struct LockedMailbox
+	{
+		std::mutex _mutex;
+		std::deque<std::function<void()>> _items;
+		std::deque<std::function<void()>> _drained;
+
+		template<auto Method>
+		void post(Sink* sink, std::int64_t value)
+		{
+			std::lock_guard lock(_mutex);
+			_items.emplace_back([sink, value] { (sink->*Method)(value); });
+		}
+
+		std::size_t drain()
+		{
+			{
+				std::lock_guard lock(_mutex);
+				_drained.swap(_items);
+			}
+			for (std::function<void()>& item : _drained)
+				item();
+
+			const std::size_t drained = _drained.size();
+			_drained.clear();
+			return drained;
+		}
+	};
+
+	struct FreeMailbox
+	{
+		CallMe::DelegateMailbox<void(std::int64_t)> _mailbox{ 4096 };
+
+		template<auto Method>
+		void post(Sink* sink, std::int64_t value)
+		{
+			_mailbox.post(fromMethod<Method>(sink), value);
+		}
+
+		std::size_t drain()
+		{
+			return _mailbox.drain(nBatch);
+		}
+	};
+
+	//the time it takes @nProducers to post nPosts items and the owner thread to invoke them
+	template<typename MailboxT>
+	static DurationT BenchmarkThroughput(int nProducers)
+	{
+		MailboxT mailbox;
+		Sink sink;
+		std::atomic<bool> go{ false };
+
+		std::vector<std::thread> producers;
+		for (auto p = 0; p != nProducers; ++p)
+		{
+			producers.emplace_back([&]
+			{
+				while (!go.load())
+					std::this_thread::yield();
+				for (std::int64_t i = nPosts / nProducers; i; --i)
+					mailbox.template post<&Sink::consume>(&sink, i);
+			});
+		}
+
+		Stopwatch time;
+		time.start();
+		go = true;
+		while (sink._count != nPosts / nProducers * nProducers)
+		{
+			if (mailbox.drain() == 0)
+				std::this_thread::yield();
+		}
+		time.stop();
+
+		for (std::thread& t : producers)
+			t.join();
+		return time.elapsed();
+	}
+
+	/* the average time from posting an item until it is invoked, the
+	producer posts the next item once the previous one is invoked */
+	template<typename MailboxT>
+	static DurationT BenchmarkLatency()
+	{
+		MailboxT mailbox;
+		Sink sink;
+		std::atomic<std::int64_t> invoked{ 0 };
+
+		std::thread owner([&]
+		{
+			while (invoked.load(std::memory_order_relaxed) != nLatencyPosts)
+			{
+				mailbox.drain();
+				invoked.store(sink._count, std::memory_order_release);
+			}
+		});
+
+		for (std::int64_t i = 0; i != nLatencyPosts; ++i)
+		{
+			mailbox.template post<&Sink::consumeLatency>(&sink, HiresClockT::now().time_since_epoch().count());
+			while (invoked.load(std::memory_order_acquire) == i)
+				std::this_thread::yield();
+		}
+		owner.join();
+
+		return DurationT(sink._sum / nLatencyPosts);
+	}
+};
+
+struct EventQueueBenchmark
+{
+	static constexpr auto nItems = 1'000;
+	static constexpr auto nFrames = nIters / nItems / 10;
+
+	//a subscriber of kind @Kind, so that every kind has its own code
+	template<int Kind>
+	struct System
+	{
+		std::uint64_t _state = Kind;
+
+		void update(const std::uint64_t& item)
+		{
+			_state = (_state ^ item) * (0x9E3779B97F4A7C15ull + Kind);
+		}
+	};
+
+	template<typename EventT, int...Kinds>
+	static void Subscribe(EventT& event, std::tuple<System<Kinds>...>& systems,
+						  std::vector<Subscription>& subscriptions)
+	{
+		(event.subscribe(fromMethod<&System<Kinds>::update>(&std::get<System<Kinds>>(systems)),
+						 subscriptions), ...);
+	}
+
+	/* the time of nFrames frames that raise nItems items each to 8 subscribers
+	of 8 kinds, immediately if @order is empty, otherwise queued and dispatched
+	at the end of the frame */
+	static DurationT Benchmark(std::optional<QueueDispatch> order)
+	{
+		CallMe::EventQueue<void(const std::uint64_t&)> queue;
+		std::tuple<System<0>, System<1>, System<2>, System<3>,
+				   System<4>, System<5>, System<6>, System<7>> systems;
+		std::vector<Subscription> subscriptions;
+		Subscribe(queue, systems, subscriptions);
+
+		Stopwatch time;
+		time.start();
+		for (auto frame = nFrames; frame; --frame)
+		{
+			for (std::uint64_t i = nItems; i; --i)
+			{
+				if (order)
+					queue.enqueue(i);
+				else
+					queue.raise(i);
+			}
+			if (order)
+				queue.dispatch(*order);
+		}
+		time.stop();
+
+		return time.elapsed();
+	}
+};
+
+struct CoalescingEventBenchmark
+{
+	static constexpr auto nRaises = 1'000'000;
+	static constexpr auto nSubscribers = 8;
+
+	//a subscriber that recomputes a view of the latest value
+	struct View
+	{
+		std::uint64_t _state = 0;
+		int _notified = 0;
+
+		void recompute(const std::uint64_t& value)
+		{
+			std::uint64_t x = _state;
+			for (auto i = 100; i; --i)
+				x = x * 6364136223846793005ull + value;
+			_state = x;
+			++_notified;
+		}
+	};
+
+	struct Result
+	{
+		DurationT _time;
+		int _delivered = 0;
+	};
+
+	/* the time to change a value nRaises times, @raisesPerFrame times per
+	frame, with notifications raised on every change or coalesced per frame */
+	template<typename EventT>
+	static Result Benchmark(int raisesPerFrame)
+	{
+		std::vector<View> views(nSubscribers);
+		EventT event;
+		std::vector<Subscription> subscriptions;
+		for (View& v : views)
+			event.subscribe(fromMethod<&View::recompute>(&v), subscriptions);
+
+		Stopwatch time;
+		time.start();
+		for (auto frame = nRaises / raisesPerFrame; frame; --frame)
+		{
+			for (std::uint64_t i = raisesPerFrame; i; --i)
+			{
+				if constexpr (requires { event.post(i); })
+					event.post(i);
+				else
+					event.raise(i);
+			}
+			if constexpr (requires { event.flush(); })
+				event.flush();
+		}
+		time.stop();
+
+		return { time.elapsed(), views.front()._notified };
+	}
+};
+
+struct TimerWheelBenchmark
+{
+	static constexpr auto nTimers = 1'000'000;
+
+	//the timeouts are 1 to 60 seconds, in ticks of 1 ms
+	static constexpr std::int64_t maxDelay = 60'000;
+
+	//a clock that moves only when the benchmark moves it
+	struct ManualClock
+	{
+		using rep = std::int64_t;
+		using period = std::milli;
+		using duration = std::chrono::milliseconds;
+		using time_point = std::chrono::time_point<ManualClock>;
+		static constexpr bool is_steady = true;
+
+		time_point* _now;
+
+		time_point now() const
+		{
+			return *_now;
+		}
+	};
+
+	struct Target
+	{
+		std::uint64_t _fired = 0;
+
+		void fire()
+		{
+			++_fired;
+		}
+	};
+
+	struct Result
+	{
+		DurationT _schedule;
+		DurationT _cancel;
+		DurationT _expire;
+	};
+
+	static std::vector<std::chrono::milliseconds> Delays()
+	{
+		std::mt19937_64 random(42);
+		std::vector<std::chrono::milliseconds> delays(nTimers);
+		for (auto& delay : delays)
+			delay = std::chrono::milliseconds(std::int64_t(random() % maxDelay) + 1);
+		return delays;
+	}
+
+	//schedule and cancel nTimers timers, then schedule and expire them
+	static Result BenchmarkWheel()
+	{
+		const auto delays = Delays();
+		ManualClock::time_point now{};
+		TimerWheel<ManualClock> wheel(std::chrono::milliseconds(1), ManualClock{ &now });
+		wheel.reserve(nTimers);
+		Target target;
+		std::vector<Timer> timers;
+		timers.reserve(nTimers);
+
+		Result result;
+		Stopwatch time;
+		time.start();
+		for (auto delay : delays)
+			timers.push_back(wheel.schedule(delay, fromMethod<&Target::fire>(&target)));
+		time.stop();
+		result._schedule = time.elapsed();
+
+		time.start();
+		timers.clear();
+		time.stop();
+		result._cancel = time.elapsed();
+
+		for (auto delay : delays)
+			timers.push_back(wheel.schedule(delay, fromMethod<&Target::fire>(&target)));
+
+		time.start();
+		for (std::int64_t tick = 0; tick != maxDelay; ++tick)
+		{
+			now += std::chrono::milliseconds(1);
+			wheel.advance();
+		}
+		time.stop();
+		result._expire = time.elapsed();
+
+		assert(target._fired == nTimers);
+		return result;
+	}
+
+	//the same with a map of std::function ordered by expiry time
+	static Result BenchmarkMultimap()
+	{
+		using MapT = std::multimap<std::int64_t, std::function<void()>>;
+		const auto delays = Delays();
+		std::int64_t now = 0;
+		MapT map;
+		Target target;
+		std::vector<MapT::iterator> timers;
+		timers.reserve(nTimers);
+
+		Result result;
+		Stopwatch time;
+		time.start();
+		for (auto delay : delays)
+			timers.push_back(map.emplace(now + delay.count(), [&target] { target.fire(); }));
+		time.stop();
+		result._schedule = time.elapsed();
+
+		time.start();
+		for (MapT::iterator timer : timers)
+			map.erase(timer);
+		timers.clear();
+		time.stop();
+		result._cancel = time.elapsed();
+
+		for (auto delay : delays)
+			timers.push_back(map.emplace(now + delay.count(), [&target] { target.fire(); }));
+
+		time.start();
+		for (std::int64_t tick = 0; tick != maxDelay; ++tick)
+		{
+			++now;
+			while (!map.empty() && map.begin()->first <= now)
+			{
+				std::function<void()> callback = std::move(map.begin()->second);
+				map.erase(map.begin());
+				callback();
+			}
+		}
+		time.stop();
+		result._expire = time.elapsed();
+
+		assert(target._fired == nTimers);
+		return result;
+	}
+};
+
+struct TaskPoolBenchmark
+{
+	static constexpr auto fibN = 25;
+	static constexpr auto nSorted = 1'000'000;
+	static constexpr auto sortCutoff = 1'024;
+	static constexpr auto nTasks = nIters / 10;
+
+	//a mutex-guarded queue of std::function, workers sleep on a condition variable
+	class LockedPool
+	{
+	public:
+		using Group = std::atomic<std::ptrdiff_t>;
+
+	private:
+		struct Item
+		{
+			std::function<void()> _task;
+			Group* _group = nullptr;
+		};
+
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::deque<Item> _items;
+		bool _stop = false;
+		std::vector<std::thread> _workers;
+
+		static void Run(Item& item)
+		{
+			item._task();
+			item._group->fetch_sub(1, std::memory_order_release);
+		}
+
+		void work()
+		{
+			for (;;)
+			{
+				Item item;
+				{
+					std::unique_lock lock(_mutex);
+					_wake.wait(lock, [this] { return _stop || !_items.empty(); });
+					if (_items.empty())
+						return;
+					item = std::move(_items.front());
+					_items.pop_front();
+				}
+				Run(item);
+			}
+		}
+
+	public:
+		explicit LockedPool(std::size_t nWorkers)
+		{
+			for (std::size_t w = 0; w != nWorkers; ++w)
+				_workers.emplace_back([this] { work(); });
+		}
+
+		~LockedPool()
+		{
+			{
+				std::lock_guard lock(_mutex);
+				_stop = true;
+			}
+			_wake.notify_all();
+			for (std::thread& w : _workers)
+				w.join();
+		}
+
+		template<typename Functor>
+		void spawn(Group& group, Functor&& functor)
+		{
+			group.fetch_add(1, std::memory_order_relaxed);
+			{
+				std::lock_guard lock(_mutex);
+				_items.push_back(Item{ std::forward<Functor>(functor), &group });
+			}
+			_wake.notify_one();
+		}
+
+		//run the most recently spawned tasks until @group is done
+		void wait(Group& group)
+		{
+			while (group.load(std::memory_order_acquire) != 0)
+			{
+				std::optional<Item> item;
+				{
+					std::lock_guard lock(_mutex);
+					if (!_items.empty())
+					{
+						item = std::move(_items.back());
+						_items.pop_back();
+					}
+				}
+				if (item)
+					Run(*item);
+				else
+					std::this_thread::yield();
+			}
+		}
+	};
+
+	template<typename Group, typename Pool>
+	static std::int64_t Fib(Pool& pool, int n)
+	{
+		if (n < 2)
+			return n;
+
+		std::int64_t a = 0;
+		Group children{};
+		pool.spawn(children, [&pool, &a, n] { a = Fib<Group>(pool, n - 1); });
+		const std::int64_t b = Fib<Group>(pool, n - 2);
+		pool.wait(children);
+		return a + b;
+	}
+
+	template<typename Group, typename Pool>
+	static void Quicksort(Pool& pool, int* first, int* last)
+	{
+		if (last - first <= sortCutoff)
+		{
+			std::sort(first, last);
+			return;
+		}
+
+		const int pivot = first[(last - first) / 2];
+		int* middle = std::partition(first, last, [pivot](int i) { return i < pivot; });
+		int* upper = std::partition(middle, last, [pivot](int i) { return i == pivot; });
+
+		Group children{};
+		pool.spawn(children, [&pool, first, middle] { Quicksort<Group>(pool, first, middle); });
+		Quicksort<Group>(pool, upper, last);
+		pool.wait(children);
+	}
+
+	static std::vector<int> Unsorted()
+	{
+		std::mt19937 random(42);
+		std::vector<int> v(nSorted);
+		for (int& i : v)
+			i = int(random());
+		return v;
+	}
+
+	static DurationT BenchmarkSerialFib()
+	{
+		struct Serial
+		{
+			static NOINLINE std::int64_t Fib(int n)
+			{
+				return n < 2 ? n : Fib(n - 1) + Fib(n - 2);
+			}
+		};
+
+		Stopwatch time;
+		time.start();
+		[[maybe_unused]] const std::int64_t fib = Serial::Fib(fibN);
+		time.stop();
+		assert(fib == 75'025);
+		return time.elapsed();
+	}
+
+	static DurationT BenchmarkSerialSort()
+	{
+		std::vector<int> v = Unsorted();
+		Stopwatch time;
+		time.start();
+		std::sort(v.begin(), v.end());
+		time.stop();
+		return time.elapsed();
+	}
+
+	template<typename Group, typename Pool>
+	static DurationT BenchmarkFib(Pool& pool)
+	{
+		Stopwatch time;
+		time.start();
+		[[maybe_unused]] const std::int64_t fib = Fib<Group>(pool, fibN);
+		time.stop();
+		assert(fib == 75'025);
+		return time.elapsed();
+	}
+
+	template<typename Group, typename Pool>
+	static DurationT BenchmarkSort(Pool& pool)
+	{
+		std::vector<int> v = Unsorted();
+		Stopwatch time;
+		time.start();
+		Quicksort<Group>(pool, v.data(), v.data() + v.size());
+		time.stop();
+		assert(std::is_sorted(v.begin(), v.end()));
+		return time.elapsed();
+	}
+
+	//nTasks tasks of a few instructions spawned by a task and waited for
+	template<typename Group, typename Pool>
+	static DurationT BenchmarkThroughput(Pool& pool)
+	{
+		std::vector<std::uint64_t> out(nTasks);
+		std::uint64_t* data = out.data();
+		const std::uint64_t factor = 3;
+
+		Stopwatch time;
+		time.start();
+		Group root{};
+		pool.spawn(root, [&pool, data, &factor]
+		{
+			Group tasks{};
+			for (std::uint64_t i = 0; i != nTasks; ++i)
+				pool.spawn(tasks, [data, i, &factor] { data[i] = i * factor; });
+			pool.wait(tasks);
+		});
+		pool.wait(root);
+		time.stop();
+
+		assert(out.back() == (nTasks - 1) * factor);
+		return time.elapsed();
+	}
+};
+
+struct ArgumentPassingBenchmark
+{
+	static NOINLINE void FunctionWithRefArgs(std::string&& a, std::string& b)
+	{
+		b = std::move(a);
+	}
+
+	template<typename Callable>
+	static DurationT Benchmark(Callable& callable)
+	{
+		Stopwatch time;
+		std::string a = "1234567890-=qwertyuiop[]asdfghjkl;'zxcvbnm,./";
+		std::string b;
+		time.start();
+
+		MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
+		for (auto i = nIters; i; --i)
+		{
+			callable(std::move(a), b);
+			callable(std::move(b), a);
+		}
+		time.stop();
+		MSVC_SUPPRESS_WARNING_POP
+
+		return time.elapsed();
+	}
+
+	static DurationT BenchmarkDirectCall()
+	{
+		return Benchmark(FunctionWithRefArgs);
+	}
+
+	static DurationT BenchmarkDelegate()
+	{
+		Delegate d{tag<FunctionWithRefArgs>()};
+		return Benchmark(d);
+	}
+
+	static DurationT BenchmarkEvent()
+	{
+		using signature = void(std::string&& a, std::string& b);
+		CallMe::Event<signature, 1> e;
+		auto sub = e.subscribe(fromFunction<FunctionWithRefArgs>());
+		return Benchmark(e);
+	}
+};
+
+int main()
+{
+	int i1 = 1;
+
+	//when compiled with optimizations (Release mode),
+	//MSVC++ inlines this lambda
+	auto λInline = [&i1](std::string& i2,
+						volatile int* o1,
+						volatile std::size_t* o2) 
+	{
+		*o1 = i1;
+		*o2 = i2.size();
+	};
+	auto λNoninlined = [&i1](std::string& i2,
+							volatile int* o1,
+							volatile std::size_t* o2) NOINLINE
+	{
+		*o1 = i1;
+		*o2 = i2.size();
+	};
+	auto λCapturelessInline = [](std::string& i2,
+								  volatile int* o1,
+								  volatile std::size_t* o2) 
+	{
+		*o1 = I1;
+		*o2 = i2.size();
+	};
+	auto λCapturelessNoninlined = [](std::string& i2,
+									 volatile int* o1,
+									 volatile std::size_t* o2) NOINLINE
+	{
+		*o1 = I1;
+		*o2 = i2.size();
+	};
+
+	pretty::Table tableInline;
+	pretty::Table tableNoninlined;
+	pretty::Table tableMoved;
+	pretty::Table tableInlineHeap;
+	pretty::Table tableDelegateAsParameter;
+	pretty::Table tableEvent;
+	pretty::Table tableEventSize;
+	pretty::Table tableRelocation;
+	pretty::Table tableSubscriptionVector;
+	pretty::Table tableEventLifetime;
+	pretty::Table tableDispatchOrder;
+	pretty::Table tableBulkSubscription;
+	pretty::Table tableEventStorage;
+	pretty::Table tableArgumentPassing;
+	pretty::Table tableOwningStorage;
+	pretty::Table tableShared;
+	pretty::Table tableConcurrentEvent;
+	pretty::Table tableShardedEvent;
+	pretty::Table tableParallelRaise;
+	pretty::Table tableAsyncEvent;
+	pretty::Table tableMailbox;
+	pretty::Table tableEventQueue;
+	pretty::Table tableCoalescing;
+	pretty::Table tableTimerWheel;
+	pretty::Table tableTaskPool;
+	std::vector tables = 
+	{
+		&tableInline,
+		&tableNoninlined,
+		&tableInlineHeap,
+		&tableMoved,
+		&tableDelegateAsParameter
+	};
+	for(auto t : tables)
+		t->addRow("invocable", "λ with capture", "captureless λ", "method", "function");
+
+	Benchmarks<std::tuple<
+		DirectCallBenchmark,
+		DelegateBenchmark,
+		OwningDelegateBenchmark/*,
+		BitwizeshiftDelegateBenchmark*/>> benchmarks;
+
+	pretty::RowN row{1};//skip header row
+	pretty::ColN col{};
+
+	tableInline.title("Stack-allocated delegates, inlinable target");
+	tableNoninlined.title("Stack-allocated delegates, noninlinable target");
+	
+	{ //column: delegate names
+		{
+			ResultHandler h{ tableInline, row, col };
+			benchmarks.GatherNames(h);
+		}
+		{
+			ResultHandler h{ tableNoninlined, row, col };
+			benchmarks.GatherNames(h);
+		}
+	}
+
+	{ //column: lambda with capture
+		++col;
+		{
+			ResultHandler h{ tableInline, row, col };
+			benchmarks.BenchmarkFunctor(λInline, h);
+		}
+		{
+			ResultHandler h{ tableNoninlined, row, col };
+			benchmarks.BenchmarkFunctor(λNoninlined, h);
+		}
+	}
+
+	{ //column: captureless lambda
+		++col;
+		{
+			ResultHandler h{ tableInline, row, col };
+			benchmarks.BenchmarkFunctor(λCapturelessInline, h);
+		}
+		{
+			ResultHandler h{ tableNoninlined, row, col };
+			benchmarks.BenchmarkFunctor(λCapturelessNoninlined, h);
+		}
+	}
+
+	{ //column: method
+		++col;
+		TargetObject targetObj;
+		{
+			ResultHandler h{ tableInline, row, col };
+			benchmarks.BenchmarkMethod<&TargetObject::InlineMethod>(targetObj, h);
+		}
+		{
+			ResultHandler h{ tableNoninlined, row, col };
+			benchmarks.BenchmarkMethod<&TargetObject::NonInlinedMethod>(targetObj, h);
+		}
+	}
 
 	{ //column: function
 		++col;
@@ -1100,6 +2678,320 @@ int main()
 		}
 	}
 
+	{
+		tableOwningStorage.title("OwningDelegate inline vs heap, λ with capture, inlinable target");
+		tables.push_back(&tableOwningStorage);
+
+		tableOwningStorage.addRow("target storage", "construct+invoke+destroy", "move=", "invoke");
+
+		OwningDelegateStorageBenchmark::AddRow(tableOwningStorage, "heap, new auto", [&]
+		{
+			return fromFunctorOwned(new auto(λInline));
+		});
+		OwningDelegateStorageBenchmark::AddRow(tableOwningStorage, "heap, make()", [&]
+		{
+			return OwningDelegateT::make(λInline);
+		});
+		OwningDelegateStorageBenchmark::AddRow(tableOwningStorage, "inline, make()", [&]
+		{
+			return InlineOwningDelegateT::make(λInline);
+		});
+	}
+
+	{
+		tableShared.title("Shared ownership, λ with capture, inlinable target");
+		tables.push_back(&tableShared);
+
+		tableShared.addRow("shared callback", "construct+invoke+destroy", "copy+invoke+destroy", "invoke");
+
+		SharedDelegateBenchmark::AddRow(tableShared, "SharedDelegate, atomic", [&]
+		{
+			return SharedDelegateT::make(λInline);
+		});
+		SharedDelegateBenchmark::AddRow(tableShared, "SharedDelegate, non-atomic", [&]
+		{
+			return NonAtomicSharedDelegateT::make(λInline);
+		});
+		SharedDelegateBenchmark::AddRow(tableShared, "shared_ptr<std::function>", [&]
+		{
+			return SharedStdFunction{ std::make_shared<std::function<FreeSignature>>(λInline) };
+		});
+	}
+
+	{
+		tableEventSize.title("Event by number of subscriptions, 10M invocations in total, inlinable target");
+		tables.push_back(&tableEventSize);
+
+		tableEventSize.addRow("subscriptions", "direct call", "{delegate, Subscription*} records", "raised event");
+
+		for (std::ptrdiff_t n : { 10, 100, 1'000, 10'000, 100'000, 1'000'000 })
+		{
+			tableEventSize.addRow(std::to_string(n),
+								  toString(EventBenchmark::BenchmarkDirectCallSweep(n)),
+								  toString(EventBenchmark::BenchmarkArrayOfRecordsSweep(n)),
+								  toString(EventBenchmark::BenchmarkEventRaiseSweep(n)));
+		}
+	}
+
+	{
+		tableRelocation.title("Growth without reserve, 1M callbacks in total");
+		tables.push_back(&tableRelocation);
+
+		tableRelocation.addRow("callbacks", "element-wise move", "memcpy relocation", "Event::subscribe");
+
+		using Relocation = RelocationBenchmark;
+		for (std::ptrdiff_t n : { 1'000, 10'000, 100'000 })
+		{
+			auto moved = Relocation::BenchmarkGrowth<Relocation::MovedDelegate>(n);
+			auto relocated = Relocation::BenchmarkGrowth<Delegate<FreeSignature>>(n);
+			auto subscribed = Relocation::BenchmarkEventGrowth(n);
+
+			tableRelocation.addRow(std::to_string(n),
+								   toString(moved), toString(relocated), toString(subscribed));
+		}
+	}
+
+	{
+		tableSubscriptionVector.title("Relocation of 1000 subscriptions, 2K times");
+		tables.push_back(&tableSubscriptionVector);
+
+		tableSubscriptionVector.addRow("subscribed to", "std::vector", "gch::small_vector", "SubscriptionVector");
+
+		SubscriptionVectorBenchmark b;
+		b.AddRow(tableSubscriptionVector, "1 event", 1, false);
+		b.AddRow(tableSubscriptionVector, "4 events, in blocks", 4, false);
+		b.AddRow(tableSubscriptionVector, "4 events, interleaved", 4, true);
+	}
+
+	{
+		tableConcurrentEvent.title("Event with 100 subscriptions raised 10K times by reader threads, while writer threads resubscribe");
+		tables.push_back(&tableConcurrentEvent);
+
+		tableConcurrentEvent.addRow("readers", "writers", "Event + std::shared_mutex", "ConcurrentEvent");
+
+		using Concurrent = ConcurrentEventBenchmark;
+		for (int nWriters : { 0, 1, 2 })
+		{
+			for (int nReaders : { 1, 2, 4, 8 })
+			{
+				tableConcurrentEvent.addRow(std::to_string(nReaders), std::to_string(nWriters),
+					toString(Concurrent::Benchmark<Concurrent::LockedEvent>(nReaders, nWriters)),
+					toString(Concurrent::Benchmark<Concurrent::FreeEvent>(nReaders, nWriters)));
+			}
+		}
+	}
+
+	{
+		tableShardedEvent.title("100K subscriptions and unsubscriptions in batches of 10 by threads, 100 other subscriptions");
+		tables.push_back(&tableShardedEvent);
+
+		tableShardedEvent.addRow("threads", "Event + std::mutex", "ConcurrentEvent", "ShardedEvent");
+
+		using Sharded = ShardedEventBenchmark;
+		for (int nThreads : { 1, 2, 4, 8, 16, 32, 64 })
+		{
+			tableShardedEvent.addRow(std::to_string(nThreads),
+				toString(Sharded::Benchmark<Sharded::LockedEvent>(nThreads)),
+				toString(Sharded::Benchmark<Sharded::FreeEvent<CallMe::ConcurrentEvent<FreeSignature>>>(nThreads)),
+				toString(Sharded::Benchmark<Sharded::FreeEvent<CallMe::ShardedEvent<FreeSignature>>>(nThreads)));
+		}
+	}
+
+	{
+		WorkStealingPool pool;
+		tableParallelRaise.title("Event raised until 200K callbacks are invoked, " +
+								 std::to_string(pool.workers() + 1) + " threads, grain of 16 callbacks");
+		tables.push_back(&tableParallelRaise);
+
+		tableParallelRaise.addRow("subscribers", "steps per callback", "raise", "raiseParallel", "speedup");
+
+		using Parallel = ParallelRaiseBenchmark;
+		for (int nSubscribers : { 16, 64, 1'000, 10'000 })
+		{
+			for (int cost : { 10, 100, 1'000 })
+			{
+				const DurationT serial = Parallel::Benchmark(nullptr, nSubscribers, cost);
+				const DurationT parallel = Parallel::Benchmark(&pool, nSubscribers, cost);
+				tableParallelRaise.addRow(std::to_string(nSubscribers), std::to_string(cost),
+										  toString(serial), toString(parallel),
+										  std::to_string(double(serial.count()) / double(parallel.count())).substr(0, 4) + "x");
+			}
+		}
+	}
+
+	{
+		tableAsyncEvent.title("100K raises in bursts of 500 by a producer thread");
+		tables.push_back(&tableAsyncEvent);
+
+		tableAsyncEvent.addRow("subscribers", "steps per callback", "Event::raise",
+							   "AsyncEvent, producer", "AsyncEvent, until delivered");
+
+		using Async = AsyncEventBenchmark;
+		for (auto [nSubscribers, cost] : { std::pair{ 1, 10 }, std::pair{ 10, 10 }, std::pair{ 10, 100 } })
+		{
+			const auto sync = Async::Benchmark<CallMe::Event<void(const std::uint64_t&)>>(nSubscribers, cost);
+			const auto async = Async::Benchmark<CallMe::AsyncEvent<void(const std::uint64_t&)>>(nSubscribers, cost);
+			tableAsyncEvent.addRow(std::to_string(nSubscribers), std::to_string(cost),
+								   toString(sync._delivered), toString(async._producer),
+								   toString(async._delivered));
+		}
+	}
+
+	{
+		tableMailbox.title("1M invocations posted by producer threads and drained by the owner thread");
+		tables.push_back(&tableMailbox);
+
+		tableMailbox.addRow("producers", "mutex + std::deque<std::function>", "DelegateMailbox");
+
+		using Mailbox = DelegateMailboxBenchmark;
+		for (int nProducers : { 1, 2, 4 })
+		{
+			tableMailbox.addRow(std::to_string(nProducers),
+								toString(Mailbox::BenchmarkThroughput<Mailbox::LockedMailbox>(nProducers)),
+								toString(Mailbox::BenchmarkThroughput<Mailbox::FreeMailbox>(nProducers)));
+		}
+
+		const auto latency = [](DurationT t)
+		{
+			return std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(t).count()) + " ns";
+		};
+		tableMailbox.addRow("latency, 1 item in flight",
+							latency(Mailbox::BenchmarkLatency<Mailbox::LockedMailbox>()),
+							latency(Mailbox::BenchmarkLatency<Mailbox::FreeMailbox>()));
+	}
+
+	{
+		tableEventQueue.title("1K raises per frame to 8 subscribers of 8 kinds, 1K frames");
+		tables.push_back(&tableEventQueue);
+
+		tableEventQueue.addRow("Event::raise", "EventQueue, item-major", "EventQueue, subscriber-major");
+		tableEventQueue.addRow(toString(EventQueueBenchmark::Benchmark(std::nullopt)),
+							   toString(EventQueueBenchmark::Benchmark(QueueDispatch::ItemMajor)),
+							   toString(EventQueueBenchmark::Benchmark(QueueDispatch::SubscriberMajor)));
+	}
+
+	{
+		tableCoalescing.title("1M changes of a value with 8 subscribers");
+		tables.push_back(&tableCoalescing);
+
+		tableCoalescing.addRow("changes per frame", "Event::raise", "notifications",
+							   "CoalescingEvent::flush", "notifications");
+
+		using Coalescing = CoalescingEventBenchmark;
+		for (int raisesPerFrame : { 1, 10, 100, 1'000 })
+		{
+			const auto raised = Coalescing::Benchmark<CallMe::Event<void(const std::uint64_t&)>>(raisesPerFrame);
+			const auto coalesced = Coalescing::Benchmark<CallMe::CoalescingEvent<void(const std::uint64_t&)>>(raisesPerFrame);
+			tableCoalescing.addRow(std::to_string(raisesPerFrame),
+								   toString(raised._time), std::to_string(raised._delivered),
+								   toString(coalesced._time), std::to_string(coalesced._delivered));
+		}
+	}
+
+	{
+		tableTimerWheel.title("1M timers of 1 to 60 s, 1 ms ticks");
+		tables.push_back(&tableTimerWheel);
+
+		tableTimerWheel.addRow("", "schedule", "cancel", "expire");
+		const auto wheel = TimerWheelBenchmark::BenchmarkWheel();
+		tableTimerWheel.addRow("TimerWheel", toString(wheel._schedule),
+							   toString(wheel._cancel), toString(wheel._expire));
+		const auto map = TimerWheelBenchmark::BenchmarkMultimap();
+		tableTimerWheel.addRow("std::multimap + std::function", toString(map._schedule),
+							   toString(map._cancel), toString(map._expire));
+	}
+
+	{
+		const std::size_t nWorkers = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+		tableTaskPool.title("Fork-join and fine-grained tasks, " + std::to_string(nWorkers + 1) + " threads");
+		tables.push_back(&tableTaskPool);
+
+		tableTaskPool.addRow("", "serial", "mutex + condition_variable + std::function", "TaskPool");
+
+		using Tasks = TaskPoolBenchmark;
+		using LockedGroup = Tasks::LockedPool::Group;
+		Tasks::LockedPool locked(nWorkers);
+		TaskPool<> pool(nWorkers);
+		tableTaskPool.addRow("fib(" + std::to_string(Tasks::fibN) + "), a task per call",
+							 toString(Tasks::BenchmarkSerialFib()),
+							 toString(Tasks::BenchmarkFib<LockedGroup>(locked)),
+							 toString(Tasks::BenchmarkFib<TaskGroup>(pool)));
+		tableTaskPool.addRow("quicksort of 1M ints, std::sort below 1K",
+							 toString(Tasks::BenchmarkSerialSort()),
+							 toString(Tasks::BenchmarkSort<LockedGroup>(locked)),
+							 toString(Tasks::BenchmarkSort<TaskGroup>(pool)));
+		tableTaskPool.addRow("1M tasks of a store", "",
+							 toString(Tasks::BenchmarkThroughput<LockedGroup>(locked)),
+							 toString(Tasks::BenchmarkThroughput<TaskGroup>(pool)));
+	}
+
+	{
+		tableEventLifetime.title("Event move and destruction by number of subscriptions");
+		tables.push_back(&tableEventLifetime);
+
+		tableEventLifetime.addRow("subscriptions",
+								  "100 moves, BackPointers", "100 moves, ControlBlock",
+								  "10 destructions, BackPointers", "10 destructions, ControlBlock");
+
+		using Lifetime = EventLifetimeBenchmark;
+		for (std::ptrdiff_t n : { 100, 1'000, 10'000, 100'000 })
+		{
+			tableEventLifetime.addRow(std::to_string(n),
+				toString(Lifetime::BenchmarkMove<EventStorage::BackPointers>(n)),
+				toString(Lifetime::BenchmarkMove<EventStorage::ControlBlock>(n)),
+				toString(Lifetime::BenchmarkDestruction<EventStorage::BackPointers>(n)),
+				toString(Lifetime::BenchmarkDestruction<EventStorage::ControlBlock>(n)));
+		}
+	}
+
+	{
+		tableDispatchOrder.title("Event with 1000 subscriptions to 4 kinds of targets in random order");
+		tables.push_back(&tableDispatchOrder);
+
+		EventDispatchOrderBenchmark b;
+		tableDispatchOrder.addRow("dispatch order", "10M invocations");
+		tableDispatchOrder.addRow("unspecified",
+			toString(b.BenchmarkEventRaise<DispatchOrder::Unspecified>(false)));
+		tableDispatchOrder.addRow("unspecified + optimizeOrder()",
+			toString(b.BenchmarkEventRaise<DispatchOrder::Unspecified>(true)));
+		tableDispatchOrder.addRow("DispatchOrder::Grouped",
+			toString(b.BenchmarkEventRaise<DispatchOrder::Grouped>(false)));
+		tableDispatchOrder.addRow("DispatchOrder::Fifo",
+			toString(b.BenchmarkEventRaise<DispatchOrder::Fifo>(false)));
+		tableDispatchOrder.addRow("DispatchOrder::Priority",
+			toString(b.BenchmarkEventRaise<DispatchOrder::Priority>(false)));
+
+		tableDispatchOrder.addRow("resubscription", "1M resubscriptions");
+		tableDispatchOrder.addRow("unspecified",
+			toString(b.BenchmarkChurn<DispatchOrder::Unspecified>()));
+		tableDispatchOrder.addRow("DispatchOrder::Fifo",
+			toString(b.BenchmarkChurn<DispatchOrder::Fifo>()));
+
+		tableBulkSubscription.title("Subscribing 1000 callbacks to a new event and unsubscribing them");
+		tables.push_back(&tableBulkSubscription);
+
+		tableBulkSubscription.addRow("", "1K times");
+		tableBulkSubscription.addRow("one by one",
+			toString(b.BenchmarkSubscribeEach()));
+		tableBulkSubscription.addRow("subscribeMany + SubscriptionGroup",
+			toString(b.BenchmarkSubscribeMany()));
+
+		tableEventStorage.title("Event with 1000 subscriptions by EventStorage");
+		tables.push_back(&tableEventStorage);
+
+		tableEventStorage.addRow("", "growing vector of subscriptions, 1K times",
+								 "resubscription, 1M times");
+		tableEventStorage.addRow("EventStorage::BackPointers",
+			toString(b.BenchmarkVectorGrowth<EventStorage::BackPointers>()),
+			toString(b.BenchmarkChurn<DispatchOrder::Unspecified, EventStorage::BackPointers>()));
+		tableEventStorage.addRow("EventStorage::SlotMap",
+			toString(b.BenchmarkVectorGrowth<EventStorage::SlotMap>()),
+			toString(b.BenchmarkChurn<DispatchOrder::Unspecified, EventStorage::SlotMap>()));
+		tableEventStorage.addRow("EventStorage::ControlBlock",
+			toString(b.BenchmarkVectorGrowth<EventStorage::ControlBlock>()),
+			toString(b.BenchmarkChurn<DispatchOrder::Unspecified, EventStorage::ControlBlock>()));
+	}
+
 	{
 		tableArgumentPassing.title("Argument passing/reference forwarding (noninlinable target)");
 		tables.push_back(&tableArgumentPassing);
@@ -1134,6 +3026,31 @@ int main()
 		tableEvent.addRow("raised event, inlinable", 
 						  toString(EventBenchmark::BenchmarkEventRaise<&TargetObject::InlineMethod>())
 		);
+		tableEvent.addRow("raised event, resubscribing during dispatch, inlinable", 
+						  toString(EventBenchmark::BenchmarkReentrantEventRaise<&TargetObject::InlineMethod>())
+		);
+		tableEvent.addRow("raised event, batchable, inlinable", 
+						  toString(EventBenchmark::BenchmarkBatchedEventRaise<&TargetObject::InlineMethod>())
+		);
+		tableEvent.addRow("raised event, batchable, noninlinable", 
+						  toString(EventBenchmark::BenchmarkBatchedEventRaise<&TargetObject::NonInlinedMethod>())
+		);
+		tableEvent.addRow("raised MethodEvent, inlinable", 
+						  toString(EventBenchmark::BenchmarkMethodEventRaise<&TargetObject::InlineMethod>())
+		);
+		tableEvent.addRow("raised MethodEvent, noninlinable", 
+						  toString(EventBenchmark::BenchmarkMethodEventRaise<&TargetObject::NonInlinedMethod>())
+		);
+		tableEvent.addRow("raised StaticEvent, inlinable", 
+						  toString(EventBenchmark::BenchmarkStaticEventRaise<&TargetObject::InlineMethod>(
+							  std::make_index_sequence<nEventSubscriptions>()))
+		);
+		tableEvent.addRow("collected results, combiners::Sum, noninlinable", 
+						  toString(EventBenchmark::BenchmarkCollectSum())
+		);
+		tableEvent.addRow("collected results, vector filled by callbacks, noninlinable", 
+						  toString(EventBenchmark::BenchmarkCollectIntoVector())
+		);
 	}
 
 	pretty::Printer print;
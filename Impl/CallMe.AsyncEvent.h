@@ -0,0 +1,349 @@
+/*
+* MIT License
+*
+* Copyright (c) 2023 Dmitry Kim <https://github.com/bitsbakery/callme>
+*
+* Permission is hereby  granted, free of charge, to any  person obtaining a copy
+* of this software and associated  documentation files (the "Software"), to deal
+* in the Software  without restriction, including without  limitation the rights
+* to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+* copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+* IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+* FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+* AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+* LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "CallMe.ConcurrentEvent.h"
+
+namespace CallMe
+{
+	namespace internal
+	{
+		template<typename Signature>
+		class AsyncEvent;
+
+		template<typename R, typename...ClassArgs>
+		class AsyncEvent<R(ClassArgs...)>
+		{
+			static_assert((std::convertible_to<const std::decay_t<ClassArgs>&, ClassArgs> && ...),
+						  "AsyncEvent passes copies of the arguments to all callbacks, "
+						  "it requires a signature without non-const reference parameters");
+
+			using Signature = R(ClassArgs...);
+
+			using DelegateT = Delegate<Signature>;
+
+			//the copies of the arguments of a raise
+			using MessageT = std::tuple<std::decay_t<ClassArgs>...>;
+
+			/* A slot of the bounded MPMC ring, see Vyukov's bounded queue.
+			@_sequence == the position of the slot: free for the producer of
+			that position, == the position + 1: holds the message of that
+			position. A cache line per slot, so that producers and workers
+			don't share lines */
+			struct alignas(64) Slot
+			{
+				std::atomic<std::size_t> _sequence;
+				alignas(MessageT) std::byte _message[sizeof(MessageT)];
+
+				MessageT& message()
+				{
+					return *std::launder(reinterpret_cast<MessageT*>(_message));
+				}
+			};
+
+			//the subscriptions, shared by the producers and the workers
+			ConcurrentEvent<Signature> _event;
+
+			std::unique_ptr<Slot[]> _slots;
+			std::size_t _mask;
+
+			alignas(64) std::atomic<std::size_t> _enqueuePos{ 0 };
+			alignas(64) std::atomic<std::size_t> _dequeuePos{ 0 };
+
+			//the messages dispatched by the workers
+			alignas(64) std::atomic<std::size_t> _dispatched{ 0 };
+
+			//the workers that wait for messages, and their wake-up signal
+			alignas(64) std::atomic<std::ptrdiff_t> _sleeping{ 0 };
+			std::atomic<std::uint32_t> _signal{ 0 };
+
+			/* true from a wake-up until the woken worker runs, so that
+			a burst of messages wakes a worker once */
+			std::atomic<bool> _waking{ false };
+
+			std::atomic<bool> _stop{ false };
+
+			std::vector<std::thread> _workers;
+
+			//dispatches one message if there is one
+			bool dispatchOne()
+			{
+				std::size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+				Slot viewptr slot;
+				for (;;)
+				{
+					slot = &_slots[pos & _mask];
+					//seq_cst, a woken worker clears _waking before the load
+					const std::size_t sequence = slot->_sequence.load(std::memory_order_seq_cst);
+					const std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos + 1);
+					if (diff == 0)
+					{
+						if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+							break;
+					}
+					else if (diff < 0)
+						return false;
+					else
+						pos = _dequeuePos.load(std::memory_order_relaxed);
+				}
+
+				MessageT& message = slot->message();
+				std::apply([this](std::decay_t<ClassArgs>&...args) { _event.raise(args...); }, message);
+				message.~MessageT();
+
+				slot->_sequence.store(pos + _mask + 1, std::memory_order_release);
+				_dispatched.fetch_add(1, std::memory_order_release);
+				return true;
+			}
+
+			void work()
+			{
+				for (;;)
+				{
+					if (dispatchOne())
+						continue;
+
+					const std::uint32_t signal = _signal.load(std::memory_order_seq_cst);
+					_sleeping.fetch_add(1, std::memory_order_seq_cst);
+
+					//producers that post from now on wake a worker
+					_waking.store(false, std::memory_order_seq_cst);
+
+					//a message posted before would be missed otherwise
+					const bool empty = !hasMessages();
+					if (empty && !_stop.load(std::memory_order_seq_cst))
+					{
+						_signal.wait(signal, std::memory_order_seq_cst);
+
+						/* let the next burst wake another worker, the messages posted
+						while the flag was set are dispatched by this one */
+						_waking.store(false, std::memory_order_seq_cst);
+					}
+
+					_sleeping.fetch_sub(1, std::memory_order_relaxed);
+					if (empty && _stop.load(std::memory_order_acquire) && !hasMessages())
+						return;
+				}
+			}
+
+			bool hasMessages() const
+			{
+				const std::size_t pos = _dequeuePos.load(std::memory_order_seq_cst);
+				return _slots[pos & _mask]._sequence.load(std::memory_order_seq_cst) == pos + 1;
+			}
+
+			/* the loads are seq_cst, like the store of the posted message,
+			so that either a worker that goes to sleep sees the message, or
+			the producer sees the worker */
+			void wakeWorkers(bool all)
+			{
+				if (all || (_sleeping.load(std::memory_order_seq_cst) != 0 &&
+							!_waking.load(std::memory_order_seq_cst) &&
+							!_waking.exchange(true, std::memory_order_relaxed)))
+				{
+					_signal.fetch_add(1, std::memory_order_seq_cst);
+					if (all)
+						_signal.notify_all();
+					else
+						_signal.notify_one();
+				}
+			}
+
+		public:
+			explicit AsyncEvent(std::size_t capacity = 1024, std::size_t nWorkers = 1) :
+				_slots(new Slot[std::bit_ceil(std::max<std::size_t>(capacity, 2))]),
+				_mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1)
+			{
+				for (std::size_t i = 0; i <= _mask; ++i)
+					_slots[i]._sequence.store(i, std::memory_order_relaxed);
+
+				_workers.reserve(nWorkers);
+				for (std::size_t w = 0; w != std::max<std::size_t>(nWorkers, 1); ++w)
+					_workers.emplace_back([this] { work(); });
+			}
+
+			AsyncEvent(const AsyncEvent&) = delete;
+			AsyncEvent& operator=(const AsyncEvent&) = delete;
+
+			/* The messages posted before are dispatched, then the workers
+			are joined and the Subscriptions are detached. The Event must
+			not be raised on other threads during the destruction. */
+			~AsyncEvent()
+			{
+				_stop.store(true, std::memory_order_seq_cst);
+				wakeWorkers(true);
+				for (std::thread& w : _workers)
+					w.join();
+			}
+
+			/* Post a raise to the workers without waiting for the callbacks:
+			copy @args into a free slot of the ring. Returns false if all
+			slots are taken by messages that are not dispatched yet.
+
+			Doesn't allocate, unless copying an argument does.
+
+			NDEBUG complexity: O(1) */
+			bool tryRaise(const std::decay_t<ClassArgs>&...args)
+			{
+				std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+				Slot viewptr slot;
+				for (;;)
+				{
+					slot = &_slots[pos & _mask];
+					const std::size_t sequence = slot->_sequence.load(std::memory_order_acquire);
+					const std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos);
+					if (diff == 0)
+					{
+						if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+							break;
+					}
+					else if (diff < 0)
+						return false;
+					else
+						pos = _enqueuePos.load(std::memory_order_relaxed);
+				}
+
+				new (slot->_message) MessageT(args...);
+				slot->_sequence.store(pos + 1, std::memory_order_seq_cst);
+
+				wakeWorkers(false);
+				return true;
+			}
+
+			/* Post a raise like .tryRaise(...) does, waiting for a free slot
+			while the ring is full.
+
+			A worker invokes the callbacks subscribed at the moment of
+			dispatch, see ConcurrentEvent::raise(...). With several workers,
+			messages are dispatched concurrently and in no particular order.
+			A callback that is unsubscribed while messages are in flight is
+			not invoked once its ~Subscription() returns. */
+			void raise(const std::decay_t<ClassArgs>&...args)
+			{
+				while (!tryRaise(args...))
+					std::this_thread::yield();
+			}
+
+			// the same as .raise(...)
+			void operator()(const std::decay_t<ClassArgs>&...args)
+			{
+				raise(args...);
+			}
+
+			/* waits until the workers dispatch the messages posted before
+			the call */
+			void waitIdle() const
+			{
+				const std::size_t posted = _enqueuePos.load(std::memory_order_acquire);
+				while (_dispatched.load(std::memory_order_acquire) < posted)
+					std::this_thread::yield();
+			}
+
+			/* Subscribe @callback to the Event, may be called on any thread,
+			see ConcurrentEvent::subscribe(...) */
+			[[nodiscard]] Subscription subscribe(DelegateT&& callback)
+			{
+				return _event.subscribe(std::move(callback));
+			}
+
+			template<typename MismatchingSignature>
+				requires (not std::same_as<MismatchingSignature, Signature>)
+			DELETE_FUNCTION(Subscription subscribe(Delegate<MismatchingSignature>&&),
+							MsgEventCallbackMismatch)
+
+			/* Subscribe @callback to the Event, see the other overload.
+			The function saves a Subscription object in @dst. */
+			template<typename VectorOfSubscriptions = std::vector<Subscription>>
+			void subscribe(DelegateT&& callback, VectorOfSubscriptions& dst)
+			{
+				_event.subscribe(std::move(callback), dst);
+			}
+
+			template<typename MismatchingSignature, typename VectorOfSubscriptions>
+				requires (not std::same_as<MismatchingSignature, Signature>)
+			DELETE_FUNCTION(void subscribe(Delegate<MismatchingSignature>&&,
+										   VectorOfSubscriptions&),
+							MsgEventCallbackMismatch)
+
+			//the number of subscriptions at the moment of the call
+			[[nodiscard]] std::size_t count() const
+			{
+				return _event.count();
+			}
+
+			[[nodiscard]] bool empty() const
+			{
+				return _event.empty();
+			}
+
+			//the number of messages that fit into the ring
+			[[nodiscard]] std::size_t capacity() const
+			{
+				return _mask + 1;
+			}
+		};
+	}
+
+	/* Event whose .raise(...) posts the arguments to worker threads instead
+	of invoking the callbacks, for producers on latency-critical threads.
+
+	The arguments are copied into a slot of a bounded multi-producer/
+	multi-consumer ring that is allocated with the event, so posting never
+	allocates unless copying the arguments does. The workers, 1 by default,
+	take the messages from the ring and raise them to the subscriptions,
+	which are those of a ConcurrentEvent: they may be subscribed and ended
+	on any thread, and when ~Subscription() returns, its callback is not
+	running and won't be invoked by the messages still in flight. A
+	Subscription ended in a callback doesn't wait, so the callbacks on
+	several workers may end subscriptions at a time; the ended callback
+	may run on other workers until the message that ended it is
+	dispatched, see ConcurrentEvent.
+
+	Parameters of @Signature can't be non-const references, the callbacks
+	get references to the copies in the slot. With several workers, the
+	messages are dispatched concurrently and in no particular order, with a
+	single worker, in the order of posting.
+
+	AsyncEvent is neither copyable nor movable.
+	*/
+	template<typename Signature = void()>
+	class AsyncEvent : public internal::AsyncEvent<Signature>
+	{
+	public:
+		using internal::AsyncEvent<Signature>::AsyncEvent;
+	};
+}
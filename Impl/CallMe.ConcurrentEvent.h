@@ -0,0 +1,924 @@
+/*
+* MIT License
+*
+* Copyright (c) 2023 Dmitry Kim <https://github.com/bitsbakery/callme>
+*
+* Permission is hereby  granted, free of charge, to any  person obtaining a copy
+* of this software and associated  documentation files (the "Software"), to deal
+* in the Software  without restriction, including without  limitation the rights
+* to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+* copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+* IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+* FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+* AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+* LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "CallMe.Event.h"
+
+namespace CallMe
+{
+	namespace internal
+	{
+		/* Epoch-based reclamation of memory shared by threads that read it
+		without locks (readers) and threads that replace it (writers).
+
+		The domain has a global epoch, every reader thread has a record
+		with the epoch it observed when it started reading, or Idle.
+		A writer that unlinks memory advances the global epoch and stamps
+		the memory with the epoch before the advance. The memory may be
+		freed once every record is either Idle or newer than the stamp,
+		because readers that start reading after the advance can't reach
+		the unlinked memory.
+
+		Entering and leaving the read side is a store of the record, there
+		are no atomic read-modify-write operations. The store on entering
+		and the loads of the shared memory by readers are seq_cst, so they
+		are ordered against the writers without standalone fences, which
+		ThreadSanitizer doesn't model.
+		The records are never freed, the records of finished threads are
+		reused by new threads. */
+		class EpochDomain
+		{
+		public:
+			constexpr static std::uint64_t Idle = 0;
+
+			//a cache line per record, so that readers don't share lines
+			struct alignas(64) Reader
+			{
+				std::atomic<std::uint64_t> _epoch{ Idle };
+				std::atomic<bool> _used{ true };
+				Reader viewptr _next = nullptr;
+			};
+
+		private:
+			std::atomic<std::uint64_t> _epoch{ Idle + 1 };
+			std::atomic<Reader viewptr> _readers{ nullptr };
+
+			EpochDomain() = default;
+
+		public:
+			EpochDomain(const EpochDomain&) = delete;
+			EpochDomain& operator=(const EpochDomain&) = delete;
+
+			//the domain shared by all concurrent events
+			static EpochDomain& instance()
+			{
+				static EpochDomain domain;
+				return domain;
+			}
+
+			//reuses the record of a finished thread or adds a new record
+			Reader viewptr acquireReader()
+			{
+				for (Reader viewptr r = _readers.load(std::memory_order_acquire); r; r = r->_next)
+				{
+					bool used = false;
+					if (r->_used.compare_exchange_strong(used, true, std::memory_order_acquire))
+						return r;
+				}
+
+				Reader viewptr r = new Reader;
+				r->_next = _readers.load(std::memory_order_relaxed);
+				while (!_readers.compare_exchange_weak(r->_next, r, std::memory_order_release,
+													   std::memory_order_relaxed))
+				{
+				}
+				return r;
+			}
+
+			static void releaseReader(Reader viewptr reader)
+			{
+				assert(reader->_epoch.load(std::memory_order_relaxed) == Idle);
+				reader->_used.store(false, std::memory_order_release);
+			}
+
+			/* seq_cst, so that the record is visible to writers before the
+			shared memory is read with seq_cst loads */
+			void enter(Reader viewptr reader)
+			{
+				reader->_epoch.store(_epoch.load(std::memory_order_acquire),
+									 std::memory_order_seq_cst);
+			}
+
+			/* the stamp of memory unlinked by a seq_cst operation without
+			advancing the epoch, readers that read the same epoch keep it
+			from being freed until a later .advance() */
+			[[nodiscard]] std::uint64_t epoch() const
+			{
+				return _epoch.load(std::memory_order_seq_cst);
+			}
+
+			static void leave(Reader viewptr reader)
+			{
+				reader->_epoch.store(Idle, std::memory_order_release);
+			}
+
+			/* called by a writer after unlinking memory, returns the stamp
+			of the unlinked memory */
+			std::uint64_t advance()
+			{
+				return _epoch.fetch_add(1, std::memory_order_seq_cst);
+			}
+
+			/* true IFF no reader except @except may still read memory
+			stamped with @stamp */
+			bool quiescent(std::uint64_t stamp, const Reader viewptr except = nullptr) const
+			{
+				for (Reader viewptr r = _readers.load(std::memory_order_acquire); r; r = r->_next)
+				{
+					if (r == except)
+						continue;
+
+					const std::uint64_t epoch = r->_epoch.load(std::memory_order_seq_cst);
+					if (epoch != Idle && epoch <= stamp)
+						return false;
+				}
+				return true;
+			}
+
+			//waits until .quiescent(@stamp, @except)
+			void synchronize(std::uint64_t stamp, const Reader viewptr except = nullptr) const
+			{
+				while (!quiescent(stamp, except))
+					std::this_thread::yield();
+			}
+		};
+
+		/* The state of the current thread as a reader of EpochDomain,
+		the record is acquired on the first read and released when
+		the thread exits */
+		struct ThreadReader
+		{
+			EpochDomain::Reader viewptr _reader;
+
+			//the number of nested read scopes
+			unsigned _depth = 0;
+
+			//incremented by every change of a concurrent event on this thread
+			std::uint64_t _mutations = 0;
+
+			/* the latest stamp that subscriptions ended within the read
+			scopes wait for when the outermost of them ends, or Idle */
+			std::uint64_t _deferred = EpochDomain::Idle;
+
+			ThreadReader() :
+				_reader(EpochDomain::instance().acquireReader())
+			{
+			}
+
+			~ThreadReader()
+			{
+				EpochDomain::releaseReader(_reader);
+			}
+
+			ThreadReader(const ThreadReader&) = delete;
+			ThreadReader& operator=(const ThreadReader&) = delete;
+
+			static ThreadReader& current()
+			{
+				thread_local ThreadReader reader;
+				return reader;
+			}
+		};
+
+		//marks the read side, memory reached within it is not freed
+		class ReadScope
+		{
+			ThreadReader& _thread;
+
+		public:
+			explicit ReadScope(ThreadReader& thread) :
+				_thread(thread)
+			{
+				if (_thread._depth++ == 0)
+					EpochDomain::instance().enter(_thread._reader);
+			}
+
+			~ReadScope()
+			{
+				if (--_thread._depth != 0)
+					return;
+
+				EpochDomain::leave(_thread._reader);
+				if (_thread._deferred != EpochDomain::Idle)
+				{
+					EpochDomain::instance().synchronize(
+						std::exchange(_thread._deferred, EpochDomain::Idle), _thread._reader);
+				}
+			}
+
+			ReadScope(const ReadScope&) = delete;
+			ReadScope& operator=(const ReadScope&) = delete;
+		};
+
+		/* Subscription records that are read without locks, the records of
+		ConcurrentEvent and of every shard of ShardedEvent.
+
+		Readers see an immutable snapshot of the records. Every change copies
+		the snapshot under the lock and publishes the copy, the replaced
+		snapshots are reclaimed through EpochDomain. Subscribing stamps the
+		replaced snapshot with the current epoch without advancing it, so
+		only unsubscription and every MaxRetired-th replacement write to the
+		global epoch. */
+		template<typename Signature>
+		class SnapshotRecords;
+
+		template<typename R, typename...ClassArgs>
+		class SnapshotRecords<R(ClassArgs...)>
+		{
+			using DelegateT = Delegate<R(ClassArgs...)>;
+
+			/* The ids of the records grow in the order of subscription,
+			so a record is found by binary search. */
+			struct Snapshot
+			{
+				std::vector<DelegateT> _callbacks;
+				std::vector<SubscriptionIndex> _ids;
+
+				//the stamp of the snapshot after it is replaced
+				std::uint64_t _retired = 0;
+
+				[[nodiscard]] std::ptrdiff_t find(SubscriptionIndex id) const
+				{
+					auto i = std::lower_bound(_ids.begin(), _ids.end(), id);
+					assert(i != _ids.end() && *i == id);
+					return i - _ids.begin();
+				}
+
+				//the position of the first record subscribed after @id
+				[[nodiscard]] std::ptrdiff_t after(SubscriptionIndex id) const
+				{
+					return std::upper_bound(_ids.begin(), _ids.end(), id) - _ids.begin();
+				}
+			};
+
+			//replaced snapshots kept before the epoch is advanced to reclaim them
+			constexpr static std::size_t MaxRetired = 8;
+
+			//the snapshot read by raise(...), nullptr if there are no records
+			std::atomic<Snapshot viewptr> _snapshot{ nullptr };
+
+			//serializes writers, never taken by raise(...)
+			std::mutex _mutex;
+
+			//the owners of the records of the current snapshot
+			std::vector<Subscription viewptr> _owners;
+
+			//the id of the next record
+			SubscriptionIndex _nextId = 0;
+
+			//replaced snapshots that readers may still see
+			std::vector<std::unique_ptr<Snapshot>> _retired;
+
+			Snapshot copy() const
+			{
+				const Snapshot viewptr current = _snapshot.load(std::memory_order_relaxed);
+				return current != nullptr ? Snapshot{ current->_callbacks, current->_ids } : Snapshot{};
+			}
+
+			/* makes @next the snapshot read by raise(...), under the lock.
+			If @advance, returns the stamp to synchronize with, so that the
+			replaced snapshot is not read on other threads anymore */
+			std::uint64_t publish(Snapshot&& next, bool advance)
+			{
+				Snapshot viewptr published = next._ids.empty() ?
+					nullptr : new Snapshot(std::move(next));
+				//seq_cst, so that readers of a later epoch see the new snapshot
+				Snapshot viewptr replaced = _snapshot.exchange(published, std::memory_order_seq_cst);
+
+				++ThreadReader::current()._mutations;
+
+				EpochDomain& domain = EpochDomain::instance();
+				advance = advance || _retired.size() >= MaxRetired;
+				const std::uint64_t stamp = advance ? domain.advance() : domain.epoch();
+				if (replaced != nullptr)
+				{
+					replaced->_retired = stamp;
+					_retired.emplace_back(replaced);
+				}
+
+				if (advance)
+				{
+					std::erase_if(_retired, [&domain](const std::unique_ptr<Snapshot>& s)
+					{
+						return domain.quiescent(s->_retired);
+					});
+				}
+				return stamp;
+			}
+
+		public:
+			SnapshotRecords() = default;
+
+			SnapshotRecords(const SnapshotRecords&) = delete;
+			SnapshotRecords& operator=(const SnapshotRecords&) = delete;
+
+			//only after .detach() and synchronization with its stamp
+			~SnapshotRecords()
+			{
+				assert(_owners.empty());
+				delete _snapshot.load(std::memory_order_relaxed);
+			}
+
+			[[nodiscard]] std::size_t count() const
+			{
+				//the snapshot may be replaced and reclaimed meanwhile
+				ReadScope scope(ThreadReader::current());
+				const Snapshot viewptr snapshot = _snapshot.load(std::memory_order_seq_cst);
+				return snapshot != nullptr ? snapshot->_ids.size() : 0;
+			}
+
+			//returns the id of the new record
+			SubscriptionIndex add(DelegateT&& callback)
+			{
+				std::lock_guard lock(_mutex);
+
+				Snapshot next = copy();
+				const SubscriptionIndex id = _nextId++;
+				next._callbacks.push_back(std::move(callback));
+				next._ids.push_back(id);
+				_owners.push_back(nullptr);
+
+				publish(std::move(next), false);
+				return id;
+			}
+
+			//returns the stamp to synchronize with
+			std::uint64_t remove(SubscriptionIndex id)
+			{
+				std::lock_guard lock(_mutex);
+
+				Snapshot next = copy();
+				const std::ptrdiff_t i = next.find(id);
+				next._callbacks.erase(next._callbacks.begin() + i);
+				next._ids.erase(next._ids.begin() + i);
+				_owners.erase(_owners.begin() + i);
+
+				return publish(std::move(next), true);
+			}
+
+			//returns the stamp to synchronize with
+			std::uint64_t removeMany(std::span<const SubscriptionIndex> ids)
+			{
+				std::lock_guard lock(_mutex);
+
+				Snapshot next = copy();
+
+				/* null owners can't mark the removed records, records whose
+				Subscription is still being constructed have them too */
+				std::vector<bool> removed(_owners.size());
+				for (SubscriptionIndex id : ids)
+					removed[std::size_t(next.find(id))] = true;
+
+				std::ptrdiff_t to = 0;
+				for (std::ptrdiff_t from = 0; from != std::ssize(_owners); ++from)
+				{
+					if (removed[std::size_t(from)])
+						continue;
+					next._callbacks[to] = std::move(next._callbacks[from]);
+					next._ids[to] = next._ids[from];
+					_owners[to++] = _owners[from];
+				}
+				next._callbacks.resize(to);
+				next._ids.resize(to);
+				_owners.resize(to);
+
+				return publish(std::move(next), true);
+			}
+
+			void changeOwner(SubscriptionIndex id, Subscription viewptr newOwner)
+			{
+				std::lock_guard lock(_mutex);
+				_owners[_snapshot.load(std::memory_order_relaxed)->find(id)] = newOwner;
+			}
+
+			DelegateT callback(SubscriptionIndex id)
+			{
+				std::lock_guard lock(_mutex);
+				const Snapshot viewptr current = _snapshot.load(std::memory_order_relaxed);
+				return current->_callbacks[current->find(id)];
+			}
+
+			//returns the stamp to synchronize with
+			std::uint64_t replace(SubscriptionIndex id, const DelegateT& callback)
+			{
+				std::lock_guard lock(_mutex);
+
+				Snapshot next = copy();
+				next._callbacks[next.find(id)] = callback;
+				return publish(std::move(next), true);
+			}
+
+			/* detaches all Subscriptions and removes all records,
+			returns the stamp to synchronize with */
+			std::uint64_t detach()
+			{
+				std::lock_guard lock(_mutex);
+
+				for (Subscription viewptr owner : _owners)
+				{
+					if (owner != nullptr)
+						SubscriptionAccess::releaseOwnership(owner);
+				}
+				_owners.clear();
+				return publish({}, true);
+			}
+
+			/* invokes the records in a read scope of @thread, see
+			ConcurrentEvent::raise(...) */
+			MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
+			void raise(const ThreadReader& thread, ClassArgs...args)
+			{
+				assert(thread._depth != 0);
+
+				//seq_cst, see EpochDomain::enter(...)
+				Snapshot viewptr snapshot = _snapshot.load(std::memory_order_seq_cst);
+				if (snapshot == nullptr)
+					return;
+
+				//the last record subscribed before the dispatch
+				const SubscriptionIndex last = snapshot->_ids.back();
+
+				std::ptrdiff_t end = std::ssize(snapshot->_callbacks);
+				for (std::ptrdiff_t i = 0; i != end; ++i)
+				{
+					const std::uint64_t mutations = thread._mutations;
+					snapshot->_callbacks[i].invoke(std::forward<ClassArgs>(args)...);
+
+					if (thread._mutations != mutations) [[unlikely]]
+					{
+						Snapshot viewptr current = _snapshot.load(std::memory_order_acquire);
+						if (current == nullptr)
+							return;
+
+						if (current != snapshot)
+						{
+							const SubscriptionIndex invoked = snapshot->_ids[i];
+							snapshot = current;
+							i = snapshot->after(invoked) - 1;
+							end = snapshot->after(last);
+						}
+					}
+				}
+			}
+			MSVC_SUPPRESS_WARNING_POP
+
+		#ifndef NDEBUG
+			/* the owner of the record @id has the index @id * @scale + @offset
+			in @event */
+			void validate(const ErasedEvent viewptr event,
+						  SubscriptionIndex scale, SubscriptionIndex offset)
+			{
+				std::lock_guard lock(_mutex);
+
+				const Snapshot viewptr snapshot = _snapshot.load(std::memory_order_relaxed);
+				if (snapshot == nullptr)
+				{
+					assert(_owners.empty());
+					return;
+				}
+
+				assert(snapshot->_callbacks.size() == _owners.size());
+				assert(snapshot->_ids.size() == _owners.size());
+				assert(std::is_sorted(snapshot->_ids.begin(), snapshot->_ids.end()));
+				for (std::size_t i = 0; i != _owners.size(); ++i)
+				{
+					if (_owners[i] == nullptr)//the Subscription is being constructed
+						continue;
+					assert(SubscriptionAccess::event(_owners[i]) == event);
+					assert(SubscriptionAccess::index(_owners[i]) == snapshot->_ids[i] * scale + offset);
+				}
+			}
+		#endif
+		};
+
+		/* waits until callbacks of the snapshots replaced at @stamp are not
+		running on other threads. On this thread, raise(...) switches to
+		the new snapshot as soon as the current callback returns. */
+		inline void synchronize(std::uint64_t stamp)
+		{
+			EpochDomain::instance().synchronize(stamp, ThreadReader::current()._reader);
+		}
+
+		/* synchronize(@stamp) for an ended subscription. Within a read scope,
+		that is in a callback of a concurrent event, the wait is deferred
+		until the outermost read scope of the thread ends: callbacks that
+		end subscriptions on several threads would otherwise wait for each
+		other forever, as none of them leaves its read scope. */
+		inline void synchronizeEnded(std::uint64_t stamp)
+		{
+			ThreadReader& thread = ThreadReader::current();
+			if (thread._depth == 0)
+				EpochDomain::instance().synchronize(stamp, thread._reader);
+			else
+				thread._deferred = std::max(thread._deferred, stamp);
+		}
+
+		template<typename Signature>
+		class ConcurrentEvent;
+
+		//the index of a Subscription is the id of its record
+		template<typename R, typename...ClassArgs>
+		class ConcurrentEvent<R(ClassArgs...)> : public ErasedEvent
+		{
+			using Signature = R(ClassArgs...);
+
+			using DelegateT = Delegate<Signature>;
+
+			SnapshotRecords<Signature> _records;
+
+		public:
+			ConcurrentEvent() = default;
+
+			ConcurrentEvent(const ConcurrentEvent&) = delete;
+			ConcurrentEvent& operator=(const ConcurrentEvent&) = delete;
+
+			/* The Subscriptions are detached. The Event must not be raised
+			or subscribed to on other threads, and its Subscriptions must not
+			be moved or destroyed on other threads during the destruction. */
+			~ConcurrentEvent() override
+			{
+				synchronize(_records.detach());
+			}
+
+			/* Notify all subscribers on the calling thread. The callbacks are
+			read from an immutable snapshot of the subscriptions without locks
+			or atomic read-modify-write operations, so any number of threads
+			may raise the event while other threads subscribe and unsubscribe.
+
+			Callbacks subscribed during the dispatch are invoked starting from
+			the next .raise(...). Callbacks unsubscribed by other threads
+			during the dispatch may still be invoked until their ~Subscription()
+			returns. If a callback changes subscriptions of any concurrent
+			event, the dispatch continues with the current snapshot of this
+			event, so callbacks unsubscribed by this thread are not invoked
+			anymore. If the callbacks end subscriptions, the outermost
+			.raise(...) on this thread returns once the ended callbacks don't
+			run on other threads.
+
+			NDEBUG complexity: O(ConcurrentEvent::count()) */
+			void raise(ClassArgs...args)
+			{
+				ThreadReader& thread = ThreadReader::current();
+				ReadScope scope(thread);
+				_records.raise(thread, std::forward<ClassArgs>(args)...);
+			}
+
+			// the same as .raise(...)
+			void operator()(ClassArgs...args)
+			{
+				raise(std::forward<ClassArgs>(args)...);
+			}
+
+			/* Subscribe @callback to the Event, may be called on any thread.
+
+			The returned Subscription may be moved and destroyed on any
+			thread. Once its destructor returns, @callback is not invoked
+			anymore, see ~Subscription(). Subscriptions are allowed to outlive
+			the Event.
+
+			NDEBUG complexity: O(ConcurrentEvent::count()) */
+			[[nodiscard]] Subscription subscribe(DelegateT&& callback)
+			{
+				return Subscription(_records.add(std::move(callback)), this);
+			}
+
+			template<typename MismatchingSignature>
+				requires (not std::same_as<MismatchingSignature, Signature>)
+			DELETE_FUNCTION(Subscription subscribe(Delegate<MismatchingSignature>&&),
+							MsgEventCallbackMismatch)
+
+			/* Subscribe @callback to the Event, see the other overload.
+			The function saves a Subscription object in @dst. */
+			template<typename VectorOfSubscriptions = std::vector<Subscription>>
+			void subscribe(DelegateT&& callback, VectorOfSubscriptions& dst)
+			{
+				dst.emplace_back(_records.add(std::move(callback)), this);
+			}
+
+			template<typename MismatchingSignature, typename VectorOfSubscriptions>
+				requires (not std::same_as<MismatchingSignature, Signature>)
+			DELETE_FUNCTION(void subscribe(Delegate<MismatchingSignature>&&,
+										   VectorOfSubscriptions&),
+							MsgEventCallbackMismatch)
+
+			//the number of subscriptions at the moment of the call
+			[[nodiscard]] std::size_t count() const
+			{
+				return _records.count();
+			}
+
+			[[nodiscard]] bool empty() const
+			{
+				return count() == 0;
+			}
+
+			/* waits until the callback of the ended subscription doesn't run
+			on other threads, within a callback see synchronizeEnded(...) */
+			void unsubscribe(SubscriptionIndex toRemove) override
+			{
+				synchronizeEnded(_records.remove(toRemove));
+			}
+
+			void unsubscribeMany(std::span<const SubscriptionIndex> toRemove) override
+			{
+				synchronizeEnded(_records.removeMany(toRemove));
+			}
+
+			void changeOwner(SubscriptionIndex toChange, Subscription viewptr newOwner) override
+			{
+				_records.changeOwner(toChange, newOwner);
+			}
+
+			//the owners are guarded by the lock, see changeOwner(...)
+			OwnerTable ownerTable() override
+			{
+				return {};
+			}
+
+			void moveDelegate(SubscriptionIndex from, SubscriptionIndex to) override
+			{
+				synchronizeEnded(_records.replace(to, _records.callback(from)));
+			}
+
+		#ifndef NDEBUG
+			void validate() override
+			{
+				_records.validate(this, 1, 0);
+			}
+		#endif
+		};
+
+		template<typename Signature>
+		class ShardedEvent;
+
+		/* The index of a Subscription is the id of its record in its shard
+		times the number of shards plus the number of the shard */
+		template<typename R, typename...ClassArgs>
+		class ShardedEvent<R(ClassArgs...)> : public ErasedEvent
+		{
+			using Signature = R(ClassArgs...);
+
+			using DelegateT = Delegate<Signature>;
+
+			//a cache line per shard, so that threads don't share lines
+			struct alignas(64) Shard : SnapshotRecords<Signature>
+			{
+			};
+
+			std::unique_ptr<Shard[]> _shards;
+			SubscriptionIndex _nShards;
+
+			//the shard of the calling thread, threads are spread round-robin
+			Shard& home()
+			{
+				static std::atomic<std::size_t> nThreads{ 0 };
+				thread_local const std::size_t thread = nThreads.fetch_add(1, std::memory_order_relaxed);
+				return _shards[thread % std::size_t(_nShards)];
+			}
+
+			Shard& shardOf(SubscriptionIndex index)
+			{
+				return _shards[index % _nShards];
+			}
+
+			SubscriptionIndex idOf(SubscriptionIndex index) const
+			{
+				return index / _nShards;
+			}
+
+			SubscriptionIndex indexOf(const Shard& shard, SubscriptionIndex id) const
+			{
+				return id * _nShards + SubscriptionIndex(&shard - _shards.get());
+			}
+
+			SubscriptionIndex add(DelegateT&& callback)
+			{
+				Shard& shard = home();
+				return indexOf(shard, shard.add(std::move(callback)));
+			}
+
+		public:
+			/* @nShards is rounded up to a power of 2, by default there is
+			a shard per hardware thread */
+			explicit ShardedEvent(std::size_t nShards = std::thread::hardware_concurrency()) :
+				_shards(new Shard[std::bit_ceil(std::max<std::size_t>(nShards, 1))]),
+				_nShards(SubscriptionIndex(std::bit_ceil(std::max<std::size_t>(nShards, 1))))
+			{
+			}
+
+			ShardedEvent(const ShardedEvent&) = delete;
+			ShardedEvent& operator=(const ShardedEvent&) = delete;
+
+			//see ~ConcurrentEvent()
+			~ShardedEvent() override
+			{
+				std::uint64_t stamp = 0;
+				for (SubscriptionIndex s = 0; s != _nShards; ++s)
+					stamp = std::max(stamp, _shards[s].detach());
+				synchronize(stamp);
+			}
+
+			/* Notify all subscribers on the calling thread, the shards are
+			walked one by one, see ConcurrentEvent::raise(...). Callbacks
+			subscribed during the dispatch may or may not be invoked by it.
+
+			NDEBUG complexity: O(ShardedEvent::count() + the number of shards) */
+			MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
+			void raise(ClassArgs...args)
+			{
+				ThreadReader& thread = ThreadReader::current();
+				ReadScope scope(thread);
+				for (SubscriptionIndex s = 0; s != _nShards; ++s)
+					_shards[s].raise(thread, std::forward<ClassArgs>(args)...);
+			}
+			MSVC_SUPPRESS_WARNING_POP
+
+			// the same as .raise(...)
+			void operator()(ClassArgs...args)
+			{
+				raise(std::forward<ClassArgs>(args)...);
+			}
+
+			/* Subscribe @callback to the shard of the calling thread, see
+			ConcurrentEvent::subscribe(...).
+
+			NDEBUG complexity: O(the number of subscriptions in the shard) */
+			[[nodiscard]] Subscription subscribe(DelegateT&& callback)
+			{
+				return Subscription(add(std::move(callback)), this);
+			}
+
+			template<typename MismatchingSignature>
+				requires (not std::same_as<MismatchingSignature, Signature>)
+			DELETE_FUNCTION(Subscription subscribe(Delegate<MismatchingSignature>&&),
+							MsgEventCallbackMismatch)
+
+			/* Subscribe @callback to the Event, see the other overload.
+			The function saves a Subscription object in @dst. */
+			template<typename VectorOfSubscriptions = std::vector<Subscription>>
+			void subscribe(DelegateT&& callback, VectorOfSubscriptions& dst)
+			{
+				dst.emplace_back(add(std::move(callback)), this);
+			}
+
+			template<typename MismatchingSignature, typename VectorOfSubscriptions>
+				requires (not std::same_as<MismatchingSignature, Signature>)
+			DELETE_FUNCTION(void subscribe(Delegate<MismatchingSignature>&&,
+										   VectorOfSubscriptions&),
+							MsgEventCallbackMismatch)
+
+			//the number of subscriptions at the moment of the call
+			[[nodiscard]] std::size_t count() const
+			{
+				std::size_t n = 0;
+				for (SubscriptionIndex s = 0; s != _nShards; ++s)
+					n += _shards[s].count();
+				return n;
+			}
+
+			[[nodiscard]] bool empty() const
+			{
+				return count() == 0;
+			}
+
+			[[nodiscard]] std::size_t shards() const
+			{
+				return std::size_t(_nShards);
+			}
+
+			/* only the shard of the subscription is locked and copied, whatever
+			thread ends it. The wait is that of ConcurrentEvent::unsubscribe(...):
+			the epoch is shared by all events, so it advances the global epoch
+			and scans the records of all reader threads. */
+			void unsubscribe(SubscriptionIndex toRemove) override
+			{
+				synchronizeEnded(shardOf(toRemove).remove(idOf(toRemove)));
+			}
+
+			//a lock per shard of the subscriptions
+			void unsubscribeMany(std::span<const SubscriptionIndex> toRemove) override
+			{
+				std::vector<SubscriptionIndex> sorted(toRemove.begin(), toRemove.end());
+				std::sort(sorted.begin(), sorted.end(), [this](SubscriptionIndex a, SubscriptionIndex b)
+				{
+					return a % _nShards < b % _nShards;
+				});
+
+				std::uint64_t stamp = 0;
+				for (auto first = sorted.begin(); first != sorted.end();)
+				{
+					Shard& shard = shardOf(*first);
+					auto last = std::find_if(first, sorted.end(), [&](SubscriptionIndex i)
+					{
+						return &shardOf(i) != &shard;
+					});
+					std::for_each(first, last, [this](SubscriptionIndex& i) { i = idOf(i); });
+
+					stamp = std::max(stamp, shard.removeMany({ first, last }));
+					first = last;
+				}
+				synchronizeEnded(stamp);
+			}
+
+			void changeOwner(SubscriptionIndex toChange, Subscription viewptr newOwner) override
+			{
+				shardOf(toChange).changeOwner(idOf(toChange), newOwner);
+			}
+
+			//the owners are guarded by the locks of the shards
+			OwnerTable ownerTable() override
+			{
+				return {};
+			}
+
+			void moveDelegate(SubscriptionIndex from, SubscriptionIndex to) override
+			{
+				synchronizeEnded(shardOf(to).replace(idOf(to), shardOf(from).callback(idOf(from))));
+			}
+
+		#ifndef NDEBUG
+			void validate() override
+			{
+				for (SubscriptionIndex s = 0; s != _nShards; ++s)
+					_shards[s].validate(this, _nShards, s);
+			}
+		#endif
+		};
+	}
+
+	/* Event that may be raised on any number of threads while other threads
+	subscribe and unsubscribe.
+
+	.raise(...) iterates an immutable snapshot of (invoker, object) pairs
+	without locks and without atomic read-modify-write operations.
+	Subscribing and unsubscribing copy the snapshot under a lock and
+	publish the new one, the replaced snapshots are freed when no thread
+	raising the event may still read them, see internal::EpochDomain.
+	So, unlike Event, subscribing and unsubscribing cost
+	O(ConcurrentEvent::count()), prefer ConcurrentEvent for events that are
+	raised far more often than subscribed.
+
+	Subscriptions are ordinary Subscription objects, so they may be stored
+	in vectors of subscriptions, SubscriptionVector or SubscriptionGroup
+	together with subscriptions to other events. Destroying a Subscription
+	of ConcurrentEvent waits until no other thread runs its callback, so
+	never end subscriptions while holding a lock that the callbacks take.
+	A Subscription ended in a callback of a concurrent event doesn't wait:
+	its callback may still run on other threads until the outermost
+	.raise(...) on the ending thread returns, which waits instead. So
+	callbacks on several threads may end subscriptions at a time, but they
+	must not release what the ended callbacks use.
+
+	ConcurrentEvent is neither copyable nor movable.
+	*/
+	template<typename Signature = void()>
+	class ConcurrentEvent : public internal::ConcurrentEvent<Signature>
+	{
+	};
+
+	/* ConcurrentEvent with a set of subscription records per shard, for
+	events that many threads subscribe to and unsubscribe from at a time.
+
+	A thread subscribes to its own shard, so threads don't contend for
+	a lock or copy the subscriptions of other threads, and a Subscription
+	locks and copies only its shard when it ends, whatever thread ends it.
+	Waiting for its callback to return on other threads is the same as for
+	ConcurrentEvent: the unsubscription advances the epoch shared by all
+	concurrent events and waits for readers of all threads, and it is
+	deferred within callbacks.
+	.raise(...) walks all shards, so it costs
+	O(ShardedEvent::count() + ShardedEvent::shards()). Unlike
+	ConcurrentEvent, the order of the callbacks is the order of
+	subscription only within a shard.
+
+	ShardedEvent is neither copyable nor movable.
+	*/
+	template<typename Signature = void()>
+	class ShardedEvent : public internal::ShardedEvent<Signature>
+	{
+	public:
+		using internal::ShardedEvent<Signature>::ShardedEvent;
+	};
+}
@@ -0,0 +1,236 @@
+/*
+* MIT License
+*
+* Copyright (c) 2023 Dmitry Kim <https://github.com/bitsbakery/callme>
+*
+* Permission is hereby  granted, free of charge, to any  person obtaining a copy
+* of this software and associated  documentation files (the "Software"), to deal
+* in the Software  without restriction, including without  limitation the rights
+* to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+* copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+* IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+* FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+* AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+* LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+#include "CallMe.h"
+
+namespace CallMe
+{
+	namespace internal
+	{
+		template<typename Signature, typename DelegateT>
+		class DelegateMailbox;
+
+		template<typename R, typename...ClassArgs, typename DelegateT>
+		class DelegateMailbox<R(ClassArgs...), DelegateT>
+		{
+			//a posted invocation: the callback and the copies of the arguments
+			struct Item
+			{
+				DelegateT _callback;
+				std::tuple<std::decay_t<ClassArgs>...> _args;
+
+				void invoke()
+				{
+					std::apply([this](std::decay_t<ClassArgs>&...args)
+					{
+						//every item is invoked once, so rvalue parameters get the copies
+						_callback.invoke(static_cast<ClassArgs&&>(args)...);
+					}, _args);
+				}
+			};
+
+			/* A slot of the bounded ring. @_sequence == the position + 1:
+			holds the item of that position, which is ready to be invoked.
+			Whether the slot is free is told by the head, not by the slot.
+			A cache line per slot, so that producers don't share lines */
+			struct alignas(64) Slot
+			{
+				std::atomic<std::size_t> _sequence;
+				alignas(Item) std::byte _item[sizeof(Item)];
+
+				Item& item()
+				{
+					return *std::launder(reinterpret_cast<Item*>(_item));
+				}
+			};
+
+			std::unique_ptr<Slot[]> _slots;
+			std::size_t _mask;
+
+			//the position of the next item to post, shared by the producers
+			alignas(64) std::atomic<std::size_t> _tail{ 0 };
+
+			/* the last head read by a producer, so that the producers read
+			the line of the consumer only when the ring looks full */
+			std::atomic<std::size_t> _cachedHead{ 0 };
+
+			/* the position of the next item to invoke, written only by
+			the consumer, once per batch. The slots before it are free */
+			alignas(64) std::atomic<std::size_t> _head{ 0 };
+
+			//true if the slot of @pos may still hold an item, for a @head
+			bool taken(std::size_t pos, std::size_t head) const
+			{
+				return std::ptrdiff_t(pos - head) > std::ptrdiff_t(_mask);
+			}
+
+		public:
+			explicit DelegateMailbox(std::size_t capacity = 1024) :
+				_slots(new Slot[std::bit_ceil(std::max<std::size_t>(capacity, 2))]),
+				_mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1)
+			{
+				for (std::size_t i = 0; i <= _mask; ++i)
+					_slots[i]._sequence.store(i, std::memory_order_relaxed);
+			}
+
+			DelegateMailbox(const DelegateMailbox&) = delete;
+			DelegateMailbox& operator=(const DelegateMailbox&) = delete;
+
+			//the items that were not drained are destroyed without invocation
+			~DelegateMailbox()
+			{
+				for (std::size_t pos = _head.load(std::memory_order_relaxed);; ++pos)
+				{
+					Slot& slot = _slots[pos & _mask];
+					if (slot._sequence.load(std::memory_order_acquire) != pos + 1)
+						break;
+					slot.item().~Item();
+				}
+			}
+
+			/* Post the invocation of @callback with @args to the consumer,
+			may be called on any thread. The arguments are copied into a free
+			slot of the ring. Returns false if all slots are taken by items
+			that are not drained yet.
+
+			Doesn't allocate, unless copying @args or moving @callback does.
+
+			NDEBUG complexity: O(1) */
+			bool tryPost(DelegateT&& callback, const std::decay_t<ClassArgs>&...args)
+			{
+				std::size_t pos = _tail.load(std::memory_order_relaxed);
+				do
+				{
+					//acquire, so that the item that was in the slot is destroyed
+					if (taken(pos, _cachedHead.load(std::memory_order_acquire)))
+					{
+						const std::size_t head = _head.load(std::memory_order_acquire);
+						if (taken(pos, head))
+							return false;
+						_cachedHead.store(head, std::memory_order_release);
+					}
+				} while (!_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed));
+
+				Slot* slot = &_slots[pos & _mask];
+				new (slot->_item) Item{ std::move(callback), { args... } };
+				slot->_sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+
+			//.tryPost(...) that waits for a free slot while the ring is full
+			void post(DelegateT&& callback, const std::decay_t<ClassArgs>&...args)
+			{
+				while (!tryPost(std::move(callback), args...))
+					std::this_thread::yield();
+			}
+
+			/* Invoke at most @maxItems posted items on the calling thread, in
+			the order of posting, returns the number of invoked items.
+			Must be called on a single thread at a time, the owner of the
+			mailbox, and not by the callbacks.
+
+			The ready items are claimed as one batch before any of them is
+			invoked, and their slots are handed back to the producers with
+			a single store of the head after the batch. The consumer doesn't
+			write to the slots, and producers read the head only when their
+			cached copy of it says that the ring is full. Items posted by
+			callbacks of the batch are invoked by the next .drain(...).
+			The slots of the batch are freed when it ends, so a callback
+			must not .post(...) to a full mailbox that it is drained from,
+			it would wait forever, .tryPost(...) fails instead.
+
+			NDEBUG complexity: O(the number of invoked items) */
+			std::size_t drain(std::size_t maxItems = SIZE_MAX)
+			{
+				//the consecutive slots with posted items
+				const std::size_t first = _head.load(std::memory_order_relaxed);
+				std::size_t end = first;
+				while (end - first != maxItems &&
+					   _slots[end & _mask]._sequence.load(std::memory_order_acquire) == end + 1)
+					++end;
+
+				for (std::size_t pos = first; pos != end; ++pos)
+				{
+					Item& item = _slots[pos & _mask].item();
+					item.invoke();
+					item.~Item();
+				}
+				if (end != first)
+					_head.store(end, std::memory_order_release);
+				return end - first;
+			}
+
+			//true if there is no item to drain, only on the consumer thread
+			[[nodiscard]] bool empty() const
+			{
+				const std::size_t head = _head.load(std::memory_order_relaxed);
+				return _slots[head & _mask]._sequence.load(std::memory_order_acquire) != head + 1;
+			}
+
+			//the number of items that fit into the ring
+			[[nodiscard]] std::size_t capacity() const
+			{
+				return _mask + 1;
+			}
+		};
+	}
+
+	/* A mailbox of invocations that any thread posts and a single owner
+	thread drains, e.g. "run this callback on the UI thread".
+
+	An item is a @DelegateT callback with copies of the arguments, they are
+	stored inline in a slot of a bounded lock-free ring that is allocated
+	with the mailbox. So posting doesn't allocate, provided that the
+	callback doesn't: Delegate<...> never does, OwningDelegate<...> does
+	only for targets that don't fit its inline storage.
+
+	The owner thread calls .drain(maxItems) to invoke the items in batches.
+	The callbacks get the copies of the arguments, rvalue reference
+	parameters get rvalues, as every item is invoked once. Results of
+	the callbacks are discarded.
+
+	DelegateMailbox is neither copyable nor movable.
+	*/
+	template<typename Signature = void(), typename DelegateT = Delegate<Signature>>
+	class DelegateMailbox : public internal::DelegateMailbox<Signature, DelegateT>
+	{
+	public:
+		using internal::DelegateMailbox<Signature, DelegateT>::DelegateMailbox;
+	};
+}
@@ -26,8 +26,19 @@
 
 #define USE_SMALL_VECTOR
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <numeric>
 #include <optional>
+#include <span>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #ifdef USE_SMALL_VECTOR
@@ -37,35 +48,296 @@
 
 #include "CallMe.h"
 
+#ifdef USE_SMALL_VECTOR
+namespace gch
+{
+	/* Delegate is a pair of pointers and its move constructor only resets
+	the source, so vectors of subscription records grow with memcpy */
+	template<typename R, typename...ClassArgs>
+	struct is_trivially_relocatable<CallMe::Delegate<R(ClassArgs...)>> : std::true_type
+	{
+	};
+}
+#endif
+
 namespace CallMe
 {
 	/*
-
-		Subscription1{ <------------+			
-			Event*					|
-			SubscriptionIndex(0)	|
-		}							|
-	+-> Subscription2{				|
-	|		Event*					|
-	|		SubscriptionIndex(1)	|
-	|	}							|
-	|								|
-	|	vector subscriptions{		|
-	|		SubscriptionRecord1{	|
-	|			delegate1			|
-	|			Subscription* ------+
-	|		},		
-	|		SubscriptionRecord2{	
-	|			delegate2
-	+---------- Subscription*
-			},
-			...
-			SubscriptionRecordN{...}
-		}
-
+		Subscription records are stored in the structure-of-arrays layout.
+		The hot array of callbacks is all that raise(...) reads, the cold
+		array of owners is only used for maintaining subscriptions.
+
+		Subscription1{ <-------------------------+
+			Event*								 |
+			SubscriptionIndex(0)				 |
+		}										 |
+	+-> Subscription2{							 |
+	|		Event*								 |
+	|		SubscriptionIndex(1)				 |
+	|	}									 	 |
+	|											 |
+	|	hot vector callbacks{	cold vector owners{
+	|		delegate1				Subscription* ---+
+	|		delegate2				Subscription* ---+
+	|		...						...				 |
+	|		delegateN				Subscription*	 |
+	|	}						}					 |
+	|												 |
+	+------------------------------------------------+
 	*/
 
 	class Subscription;
+	class SlotSubscription;
+
+	/* The order in which Event::raise(...) invokes subscribed callbacks.
+
+	Unspecified - the order of invocation is unspecified. Unsubscription
+	swaps the last record into the freed slot, so the callbacks end up
+	shuffled over time. Event::optimizeOrder() groups them on demand.
+
+	Grouped - the order of invocation is still unspecified, but before
+	raising, the Event groups its callbacks by their invoker thunks and
+	then by target addresses if any subscription was added or removed
+	since the previous raise. Consecutive invocations then reuse the same
+	thunk and touch neighbouring targets, which helps indirect branch
+	prediction and data locality. Prefer this for events that are raised
+	far more often than subscribed/unsubscribed.
+
+	Fifo - callbacks are invoked in the order of subscription. Unsubscription
+	leaves a tombstone in place of the record instead of moving other records.
+	Tombstones are compacted, preserving the order, at the end of the next
+	raise or once they make up half of the records, so unsubscription stays
+	O(1) amortized.
+
+	Priority - callbacks subscribed with greater priority are invoked earlier,
+	callbacks with equal priorities in the order of subscription, see
+	Event::subscribe(callback, priority). Unsubscription is the same as for
+	Fifo. If a callback is subscribed with greater priority than the last
+	subscribed one, the next raise stable-sorts the records first. */
+	enum class DispatchOrder
+	{
+		Unspecified,
+		Grouped,
+		Fifo,
+		Priority
+	};
+
+	/* The order in which EventQueue::dispatch(...) delivers the queued items.
+
+	ItemMajor - every item is raised to all subscribers in turn, like calling
+	Event::raise(...) per item.
+
+	SubscriberMajor - every subscriber gets all items in turn, so the code of
+	a callback stays hot in the instruction cache for the whole batch. The
+	order of subscribers is defined by DispatchOrder. */
+	enum class QueueDispatch
+	{
+		ItemMajor,
+		SubscriberMajor
+	};
+
+	/* How an Event and its subscriptions refer to each other.
+
+	BackPointers - subscriptions are Subscription objects. The Event stores
+	a pointer to the owning Subscription of every record. Moving a Subscription
+	updates the pointer in the Event, moving or destroying the Event updates
+	all of its Subscriptions.
+
+	SlotMap - subscriptions are SlotSubscription objects, which hold
+	{slot, generation} handles into a slot table shared by the Event and its
+	subscriptions. The Event stores slot numbers instead of pointers. Moving
+	a SlotSubscription touches only the SlotSubscription itself, moving or
+	destroying the Event does not touch its SlotSubscriptions at all. The slot
+	table is allocated on the heap on the first subscription and outlives the
+	Event while there are SlotSubscriptions, so that stale SlotSubscriptions
+	are detected.
+
+	ControlBlock - subscriptions are Subscription objects, but they point to
+	a small control block shared by the Event and its subscriptions instead of
+	the Event itself. Moving a Subscription updates the pointer in the Event
+	as with BackPointers, while moving, clearing or destroying the Event
+	updates just the control block. */
+	enum class EventStorage
+	{
+		BackPointers,
+		SlotMap,
+		ControlBlock
+	};
+
+	/* An executor runs chunks of the callbacks of Event::raiseParallel(...)
+	in parallel, e.g. WorkStealingPool from CallMe.WorkStealingPool.h.
+
+	.parallelFor(count, grain, chunk) invokes @chunk for consecutive ranges
+	[begin, end) of at most @grain indices that cover [0, count), and returns
+	once all of them have returned. */
+	template<typename Executor>
+	concept ParallelExecutor = requires(Executor& executor, std::ptrdiff_t n,
+										Delegate<void(std::ptrdiff_t, std::ptrdiff_t)> chunk)
+	{
+		executor.parallelFor(n, n, chunk);
+	};
+
+	/* The number of callbacks per chunk of Event::raiseParallel(...).
+	Smaller chunks balance callbacks of unequal cost better, larger ones
+	synchronize less. Events with no more callbacks than a single chunk
+	are raised on the calling thread. */
+	struct ParallelGrain
+	{
+		std::ptrdiff_t callbacks = 16;
+	};
+
+	/* A combiner folds the results of callbacks of an Event with non-void
+	return type R, see Event::collect(...).
+
+	For every invoked callback, the Event passes its result to the combiner's
+	operator(), which returns false to stop raising, i.e. the remaining
+	callbacks are not invoked. After raising, collect(...) returns
+	the combiner's .result(). */
+	template<typename Combiner, typename R>
+	concept ResultCombiner = requires(Combiner& combiner, R&& r)
+	{
+		{ combiner(std::forward<R>(r)) } -> std::convertible_to<bool>;
+		combiner.result();
+	};
+
+	//built-in combiners, none of them allocates
+	namespace combiners
+	{
+		//the sum of all results, R{} if there are no callbacks
+		template<typename R>
+		struct Sum
+		{
+			R _sum{};
+
+			bool operator()(R&& r)
+			{
+				_sum += std::move(r);
+				return true;
+			}
+
+			R result() { return std::move(_sum); }
+		};
+
+		//the least result, std::nullopt if there are no callbacks
+		template<typename R>
+		struct Min
+		{
+			std::optional<R> _min;
+
+			bool operator()(R&& r)
+			{
+				if (!_min || r < *_min)
+					_min = std::move(r);
+				return true;
+			}
+
+			std::optional<R> result() { return std::move(_min); }
+		};
+
+		//the greatest result, std::nullopt if there are no callbacks
+		template<typename R>
+		struct Max
+		{
+			std::optional<R> _max;
+
+			bool operator()(R&& r)
+			{
+				if (!_max || *_max < r)
+					_max = std::move(r);
+				return true;
+			}
+
+			std::optional<R> result() { return std::move(_max); }
+		};
+
+		/* the first result that converts to true, e.g. a non-empty
+		std::optional or a non-null pointer, R{} if there is no such result.
+		Stops raising at that result. */
+		template<typename R>
+		struct FirstNonEmpty
+		{
+			R _first{};
+
+			bool operator()(R&& r)
+			{
+				if (!r)
+					return true;
+
+				_first = std::move(r);
+				return false;
+			}
+
+			R result() { return std::move(_first); }
+		};
+
+		/* logical AND of all results, true if there are no callbacks.
+		Stops raising at the first false. */
+		struct All
+		{
+			bool _all = true;
+
+			bool operator()(bool r)
+			{
+				_all = r;
+				return r;
+			}
+
+			bool result() const { return _all; }
+		};
+
+		/* logical OR of all results, false if there are no callbacks.
+		Stops raising at the first true. */
+		struct Any
+		{
+			bool _any = false;
+
+			bool operator()(bool r)
+			{
+				_any = r;
+				return !r;
+			}
+
+			bool result() const { return _any; }
+		};
+
+		/* writes results into the caller-supplied @dst, the result is
+		the written prefix of @dst. Stops raising when @dst is full,
+		the result of a callback that finds @dst full is dropped. */
+		template<typename R>
+		struct IntoSpan
+		{
+			std::span<R> _dst;
+			std::size_t _written = 0;
+
+			explicit IntoSpan(std::span<R> dst) : _dst(dst) {}
+
+			bool operator()(R&& r)
+			{
+				if (_written == _dst.size())
+					return false;
+
+				_dst[_written++] = std::move(r);
+				return _written != _dst.size();
+			}
+
+			std::span<R> result() const { return _dst.first(_written); }
+		};
+	}
+
+	/* Reducers merge the arguments of a raise posted to CoalescingEvent into
+	the pending ones. A reducer is called as reducer(pending..., args...),
+	where pending are references to the stored arguments of the pending
+	notification and args are the arguments of CoalescingEvent::post(...).
+	Any callable of this form is a reducer, e.g. one that accumulates deltas:
+
+	auto sum = [](int& pending, int delta) { pending += delta; };
+	CoalescingEvent<void(int), decltype(sum)> moved(sum);
+	*/
+	namespace reducers
+	{
+		//the arguments of the latest raise replace the pending ones
+		struct Latest {};
+	}
 
 	namespace internal
 	{
@@ -82,12 +354,47 @@ namespace CallMe
 		constexpr static SubscriptionIndex InvalidSubscriptionIndex = -1;
 		#endif
 
-		template<typename>
-		class SubscriptionRecord;
-
 		//non-owning pointer
 		#define viewptr *
 
+		class ErasedEvent;
+
+		/* Access to the internals of Subscription for events. The functions
+		are defined after Subscription, so that events can use them before
+		Subscription is complete */
+		struct SubscriptionAccess
+		{
+			static SubscriptionIndex index(const Subscription viewptr subscription);
+			static void setIndex(Subscription viewptr subscription, SubscriptionIndex index);
+			static ErasedEvent viewptr event(const Subscription viewptr subscription);
+			static void setEvent(Subscription viewptr subscription, ErasedEvent viewptr event);
+			static void releaseOwnership(Subscription viewptr subscription);
+		};
+
+		/* The owners of the records of an event, the regular ones followed by
+		the pending ones, see SubscriptionRecords. Lets containers of
+		subscriptions change the owners of many records without a virtual
+		call per record. Empty for events that don't expose their owners,
+		e.g. a ControlBlock after its Event is destroyed or events shared
+		between threads, their owners are changed with changeOwner(...). */
+		struct OwnerTable
+		{
+			Subscription viewptr viewptr owners = nullptr;
+			SubscriptionIndex size = 0;
+			Subscription viewptr viewptr pendingOwners = nullptr;
+
+			[[nodiscard]] bool empty() const
+			{
+				return owners == nullptr && pendingOwners == nullptr;
+			}
+
+			Subscription viewptr& operator[](SubscriptionIndex i) const
+			{
+				assert(!empty() && 0 <= i);
+				return i < size ? owners[i] : pendingOwners[i - size];
+			}
+		};
+
 		//Signature-erased event interface for Subscription
 		class ErasedEvent
 		{
@@ -95,7 +402,13 @@ namespace CallMe
 			virtual ~ErasedEvent() = default;
 
 			virtual void unsubscribe(SubscriptionIndex toRemove) = 0;
+			virtual void unsubscribeMany(std::span<const SubscriptionIndex> toRemove) = 0;
 			virtual void changeOwner(SubscriptionIndex toChange, Subscription viewptr newOwner) = 0;
+
+			/* valid until the event adds or removes records, the caller
+			validates the event after changing the owners */
+			virtual OwnerTable ownerTable() = 0;
+
 			virtual void moveDelegate(SubscriptionIndex from, SubscriptionIndex to) = 0;
 
 		#ifdef NDEBUG
@@ -105,577 +418,2928 @@ namespace CallMe
 		#endif
 		};
 
-		/* In this internal version of Event, ExpectedSubscriptions has
-		no default value and goes first in template parameters. This allows
-		decomposing the signature, which enables better compiler errors
-		for calls of .raise(...) with invalid arguments */
-		template<unsigned ExpectedSubscriptions, typename Signature>
-		class Event;
+		/* The slot table of an Event with EventStorage::SlotMap, shared by
+		the Event and its SlotSubscriptions, see SlotSubscription.
 
-		template<unsigned ExpectedSubscriptions, typename R, typename...ClassArgs>
-		class Event<ExpectedSubscriptions, R(ClassArgs...)> : public ErasedEvent
+		A used slot holds the index of its record in the Event, a free slot
+		holds the next free slot. The generation of a slot is incremented
+		whenever the slot is freed, which invalidates all handles to it.
+		Slot 0 is never used, so that slot 0 means "no owner". */
+		class SlotTable
 		{
-			static_assert(std::same_as<R, void>, "only void return types are supported");
+		public:
+			struct Slot
+			{
+				SubscriptionIndex _index;
+				std::uint32_t _generation;
+			};
 
-			using Signature = R(ClassArgs...);
+			std::vector<Slot> _slots{ Slot{0, 0} };
+			std::uint32_t _freeSlot = 0;
 
-			using DelegateT = Delegate<Signature>;
-			
-			using SubscriptionRecordT = SubscriptionRecord<Signature>;
-			
-		#ifdef USE_SMALL_VECTOR
-			using VectorT = gch::small_vector<SubscriptionRecordT, ExpectedSubscriptions>;
-		#else
-			using VectorT = std::vector<SubscriptionRecordT>;
-		#endif
+			//nullptr after the Event is destroyed
+			ErasedEvent viewptr _event;
 
-			VectorT _records;
+			//the Event and the attached SlotSubscriptions
+			std::size_t _references = 1;
 
-		#ifdef NDEBUG
-			//empty impl in base
-		#else
-			void validate() override
+			explicit SlotTable(ErasedEvent viewptr event) :
+				_event(event)
+			{
+			}
+
+			//returns a slot that refers to the record @index
+			std::uint32_t acquire(SubscriptionIndex index)
 			{
-				for(SubscriptionRecordT& r : _records)
+				std::uint32_t slot = _freeSlot;
+				if (slot != 0)
+				{
+					_freeSlot = std::uint32_t(_slots[slot]._index);
+					_slots[slot]._index = index;
+				}
+				else
 				{
-					assert(r._owner != nullptr);
-					assert(r._owner->_event == this);
-					assert(r._owner->_index < std::ssize(_records));
-					assert(&_records[r._owner->_index] == &r);
+					slot = std::uint32_t(_slots.size());
+					_slots.push_back({index, 0});
 				}
+				return slot;
 			}
-		#endif
 
-			void unsubscribe(SubscriptionIndex toRemove) override
+			void release(std::uint32_t slot)
 			{
-				assert(!_records.empty());
-				assert(0 <= toRemove && toRemove < std::ssize(_records));
-			
-				_records[toRemove] = std::move(_records.back());
-				_records[toRemove]._owner->_index = toRemove;
-
-				_records.pop_back();
-
-				validate();
+				assert(slot != 0);
+				++_slots[slot]._generation;
+				_slots[slot]._index = _freeSlot;
+				_freeSlot = slot;
 			}
 
-			void moveDelegate(SubscriptionIndex from, SubscriptionIndex to) override
+			//true IFF the handle {@slot, @generation} refers to a record of the Event
+			[[nodiscard]] bool isLive(std::uint32_t slot, std::uint32_t generation) const
 			{
-				assert(0 <= from && from < std::ssize(_records));
-				assert(0 <= to && to < std::ssize(_records));
-
-				_records[to]._delegate = std::move(_records[from]._delegate);
+				return _event != nullptr && _slots[slot]._generation == generation;
 			}
 
-			void changeOwner(SubscriptionIndex toChange, Subscription viewptr newOwner) override
+			void addReference()
 			{
-				assert(0 <= toChange && toChange < std::ssize(_records));
-
-				_records[toChange].changeOwner(newOwner);
+				++_references;
+			}
 
-				validate();
+			static void removeReference(SlotTable viewptr table)
+			{
+				if (--table->_references == 0)
+					delete table;
 			}
+		};
 
+		/* The control block of an Event with EventStorage::ControlBlock,
+		shared by the Event and its Subscriptions, which see the control
+		block as their event. The control block forwards to the Event while
+		the Event is alive and does nothing after it is destroyed, so that
+		the Event is never accessed through stale Subscriptions. */
+		class ControlBlock : public ErasedEvent
+		{
 		public:
-			Event(const Event& other) = delete;
-			Event& operator=(const Event& other) = delete;
+			//nullptr after the Event is destroyed
+			ErasedEvent viewptr _event;
 
-			Event(Event&& other) noexcept :
-				_records(std::move(other._records))
+			//the Event and the attached Subscriptions
+			std::size_t _references = 1;
+
+			explicit ControlBlock(ErasedEvent viewptr event) :
+				_event(event)
 			{
-				other._records.clear();
+			}
 
-				//update pointers to Event in subscriptions
-				for (std::ptrdiff_t i = 0; i!=std::ssize(_records); ++i)
-					_records[i].changeEvent(this);
+			void addReference()
+			{
+				++_references;
 			}
 
-			Event& operator=(Event&& other) noexcept
+			static void removeReference(ControlBlock viewptr block, std::size_t n = 1)
 			{
-				if (this == &other)
-					return *this;
+				assert(block->_references >= n);
+				if ((block->_references -= n) == 0)
+					delete block;
+			}
 
-				//existing subscriptions release ownership
-				//as _records is about to be overwritten
-				for (std::ptrdiff_t i = 0; i!=std::ssize(_records); ++i)
-					_records[i].releaseOwnership();
+			//every Subscription unsubscribes once, which ends its reference
+			void unsubscribe(SubscriptionIndex toRemove) override
+			{
+				if (_event != nullptr)
+					_event->unsubscribe(toRemove);
+				removeReference(this);
+			}
 
-				_records = std::move(other._records);
-				other._records.clear();
+			void unsubscribeMany(std::span<const SubscriptionIndex> toRemove) override
+			{
+				if (_event != nullptr)
+					_event->unsubscribeMany(toRemove);
+				removeReference(this, toRemove.size());
+			}
 
-				//update pointers to Event in subscriptions
-				for (std::ptrdiff_t i = 0; i!=std::ssize(_records); ++i)
-					_records[i].changeEvent(this);
+			void changeOwner(SubscriptionIndex toChange, Subscription viewptr newOwner) override
+			{
+				if (_event != nullptr)
+					_event->changeOwner(toChange, newOwner);
+			}
 
-				return *this;
+			OwnerTable ownerTable() override
+			{
+				return _event != nullptr ? _event->ownerTable() : OwnerTable{};
 			}
 
-			explicit Event()
+			void moveDelegate(SubscriptionIndex from, SubscriptionIndex to) override
 			{
-				#ifndef USE_SMALL_VECTOR
-				//for std::vector, reserve ExpectedSubscriptions on the heap
-				reserve(ExpectedSubscriptions);
-				#endif
+				if (_event != nullptr)
+					_event->moveDelegate(from, to);
 			}
 
-			explicit Event(unsigned expectedSubscriptions)
+		#ifndef NDEBUG
+			void validate() override
 			{
-				reserve(expectedSubscriptions);
+				if (_event != nullptr)
+					_event->validate();
 			}
+		#endif
+		};
 
-			/* Reserve space for @expectedSubscriptions anticipated subscriptions.
+		/* Vector-like container of subscription records, used by events
+		with different kinds of callbacks.
+
+		The records are stored in the structure-of-arrays layout:
+		_callbacks[i] is invoked when the event is raised, _owners[i] is
+		the owner of the i-th record: the Subscription for
+		EventStorage::BackPointers or the slot in _shared for
+		EventStorage::SlotMap. For DispatchOrder::Priority,
+		_priorities[i] is the priority of the i-th record. All vectors always
+		have the same size and all operations keep them in sync.
+
+		Callbacks are allowed to subscribe and unsubscribe while the event
+		is being raised. During dispatch, the records never move:
+		* unsubscribed records are replaced with tombstones, i.e. default
+		  constructed callbacks without owners;
+		* new records are appended to the pending vectors, a pending record
+		  with index i in the pending vectors has SubscriptionIndex
+		  _callbacks.size() + i.
+		The records are compacted after the outermost dispatch returns.
+
+		For the orders that preserve the order of subscription (Fifo and
+		Priority), unsubscription always leaves a tombstone, tombstones are
+		compacted lazily, see unsubscribe(...). */
+		template<typename Callback, unsigned ExpectedSubscriptions,
+			DispatchOrder Order = DispatchOrder::Unspecified,
+			EventStorage Storage = EventStorage::BackPointers>
+		class SubscriptionRecords : public ErasedEvent
+		{
+			template<typename T>
+		#ifdef USE_SMALL_VECTOR
+			using VectorT = gch::small_vector<T, ExpectedSubscriptions>;
+		#else
+			using VectorT = std::vector<T>;
+		#endif
 
-			If less than @ExpectedSubscriptions[the Event class template parameter]
-			subscriptions are anticipated, they are all saved inline
-			(small buffer optimization) in the Event itself and there is no need
-			to call this function.
+			//records never swap places on unsubscription
+			constexpr static bool StableOrder =
+				Order == DispatchOrder::Fifo || Order == DispatchOrder::Priority;
 
-			When the number of subscriptions exceeds @ExpectedSubscriptions, that
-			triggers reallocation and the subscriptions are moved from Event's
-			inline storage to the heap.
+			constexpr static bool Prioritized = Order == DispatchOrder::Priority;
 
-			Call .reserve(...) when @expectedSubscriptions > @ExpectedSubscriptions
-			in order to allocate enough memory on the heap and avoid reallocation
-			during upcoming .subscribe(...) calls.
+			struct NoPriorities {};
 
-			In most cases, you should not call .reserve(...). Instead, just specify
-			proper @ExpectedSubscriptions. In real projects, most events have a few
-			subscriptions, so having them inline is highly preferred.
+			//priorities are stored only for DispatchOrder::Priority
+			template<typename Vector>
+			using PrioritiesT = std::conditional_t<Prioritized, Vector, NoPriorities>;
 
-			Sometimes specifying large enough @ExpectedSubscriptions is not an option.
-			For example, if Event is stack-allocated and you anticipate large number
-			of subscriptions for that Event, allocating them inline in the Event can
-			cause stack overflow. In such cases leave @ExpectedSubscriptions at its
-			default low value or set to 0 and preallocate enough heap memory with
-			.reserve(...) */
-			void reserve(unsigned expectedSubscriptions)
-			{
-				_records.reserve(expectedSubscriptions);
-			}
+		protected:
+			constexpr static bool SlotOwned = Storage == EventStorage::SlotMap;
 
-			/* Quickly unsubscribe everyone in bypass of the standard
-			unsubscription mechanism provided by ~Subscription().
-			It is NOT necessary to call this in 99% of cases.
+			constexpr static bool Controlled = Storage == EventStorage::ControlBlock;
 
-			One use case is:
-			1. You anticipate many subscriptions to the event
-			2. The event outlives the subscriptions
-			3. There is bulk destruction of the subscriptions right
-				before the event itself is destroyed anyway
+			//shared by the Event and its subscriptions
+			using SharedT = std::conditional_t<SlotOwned, SlotTable, ControlBlock>;
 
-			Such conditions can be encountered at program shutdown
-			or when unloading [large] object graphs. This function
-			allows to speed up the shutdown/unloading of such object
-			graphs with "heavy" events.
+			using OwnerT = std::conditional_t<SlotOwned, std::uint32_t, Subscription viewptr>;
 
-			An alternative shutdown optimization for heavy events is
-			to make sure they don't outlive their subscriptions.
+			//the owner of unowned records and tombstones
+			constexpr static OwnerT NoOwner{};
 
-			NDEBUG complexity: O(Event::count()) */
-			void clear()
-			{
-				for (std::ptrdiff_t i = 0; i!=std::ssize(_records); ++i)
-					_records[i].releaseOwnership();
+			VectorT<Callback> _callbacks;
+			VectorT<OwnerT> _owners;
+			[[no_unique_address]] PrioritiesT<VectorT<int>> _priorities;
 
-				_records.clear();
-			}
+			//records subscribed during dispatch
+			std::vector<Callback> _pendingCallbacks;
+			std::vector<OwnerT> _pendingOwners;
+			[[no_unique_address]] PrioritiesT<std::vector<int>> _pendingPriorities;
 
-			/* Subscriptions are allowed to outlive the Event.
+			/* EventStorage::SlotMap and ControlBlock only, allocated on
+			the first subscription */
+			SharedT viewptr _shared = nullptr;
 
-			NDEBUG complexity: O(Event::count()) */
-			~Event() override
+			//the number of nested raise(...) calls currently running
+			unsigned _dispatchDepth = 0;
+
+			//the number of tombstones in both regular and pending records
+			std::ptrdiff_t _tombstones = 0;
+
+			//true IFF there are tombstones or pending records to compact
+			bool _deferred = false;
+
+			/* false if records were added/removed since the latest reorder(...),
+			for DispatchOrder::Priority - false if the records may be out of
+			priority order */
+			bool _ordered = true;
+
+		#ifndef NDEBUG
+			//true while validate() is postponed by BulkScope
+			bool _bulk = false;
+		#endif
+
+			//marks the scope of raise(...), the records don't move within it
+			class DispatchScope
 			{
-				clear();
-			}
+				SubscriptionRecords& _records;
+			public:
+				explicit DispatchScope(SubscriptionRecords& records) noexcept :
+					_records(records)
+				{
+					++_records._dispatchDepth;
+				}
 
-			/* Notify all subscribers, i.e., invoke all their callbacks and pass
-			 them the given arguments @args.
+				~DispatchScope()
+				{
+					--_records._dispatchDepth;
+				}
 
-			The order of invocation of subscribed callbacks relative to each other
-			is unspecified.
+				DispatchScope(const DispatchScope&) = delete;
+				DispatchScope& operator=(const DispatchScope&) = delete;
+			};
 
-			NDEBUG complexity: O(Event::count())
-			*/
-			MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
-			void raise(ClassArgs...args)
+			/* marks the scope of a bulk operation, validate() is postponed until
+			the end of the scope, when all records are consistent again */
+			class BulkScope
 			{
-				for (std::ptrdiff_t i = 0; i!=std::ssize(_records); ++i)
-					_records[i]._delegate.invoke(std::forward<ClassArgs>(args)...);
+			#ifndef NDEBUG
+				SubscriptionRecords& _records;
+			public:
+				explicit BulkScope(SubscriptionRecords& records) noexcept :
+					_records(records)
+				{
+					_records._bulk = true;
+				}
 
-				/*for(std::ptrdiff_t i = 0; i<std::ssize(_records); ++i)
-					_records[i]._delegate.invoke(std::forward<Args>(args)...);*/
+				~BulkScope()
+				{
+					_records._bulk = false;
+					_records.validate();
+				}
+			#else
+			public:
+				explicit BulkScope(SubscriptionRecords&) noexcept {}
+			#endif
 
-				/*for(std::ptrdiff_t i = std::ssize(_records)-1; i>=0; --i)
-					_records[i]._delegate.invoke(std::forward<Args>(args)...);*/
+				BulkScope(const BulkScope&) = delete;
+				BulkScope& operator=(const BulkScope&) = delete;
+			};
 
-				/*for(SubscriptionRecordT& r : _records)
-					r._delegate.invoke(std::forward<Args>(args)...);*/
+			//the number of regular and pending records, including tombstones
+			[[nodiscard]] std::ptrdiff_t size() const
+			{
+				return std::ssize(_callbacks) + std::ssize(_pendingCallbacks);
 			}
-			MSVC_SUPPRESS_WARNING_POP
 
-			// the same as .raise(...)
-			void operator()(ClassArgs...args)
+			Callback& callbackAt(SubscriptionIndex i)
 			{
-				raise(std::forward<ClassArgs>(args)...);
+				assert(0 <= i && i < size());
+				return i < std::ssize(_callbacks) ?
+					_callbacks[i] : _pendingCallbacks[i - std::ssize(_callbacks)];
 			}
 
-			/* Subscribe @callback to the Event.
-
-			The function returns a Subscription object. Keep this object alive
-			for as long as you need @callback to be subscribed. Subscriptions
-			are allowed to outlive the Event.
+			OwnerT& ownerAt(SubscriptionIndex i)
+			{
+				assert(0 <= i && i < size());
+				return i < std::ssize(_owners) ?
+					_owners[i] : _pendingOwners[i - std::ssize(_owners)];
+			}
 
-			@callback is of type CallMe::Delegate<...>. Use constructors of
-			CallMe::Delegate<...> or delegate factories to make @callback,
-			see unit tests for examples.
+			int& priorityAt(SubscriptionIndex i) requires Prioritized
+			{
+				assert(0 <= i && i < size());
+				return i < std::ssize(_priorities) ?
+					_priorities[i] : _pendingPriorities[i - std::ssize(_priorities)];
+			}
+
+			//tells @owner the new @index of its record
+			void setIndex(OwnerT owner, SubscriptionIndex index)
+			{
+				if constexpr (SlotOwned)
+					_shared->_slots[owner]._index = index;
+				else
+					SubscriptionAccess::setIndex(owner, index);
+			}
+
+			//frees the slot of the record @i, slots of removed records are reused
+			void releaseSlot(SubscriptionIndex i)
+			{
+				if constexpr (SlotOwned)
+					_shared->release(ownerAt(i));
+			}
+
+			/* EventStorage::SlotMap: makes the slot table own the record @i,
+			returns the slot and its generation for a new SlotSubscription */
+			std::pair<std::uint32_t, std::uint32_t> adopt(SubscriptionIndex i) requires SlotOwned
+			{
+				if (_shared == nullptr)
+					_shared = new SlotTable(this);
+
+				const std::uint32_t slot = _shared->acquire(i);
+				ownerAt(i) = slot;
+				_shared->addReference();
+				return { slot, _shared->_slots[slot]._generation };
+			}
+
+			/* EventStorage::ControlBlock: returns the control block as the event
+			of a new Subscription */
+			ErasedEvent viewptr attach() requires Controlled
+			{
+				if (_shared == nullptr)
+					_shared = new ControlBlock(this);
+
+				_shared->addReference();
+				return _shared;
+			}
+
+			//the event that Subscriptions point to
+			ErasedEvent viewptr owningEvent()
+			{
+				if constexpr (Controlled)
+					return _shared;
+				else
+					return this;
+			}
+
+			/* EventStorage::SlotMap and ControlBlock: all existing subscriptions
+			become stale, the next subscription allocates a new _shared.
+			NDEBUG complexity: O(1) */
+			void detachShared() requires (Storage != EventStorage::BackPointers)
+			{
+				if (_shared == nullptr)
+					return;
+
+				_shared->_event = nullptr;
+				SharedT::removeReference(_shared);
+				_shared = nullptr;
+			}
+
+			//appends a regular record
+			void append(Callback&& callback, OwnerT owner, int priority)
+			{
+				_callbacks.emplace_back(std::move(callback));
+				_owners.emplace_back(owner);
+
+				if constexpr (Prioritized)
+				{
+					if (!_priorities.empty() && _priorities.back() < priority)
+						_ordered = false;
+					_priorities.emplace_back(priority);
+				}
+				else
+					_ordered = false;
+			}
+
+			//moves regular record @from to @to, overwriting the latter
+			void moveRecord(SubscriptionIndex from, SubscriptionIndex to)
+			{
+				_callbacks[to] = std::move(_callbacks[from]);
+				_owners[to] = _owners[from];
+
+				if constexpr (Prioritized)
+					_priorities[to] = _priorities[from];
+			}
+
+			//erases regular records starting from @first
+			void truncate(SubscriptionIndex first)
+			{
+				_callbacks.erase(_callbacks.begin() + first, _callbacks.end());
+				_owners.erase(_owners.begin() + first, _owners.end());
+
+				if constexpr (Prioritized)
+					_priorities.erase(_priorities.begin() + first, _priorities.end());
+			}
+
+			/* appends a record that is not owned yet, returns its index.
+			@priority is ignored unless Order is DispatchOrder::Priority */
+			SubscriptionIndex add(Callback&& callback, int priority = 0)
+			{
+				if (_dispatchDepth != 0)
+				{
+					_pendingCallbacks.emplace_back(std::move(callback));
+					_pendingOwners.emplace_back(NoOwner);
+
+					if constexpr (Prioritized)
+						_pendingPriorities.emplace_back(priority);
+
+					_deferred = true;
+					return size() - 1;
+				}
+
+				//records subscribed earlier go first
+				if (!_pendingCallbacks.empty())
+					compact();
+
+				append(std::move(callback), NoOwner, priority);
+				return std::ssize(_callbacks) - 1;
+			}
+
+			/* appends copies of @callbacks as records that are not owned yet,
+			returns the index of the first one */
+			SubscriptionIndex addMany(std::span<const Callback> callbacks)
+			{
+				if (_dispatchDepth == 0)
+				{
+					if (!_pendingCallbacks.empty())
+						compact();
+
+					const auto n = _callbacks.size() + callbacks.size();
+					_callbacks.reserve(n);
+					_owners.reserve(n);
+
+					if constexpr (Prioritized)
+						_priorities.reserve(n);
+				}
+
+				const SubscriptionIndex first = size();
+				for (const Callback& callback : callbacks)
+					add(Callback(callback));
+				return first;
+			}
+
+			/* Remove tombstones preserving the order of records, then append
+			pending records. Must not be called during dispatch.
+
+			NDEBUG complexity: O(Event::count()) */
+			void compact()
+			{
+				assert(_dispatchDepth == 0);
+
+				SubscriptionIndex to = 0;
+				for (SubscriptionIndex from = 0; from != std::ssize(_callbacks); ++from)
+				{
+					if (_owners[from] == NoOwner)
+						continue;
+
+					if (to != from)
+						moveRecord(from, to);
+					++to;
+				}
+				truncate(to);
+
+				for (std::size_t i = 0; i != _pendingCallbacks.size(); ++i)
+				{
+					if (_pendingOwners[i] == NoOwner)
+						continue;
+
+					int priority = 0;
+					if constexpr (Prioritized)
+						priority = _pendingPriorities[i];
+
+					append(std::move(_pendingCallbacks[i]), _pendingOwners[i], priority);
+				}
+				_pendingCallbacks.clear();
+				_pendingOwners.clear();
+
+				if constexpr (Prioritized)
+					_pendingPriorities.clear();
+
+				for (SubscriptionIndex i = 0; i != std::ssize(_owners); ++i)
+					setIndex(_owners[i], i);
+
+				_tombstones = 0;
+				_deferred = false;
+
+				validate();
+			}
+
+			//compacts the records unless they are being dispatched
+			void settle()
+			{
+				if (_dispatchDepth == 0)
+					compact();
+			}
+
+			/* Sort records with @less applied to their indices. All vectors are
+			permuted in place and all owning subscriptions are updated with
+			their new indices. The sort is stable for the orders that preserve
+			the order of subscription. Does nothing during dispatch.
+
+			NDEBUG complexity: O(Event::count() * log(Event::count())) */
+			template<typename Less>
+			void reorder(Less less)
+			{
+				if (_dispatchDepth != 0)
+					return;
+
+				if (_deferred)
+					compact();
+
+				std::vector<SubscriptionIndex> order(_callbacks.size());
+				std::iota(order.begin(), order.end(), SubscriptionIndex{0});
+				if constexpr (StableOrder)
+					std::stable_sort(order.begin(), order.end(), less);
+				else
+					std::sort(order.begin(), order.end(), less);
+
+				//record i receives record order[i], apply the permutation cycle by cycle
+				for (SubscriptionIndex i = 0; i != std::ssize(order); ++i)
+				{
+					if (order[i] == i)
+						continue;
+
+					Callback callback = std::move(_callbacks[i]);
+					OwnerT owner = _owners[i];
+					[[maybe_unused]] int priority = 0;
+					if constexpr (Prioritized)
+						priority = _priorities[i];
+
+					SubscriptionIndex to = i;
+					while (order[to] != i)
+					{
+						SubscriptionIndex from = order[to];
+						moveRecord(from, to);
+						order[to] = to;
+						to = from;
+					}
+					_callbacks[to] = std::move(callback);
+					_owners[to] = owner;
+					if constexpr (Prioritized)
+						_priorities[to] = priority;
+					order[to] = to;
+				}
+
+				for (SubscriptionIndex i = 0; i != std::ssize(_owners); ++i)
+					setIndex(_owners[i], i);
+
+				_ordered = true;
+
+				validate();
+			}
+
+			/* Stable sort records by descending priority.
+
+			NDEBUG complexity: O(Event::count() * log(Event::count())) */
+			void sortByPriority() requires Prioritized
+			{
+				reorder([this](SubscriptionIndex a, SubscriptionIndex b)
+				{
+					return _priorities[a] > _priorities[b];
+				});
+			}
+
+		#ifdef NDEBUG
+			//empty impl in base
+		#else
+			void validate() override
+			{
+				if (_bulk)
+					return;
+
+				assert(_callbacks.size() == _owners.size());
+				assert(_pendingCallbacks.size() == _pendingOwners.size());
+				assert(_deferred || _pendingOwners.empty());
+				if constexpr (Prioritized)
+				{
+					assert(_priorities.size() == _callbacks.size());
+					assert(_pendingPriorities.size() == _pendingCallbacks.size());
+					assert(!_ordered || std::is_sorted(_priorities.begin(), _priorities.end(),
+													   std::greater<>{}));
+				}
+				if constexpr (Storage != EventStorage::BackPointers)
+					assert(_shared == nullptr || _shared->_event == this);
+
+				for (SubscriptionIndex i = 0; i != size(); ++i)
+				{
+					if (ownerAt(i) == NoOwner)//tombstone
+					{
+						assert(_deferred);
+						continue;
+					}
+					if constexpr (SlotOwned)
+						assert(_shared->_slots[ownerAt(i)]._index == i);
+					else
+					{
+						assert(SubscriptionAccess::event(ownerAt(i)) == owningEvent());
+						assert(SubscriptionAccess::index(ownerAt(i)) == i);
+					}
+				}
+			}
+		#endif
+
+			void unsubscribe(SubscriptionIndex toRemove) override
+			{
+				assert(0 <= toRemove && toRemove < size());
+
+				releaseSlot(toRemove);
+
+				if (StableOrder || _dispatchDepth != 0 || _deferred)
+				{
+					callbackAt(toRemove) = Callback{};
+					ownerAt(toRemove) = NoOwner;
+					++_tombstones;
+					_deferred = true;
+
+					if constexpr (StableOrder)
+					{
+						/* O(1) amortized: the records are compacted at the end of
+						the next raise or once tombstones make up half of them */
+						if (2 * _tombstones <= size() && _pendingCallbacks.empty())
+						{
+							validate();
+							return;
+						}
+					}
+
+					settle();
+					return;
+				}
+
+				_callbacks[toRemove] = std::move(_callbacks.back());
+				_owners[toRemove] = _owners.back();
+				setIndex(_owners[toRemove], toRemove);
+
+				_callbacks.pop_back();
+				_owners.pop_back();
+
+				if (toRemove != std::ssize(_callbacks))
+					_ordered = false;
+
+				validate();
+			}
+
+			/* Replace the records @toRemove with tombstones, then compact once.
+			Does the same as unsubscribe(...) for each of @toRemove, but for
+			the orders that don't preserve the order of subscription, compaction
+			is cheaper than many swap-removes of records that are removed anyway.
+
+			NDEBUG complexity: O(Event::count()) */
+			void unsubscribeMany(std::span<const SubscriptionIndex> toRemove) override
+			{
+				if (toRemove.empty())
+					return;
+
+				//everyone is unsubscribed
+				if (_dispatchDepth == 0 && std::ssize(toRemove) == count())
+				{
+					clearRecords();
+					return;
+				}
+
+				for (SubscriptionIndex i : toRemove)
+				{
+					assert(0 <= i && i < size() && ownerAt(i) != NoOwner);
+					releaseSlot(i);
+					callbackAt(i) = Callback{};
+					ownerAt(i) = NoOwner;
+				}
+				_tombstones += std::ssize(toRemove);
+				_deferred = true;
+
+				if constexpr (StableOrder)
+				{
+					//the same lazy compaction as in unsubscribe(...)
+					if (2 * _tombstones <= size() && _pendingCallbacks.empty())
+					{
+						validate();
+						return;
+					}
+				}
+
+				settle();
+			}
+
+			void moveDelegate(SubscriptionIndex from, SubscriptionIndex to) override
+			{
+				callbackAt(to) = std::move(callbackAt(from));
+
+				//the delegate keeps its priority
+				if constexpr (Prioritized)
+				{
+					if (priorityAt(to) != priorityAt(from))
+					{
+						priorityAt(to) = priorityAt(from);
+						_ordered = false;
+					}
+				}
+			}
+
+			void changeOwner(SubscriptionIndex toChange, Subscription viewptr newOwner) override
+			{
+				//SlotSubscriptions never change the owners of records
+				if constexpr (SlotOwned)
+					assert(false);
+				else
+				{
+					ownerAt(toChange) = newOwner;
+
+					validate();
+				}
+			}
+
+			OwnerTable ownerTable() override
+			{
+				//SlotSubscriptions never change the owners of records
+				if constexpr (SlotOwned)
+				{
+					assert(false);
+					return {};
+				}
+				else
+					return { _owners.data(), std::ssize(_owners),
+							 _pendingOwners.empty() ? nullptr : _pendingOwners.data() };
+			}
+
+			/* update pointers to the event in all owning subscriptions,
+			EventStorage::SlotMap and ControlBlock: O(1) */
+			void changeEvent()
+			{
+				if constexpr (Storage != EventStorage::BackPointers)
+				{
+					if (_shared != nullptr)
+						_shared->_event = this;
+				}
+				else
+				{
+					for (SubscriptionIndex i = 0; i != size(); ++i)
+					{
+						if (ownerAt(i) != NoOwner)
+							SubscriptionAccess::setEvent(ownerAt(i), this);
+					}
+				}
+			}
+
+			/* existing subscriptions release ownership of all records,
+			EventStorage::SlotMap and ControlBlock: O(1) */
+			void releaseOwnership()
+			{
+				if constexpr (Storage != EventStorage::BackPointers)
+					detachShared();
+				else
+				{
+					for (SubscriptionIndex i = 0; i != size(); ++i)
+					{
+						if (ownerAt(i) != NoOwner)
+							SubscriptionAccess::releaseOwnership(ownerAt(i));
+					}
+				}
+			}
+
+			//leaves no records, not even pending ones
+			void clearRecords()
+			{
+				_callbacks.clear();
+				_owners.clear();
+				_pendingCallbacks.clear();
+				_pendingOwners.clear();
+
+				if constexpr (Prioritized)
+				{
+					_priorities.clear();
+					_pendingPriorities.clear();
+				}
+
+				_tombstones = 0;
+				_deferred = false;
+				_ordered = true;
+			}
+
+			SubscriptionRecords() = default;
+
+			SubscriptionRecords(SubscriptionRecords&& other) noexcept :
+				_callbacks(std::move(other._callbacks)),
+				_owners(std::move(other._owners)),
+				_priorities(std::move(other._priorities)),
+				_pendingCallbacks(std::move(other._pendingCallbacks)),
+				_pendingOwners(std::move(other._pendingOwners)),
+				_pendingPriorities(std::move(other._pendingPriorities)),
+				_shared(std::exchange(other._shared, nullptr)),
+				_tombstones(other._tombstones),
+				_deferred(other._deferred),
+				_ordered(other._ordered)
+			{
+				assert(other._dispatchDepth == 0 && "an event cannot be moved while being raised");
+
+				other.clearRecords();
+
+				changeEvent();
+			}
+
+			SubscriptionRecords& operator=(SubscriptionRecords&& other) noexcept
+			{
+				if (this == &other)
+					return *this;
+
+				assert(_dispatchDepth == 0 && other._dispatchDepth == 0 &&
+					   "an event cannot be moved while being raised");
+
+				//_owners is about to be overwritten
+				releaseOwnership();
+
+				_callbacks = std::move(other._callbacks);
+				_owners = std::move(other._owners);
+				_priorities = std::move(other._priorities);
+				_pendingCallbacks = std::move(other._pendingCallbacks);
+				_pendingOwners = std::move(other._pendingOwners);
+				_pendingPriorities = std::move(other._pendingPriorities);
+				_shared = std::exchange(other._shared, nullptr);
+				_tombstones = other._tombstones;
+				_deferred = other._deferred;
+				_ordered = other._ordered;
+				other.clearRecords();
+
+				changeEvent();
+
+				return *this;
+			}
+
+		public:
+			SubscriptionRecords(const SubscriptionRecords& other) = delete;
+			SubscriptionRecords& operator=(const SubscriptionRecords& other) = delete;
+
+			/* Subscriptions are allowed to outlive the Event.
+			The Event must not be destroyed while it is being raised.
+
+			NDEBUG complexity: O(Event::count()),
+			EventStorage::SlotMap and ControlBlock: O(1) */
+			~SubscriptionRecords() override
+			{
+				if constexpr (Storage != EventStorage::BackPointers)
+					detachShared();
+				else
+					clear();
+			}
+
+			/* Reserve space for @expectedSubscriptions anticipated subscriptions.
+
+			If less than @ExpectedSubscriptions[the Event class template parameter]
+			subscriptions are anticipated, they are all saved inline
+			(small buffer optimization) in the Event itself and there is no need
+			to call this function.
+
+			When the number of subscriptions exceeds @ExpectedSubscriptions, that
+			triggers reallocation and the subscriptions are moved from Event's
+			inline storage to the heap.
+
+			Call .reserve(...) when @expectedSubscriptions > @ExpectedSubscriptions
+			in order to allocate enough memory on the heap and avoid reallocation
+			during upcoming .subscribe(...) calls.
+
+			In most cases, you should not call .reserve(...). Instead, just specify
+			proper @ExpectedSubscriptions. In real projects, most events have a few
+			subscriptions, so having them inline is highly preferred.
+
+			Sometimes specifying large enough @ExpectedSubscriptions is not an option.
+			For example, if Event is stack-allocated and you anticipate large number
+			of subscriptions for that Event, allocating them inline in the Event can
+			cause stack overflow. In such cases leave @ExpectedSubscriptions at its
+			default low value or set to 0 and preallocate enough heap memory with
+			.reserve(...) */
+			void reserve(unsigned expectedSubscriptions)
+			{
+				//the records must not move during dispatch
+				if (_dispatchDepth != 0)
+					return;
+
+				_callbacks.reserve(expectedSubscriptions);
+				_owners.reserve(expectedSubscriptions);
+
+				if constexpr (Prioritized)
+					_priorities.reserve(expectedSubscriptions);
+
+				if constexpr (SlotOwned)
+				{
+					if (_shared == nullptr)
+						_shared = new SlotTable(this);
+					_shared->_slots.reserve(expectedSubscriptions + 1);
+				}
+			}
+
+			/* Quickly unsubscribe everyone in bypass of the standard
+			unsubscription mechanism provided by ~Subscription().
+			It is NOT necessary to call this in 99% of cases.
+
+			One use case is:
+			1. You anticipate many subscriptions to the event
+			2. The event outlives the subscriptions
+			3. There is bulk destruction of the subscriptions right
+				before the event itself is destroyed anyway
+
+			Such conditions can be encountered at program shutdown
+			or when unloading [large] object graphs. This function
+			allows to speed up the shutdown/unloading of such object
+			graphs with "heavy" events.
+
+			An alternative shutdown optimization for heavy events is
+			to make sure they don't outlive their subscriptions.
+
+			If called while the event is being raised, the remaining callbacks
+			of the ongoing dispatch are not invoked.
+
+			NDEBUG complexity: O(Event::count()) */
+			void clear()
+			{
+				releaseOwnership();
+
+				if (_dispatchDepth != 0)
+				{
+					for (SubscriptionIndex i = 0; i != size(); ++i)
+					{
+						callbackAt(i) = Callback{};
+						ownerAt(i) = NoOwner;
+					}
+					_tombstones = size();
+					_deferred = true;
+					return;
+				}
+
+				clearRecords();
+			}
+
+			// the number of current subscriptions 
+			[[nodiscard]] std::ptrdiff_t count() const
+			{
+				return size() - _tombstones;
+			}
+
+			// true IFF there are currently no subscriptions
+			[[nodiscard]] bool empty() const
+			{
+				return count() == 0;
+			}
+		};
+
+		/* In this internal version of Event, ExpectedSubscriptions has
+		no default value and goes first in template parameters. This allows
+		decomposing the signature, which enables better compiler errors
+		for calls of .raise(...) with invalid arguments */
+		template<unsigned ExpectedSubscriptions, DispatchOrder Order,
+			EventStorage Storage, typename Signature>
+		class Event;
+
+		template<unsigned ExpectedSubscriptions, DispatchOrder Order,
+			EventStorage Storage, typename R, typename...ClassArgs>
+		class Event<ExpectedSubscriptions, Order, Storage, R(ClassArgs...)> :
+			public SubscriptionRecords<Delegate<R(ClassArgs...)>, ExpectedSubscriptions, Order, Storage>
+		{
+			using Signature = R(ClassArgs...);
+
+			using DelegateT = Delegate<Signature>;
+
+			using RecordsT = SubscriptionRecords<DelegateT, ExpectedSubscriptions, Order, Storage>;
+
+			using SubscriptionT = std::conditional_t<Storage == EventStorage::SlotMap,
+													 SlotSubscription, Subscription>;
+
+			using InvokerT = PErasedInvoker<R, ClassArgs...>;
+
+			using BatchInvokerT = PErasedBatchInvoker<DelegateT, ClassArgs...>;
+
+			struct BatchInvokerRecord
+			{
+				InvokerT _invoker;
+				BatchInvokerT _batchInvoker;
+			};
+
+			//batch invokers of all callbacks subscribed as batchable
+		#ifdef USE_SMALL_VECTOR
+			gch::small_vector<BatchInvokerRecord, 1> _batchInvokers;
+		#else
+			std::vector<BatchInvokerRecord> _batchInvokers;
+		#endif
+
+			BatchInvokerT findBatchInvoker(InvokerT invoker)
+			{
+				for (BatchInvokerRecord& r : _batchInvokers)
+				{
+					if (r._invoker == invoker)
+						return r._batchInvoker;
+				}
+				return nullptr;
+			}
+
+			//the owner of the new record @i
+			SubscriptionT makeSubscription(SubscriptionIndex i)
+			{
+				if constexpr (Storage == EventStorage::SlotMap)
+				{
+					const auto [slot, generation] = this->adopt(i);
+					return SlotSubscription(this->_shared, slot, generation);
+				}
+				else if constexpr (Storage == EventStorage::ControlBlock)
+					return Subscription(i, this->attach());
+				else
+					return Subscription(i, this);
+			}
+
+			//saves the owner of the new record @i in @dst
+			template<typename VectorOfSubscriptions>
+			void emplaceSubscription(VectorOfSubscriptions& dst, SubscriptionIndex i)
+			{
+				if constexpr (Storage == EventStorage::SlotMap)
+				{
+					const auto [slot, generation] = this->adopt(i);
+					dst.emplace_back(this->_shared, slot, generation);
+				}
+				else if constexpr (Storage == EventStorage::ControlBlock)
+					dst.emplace_back(i, this->attach());
+				else
+					dst.emplace_back(i, this);
+			}
+
+			template<auto Method, typename Object>
+			DelegateT makeBatchable(Object& object)
+			{
+				using MethodInvokerT = MethodInvoker<Method, Object, R, ClassArgs...>;
+
+				if (findBatchInvoker(MethodInvokerT::invoke) == nullptr)
+				{
+					_batchInvokers.push_back({ MethodInvokerT::invoke,
+											   MethodInvokerT::template invokeBatch<DelegateT> });
+				}
+				return DelegateT(object, tag<Method>());
+			}
+
+			/* invoke runs of adjacent callbacks with the same batchable invoker
+			with one call per run, the rest one by one */
+			MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
+			void raiseBatched(ClassArgs...args)
+			{
+				bool batched = false;
+				DelegateT* d = this->_callbacks.data();
+				DelegateT* end = d + this->_callbacks.size();
+				while (d != end)
+				{
+					BatchInvokerT batchInvoker = findBatchInvoker(d->invoker());
+					if (batchInvoker == nullptr)
+					{
+						d->invoke(std::forward<ClassArgs>(args)...);
+						++d;
+					}
+					else
+					{
+						d += batchInvoker(d, end, std::forward<ClassArgs>(args)...);
+						batched = true;
+					}
+				}
+
+				/* the batchable callbacks are gone, so the next .raise(...) takes
+				the plain loop. Records subscribed during the dispatch may be
+				batchable, they are not among the callbacks yet */
+				if (!batched && this->_pendingCallbacks.empty())
+					_batchInvokers.clear();
+			}
+			MSVC_SUPPRESS_WARNING_POP
+
+			/* invoke the callbacks [@first, @last), runs of adjacent batchable
+			callbacks with one call per run, see raiseBatched(...) */
+			void invokeRange(std::ptrdiff_t first, std::ptrdiff_t last,
+							 const std::remove_reference_t<ClassArgs>&...args)
+			{
+				DelegateT* d = this->_callbacks.data() + first;
+				DelegateT* end = this->_callbacks.data() + last;
+				if (_batchInvokers.empty())
+				{
+					for (; d != end; ++d)
+						d->invoke(args...);
+					return;
+				}
+
+				while (d != end)
+				{
+					BatchInvokerT batchInvoker = findBatchInvoker(d->invoker());
+					if (batchInvoker == nullptr)
+					{
+						d->invoke(args...);
+						++d;
+					}
+					else
+						d += batchInvoker(d, end, args...);
+				}
+			}
+
+			/* invoke callbacks in dispatch order, skipping tombstones, until @stop
+			returns true for the result of a callback. Returns std::nullopt if all
+			callbacks were invoked, otherwise the owner of the last invoked record */
+			MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
+			template<typename Stop>
+			std::optional<const Subscription viewptr> invokeUntil(Stop&& stop, ClassArgs...args)
+			{
+				restoreOrder();
+
+				std::optional<const Subscription viewptr> stoppedBy;
+				{
+					typename RecordsT::DispatchScope scope(*this);
+
+					for (std::ptrdiff_t i = 0; i != std::ssize(this->_callbacks); ++i)
+					{
+						DelegateT& callback = this->_callbacks[i];
+
+						//tombstones have no results
+						if (callback.invoker() == &NullInvoke<R, ClassArgs...>) [[unlikely]]
+							continue;
+
+						if (stop(callback.invoke(std::forward<ClassArgs>(args)...)))
+						{
+							//the records of SlotMap own no Subscriptions, see raiseUntil(...)
+							if constexpr (Storage == EventStorage::SlotMap)
+								stoppedBy = nullptr;
+							else//read before the records are compacted
+								stoppedBy = this->_owners[i];
+							break;
+						}
+					}
+				}
+
+				if (this->_deferred) [[unlikely]]
+					this->settle();
+
+				return stoppedBy;
+			}
+			MSVC_SUPPRESS_WARNING_POP
+
+		protected:
+			//restores the order of records required by Order before dispatch
+			void restoreOrder()
+			{
+				if constexpr (Order == DispatchOrder::Grouped)
+				{
+					if (!this->_ordered) [[unlikely]]
+						optimizeOrder();
+				}
+				else if constexpr (Order == DispatchOrder::Priority)
+				{
+					if (!this->_ordered) [[unlikely]]
+						this->sortByPriority();
+				}
+			}
+
+		public:
+			Event(Event&& other) noexcept = default;
+			Event& operator=(Event&& other) noexcept = default;
+
+			explicit Event()
+			{
+				#ifndef USE_SMALL_VECTOR
+				//for std::vector, reserve ExpectedSubscriptions on the heap
+				this->reserve(ExpectedSubscriptions);
+				#endif
+			}
+
+			explicit Event(unsigned expectedSubscriptions)
+			{
+				this->reserve(expectedSubscriptions);
+			}
+
+			/* see SubscriptionRecords::clear(), the batch invokers are
+			forgotten too */
+			void clear()
+			{
+				RecordsT::clear();
+				_batchInvokers.clear();
+			}
+
+			/* Notify all subscribers, i.e., invoke all their callbacks and pass
+			 them the given arguments @args. For non-void R, the results of
+			 the callbacks are discarded, see .collect(...).
+
+			The order of invocation of subscribed callbacks relative to each other
+			is defined by @Order, see DispatchOrder.
+
+			Only the hot array of callbacks is read, i.e. 2 pointers per
+			subscription.
+
+			Callbacks may subscribe and unsubscribe (including themselves) and
+			raise the event recursively. Callbacks unsubscribed during the
+			dispatch are not invoked anymore, callbacks subscribed during the
+			dispatch are invoked starting from the next .raise(...).
+
+			NDEBUG complexity: O(Event::count()), plus .optimizeOrder() for
+			DispatchOrder::Grouped if subscriptions changed since the previous raise,
+			plus O(Event::count() * log(Event::count())) for DispatchOrder::Priority
+			if subscriptions came out of priority order since the previous raise,
+			plus O(Event::count()) if subscriptions changed during this raise or
+			since the previous raise for DispatchOrder::Fifo and Priority
+			*/
+			MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
+			void raise(ClassArgs...args)
+			{
+				restoreOrder();
+
+				{
+					typename RecordsT::DispatchScope scope(*this);
+
+					if (!_batchInvokers.empty())
+						raiseBatched(std::forward<ClassArgs>(args)...);
+					else
+					{
+						for (std::ptrdiff_t i = 0; i!=std::ssize(this->_callbacks); ++i)
+							this->_callbacks[i].invoke(std::forward<ClassArgs>(args)...);
+					}
+				}
+
+				if (this->_deferred) [[unlikely]]
+					this->settle();
+			}
+			MSVC_SUPPRESS_WARNING_POP
+
+			#define MsgRaiseParallelMutableArgs "raiseParallel(...) passes the same arguments to all threads, it requires an Event without non-const reference parameters"
+
+			/* Notify all subscribers like .raise(...) does, but invoke the
+			callbacks in chunks of @grain callbacks that run in parallel on
+			@executor, e.g. WorkStealingPool, and return once all of them
+			have returned. Prefer it for events with expensive callbacks,
+			e.g. a recomputation per subscriber.
+
+			The arguments are passed by const reference to every chunk,
+			so parameters of the Signature can't be non-const references.
+			The callbacks of different chunks run at the same time in no
+			particular order, even for DispatchOrder::Fifo and Priority, so
+			they must be safe to call concurrently with each other. They must
+			not subscribe to, unsubscribe from or raise the event.
+
+			If the event has no more callbacks than @grain, they are invoked
+			on the calling thread without touching @executor.
+
+			NDEBUG complexity: the same as .raise(...), divided among threads */
+			template<ParallelExecutor Executor>
+				requires (std::convertible_to<const std::remove_reference_t<ClassArgs>&, ClassArgs> && ...)
+			void raiseParallel(Executor& executor, ParallelGrain grain,
+							   const std::remove_reference_t<ClassArgs>&...args)
+			{
+				assert(grain.callbacks > 0);
+				restoreOrder();
+
+				{
+					typename RecordsT::DispatchScope scope(*this);
+
+					const std::ptrdiff_t count = std::ssize(this->_callbacks);
+					if (count <= grain.callbacks)
+						invokeRange(0, count, args...);
+					else
+					{
+						auto chunk = [&](std::ptrdiff_t first, std::ptrdiff_t last)
+						{
+							invokeRange(first, last, args...);
+						};
+						executor.parallelFor(count, grain.callbacks, fromFunctor(chunk));
+					}
+				}
+
+				if (this->_deferred) [[unlikely]]
+					this->settle();
+			}
+
+			//.raiseParallel(...) with the default ParallelGrain
+			template<ParallelExecutor Executor>
+				requires (std::convertible_to<const std::remove_reference_t<ClassArgs>&, ClassArgs> && ...)
+			void raiseParallel(Executor& executor, const std::remove_reference_t<ClassArgs>&...args)
+			{
+				raiseParallel(executor, ParallelGrain{}, args...);
+			}
+
+			template<typename Executor, typename...Args>
+				requires (not (std::convertible_to<const std::remove_reference_t<ClassArgs>&, ClassArgs> && ...))
+			DELETE_FUNCTION(void raiseParallel(Executor&, Args&&...), MsgRaiseParallelMutableArgs)
+
+			#define MsgCollectVoidEvent "collect(...) requires an Event with non-void return type"
+
+			/* Notify all subscribers like .raise(...) does, and fold the results of
+			their callbacks with @combiner, see ResultCombiner and the built-in
+			combiners in CallMe::combiners.
+
+			The results are passed to @combiner in the same loop that invokes the
+			callbacks, nothing is allocated. @combiner may stop raising early.
+			Batchable callbacks are invoked one by one.
+
+			Returns @combiner.result().
+
+			NDEBUG complexity: the same as .raise(...) */
+			template<typename Combiner>
+				requires (not std::same_as<R, void>) and
+						 ResultCombiner<std::remove_cvref_t<Combiner>, R>
+			auto collect(Combiner&& combiner, ClassArgs...args)
+			{
+				invokeUntil([&combiner](R&& r) { return !combiner(std::forward<R>(r)); },
+							std::forward<ClassArgs>(args)...);
+
+				return combiner.result();
+			}
+
+			template<typename Combiner>
+				requires std::same_as<R, void>
+			DELETE_FUNCTION(void collect(Combiner&&, ClassArgs...),
+							MsgCollectVoidEvent)
+
+			#define MsgRaiseUntilNonBoolEvent "raiseUntil(...)/raiseWhile(...) require an Event with bool return type"
+			#define MsgRaiseUntilSlotMap "raiseUntil(...)/raiseWhile(...) return the Subscription of the stopping callback, "\
+				"EventStorage::SlotMap has none, use collect(...) with combiners::FirstNonEmpty<bool> instead"
+
+			/* Invoke the callbacks of Event<bool(...)> like .raise(...) does, but
+			stop at the first callback that returns true, i.e. "consumes" the event.
+			The remaining callbacks are not invoked. Use DispatchOrder::Fifo or
+			Priority to define which callbacks get the event first.
+
+			Returns std::nullopt if no callback consumed the event. Otherwise returns
+			the Subscription of the consuming callback, or nullptr if that callback
+			ended its own subscription while being invoked.
+
+			NDEBUG complexity: the same as .raise(...) */
+			std::optional<const Subscription viewptr> raiseUntil(ClassArgs...args)
+				requires std::same_as<R, bool> and (Storage != EventStorage::SlotMap)
+			{
+				return invokeUntil([](bool consumed) { return consumed; },
+								   std::forward<ClassArgs>(args)...);
+			}
+
+			/* The same as .raiseUntil(...), but stops at the first callback that
+			returns false, e.g. the first failed validator in a chain of validators.
+
+			Returns std::nullopt if all callbacks returned true. Otherwise returns
+			the Subscription of the callback that returned false, or nullptr if that
+			callback ended its own subscription while being invoked. */
+			std::optional<const Subscription viewptr> raiseWhile(ClassArgs...args)
+				requires std::same_as<R, bool> and (Storage != EventStorage::SlotMap)
+			{
+				return invokeUntil([](bool proceed) { return !proceed; },
+								   std::forward<ClassArgs>(args)...);
+			}
+
+			template<typename...Args>
+				requires (not std::same_as<R, bool>)
+			DELETE_FUNCTION(void raiseUntil(Args&&...), MsgRaiseUntilNonBoolEvent)
+
+			template<typename...Args>
+				requires (not std::same_as<R, bool>)
+			DELETE_FUNCTION(void raiseWhile(Args&&...), MsgRaiseUntilNonBoolEvent)
+
+			template<typename...Args>
+				requires std::same_as<R, bool> and (Storage == EventStorage::SlotMap)
+			DELETE_FUNCTION(void raiseUntil(Args&&...), MsgRaiseUntilSlotMap)
+
+			template<typename...Args>
+				requires std::same_as<R, bool> and (Storage == EventStorage::SlotMap)
+			DELETE_FUNCTION(void raiseWhile(Args&&...), MsgRaiseUntilSlotMap)
+
+			// the same as .raise(...)
+			void operator()(ClassArgs...args)
+			{
+				raise(std::forward<ClassArgs>(args)...);
+			}
+
+			/* Reorder subscribed callbacks so that callbacks with the same
+			invoker thunk (the same kind of target: the same member function,
+			functor type or free function) are adjacent, and callbacks within
+			a group go in the order of their target addresses.
+
+			Raising a reordered event invokes the same thunk repeatedly, which
+			is friendly to indirect branch predictors, and walks the targets
+			in memory order. Subscriptions stay valid.
+
+			Call it after a burst of subscriptions/unsubscriptions, or use
+			DispatchOrder::Grouped to have it called automatically. Not available
+			for the orders that preserve the order of subscription.
+
+			NDEBUG complexity: O(Event::count() * log(Event::count())) */
+			void optimizeOrder()
+				requires (Order == DispatchOrder::Unspecified || Order == DispatchOrder::Grouped)
+			{
+				this->reorder([this](SubscriptionIndex i, SubscriptionIndex j)
+				{
+					DelegateT& a = this->_callbacks[i];
+					DelegateT& b = this->_callbacks[j];
+					if (a.invoker() != b.invoker())
+						return std::less<>{}(a.invoker(), b.invoker());
+					return std::less<>{}(a.object(), b.object());
+				});
+			}
+
+			/* Subscribe @callback to the Event.
+
+			The function returns a Subscription object. Keep this object alive
+			for as long as you need @callback to be subscribed. Subscriptions
+			are allowed to outlive the Event.
+
+			@callback is of type CallMe::Delegate<...>. Use constructors of
+			CallMe::Delegate<...> or delegate factories to make @callback,
+			see unit tests for examples.
 
 			As only non-owning delegates are accepted as @callback, make sure
 			that all referenced callable targets are alive/valid for the
 			lifetime of the returned Subscription object.
 
-			The signature of @callback must match the signature of the Event.
+			The signature of @callback must match the signature of the Event.
+
+			If @callback accepts parameters, usually it should not mutate them -
+			accepting arguments by value or by const-reference is recommended.
+			If @callback mutates its parameters, carefully think out how that
+			will interact with callbacks of other subscriptions
+			(the order of invocation of subscribed callbacks depends on @Order).
+
+			For DispatchOrder::Priority, @callback is subscribed with priority 0.
+
+			NDEBUG complexity:
+			* If Event has enough allocated space: O(1)
+			* Otherwise: reallocation + O(Event::count())
+			*/
+			[[nodiscard]] auto subscribe(DelegateT&& callback)
+			{
+				return makeSubscription(this->add(std::move(callback)));
+			}
+
+			#define MsgEventCallbackMismatch "Callback signature mismatches the signature of Event"
+
+			template<typename MismatchingSignature>
+				requires (not std::same_as<MismatchingSignature, Signature>)
+			DELETE_FUNCTION(auto subscribe(Delegate<MismatchingSignature>&&),
+							MsgEventCallbackMismatch)
+
+
+			/* Subscribe @callback to the Event, see the other overload.
+
+			The function saves a Subscription object in @dst.
+
+			Customize the type of subscription vector @dst by passing a @dst
+			of any vector-like container type such as
+			gch::small_vector<Subscription, nSubscriptions>, see unit tests
+			for examples.
+
+			NDEBUG complexity:
+			* If both Event and @dst have enough allocated space: O(1)
+			* Otherwise, up to two reallocations, whatever triggers:
+				* reallocation + O(Event::count()),
+				* reallocation + O(@dst.count())
+			*/
+			template<typename VectorOfSubscriptions = std::vector<SubscriptionT>>
+			void subscribe(DelegateT&& callback,
+						   VectorOfSubscriptions& dst)
+			{
+				emplaceSubscription(dst, this->add(std::move(callback)));
+			}
+
+			template<typename MismatchingSignature, typename VectorOfSubscriptions>
+				requires (not std::same_as<MismatchingSignature, Signature>)
+			DELETE_FUNCTION(void subscribe(Delegate<MismatchingSignature>&&, 
+										   VectorOfSubscriptions&),
+							MsgEventCallbackMismatch)
+
+			/* Subscribe @callback with @priority to an Event with
+			DispatchOrder::Priority, see the other overloads.
+
+			Callbacks with greater @priority are invoked earlier, callbacks with
+			equal @priority are invoked in the order of subscription.
+
+			NDEBUG complexity: the same as .subscribe(@callback), the records
+			are sorted lazily by the next .raise(...) */
+			[[nodiscard]] auto subscribe(DelegateT&& callback, int priority)
+				requires (Order == DispatchOrder::Priority)
+			{
+				return makeSubscription(this->add(std::move(callback), priority));
+			}
+
+			/* Subscribe @callback with @priority, see the other overload.
+			The function saves a Subscription object in @dst. */
+			template<typename VectorOfSubscriptions = std::vector<SubscriptionT>>
+				requires (Order == DispatchOrder::Priority)
+			void subscribe(DelegateT&& callback, int priority,
+						   VectorOfSubscriptions& dst)
+			{
+				emplaceSubscription(dst, this->add(std::move(callback), priority));
+			}
+
+			/* Subscribe all @callbacks to the Event. The function saves their
+			Subscription objects in @dst in the same order.
+
+			Unlike calling .subscribe(callback, @dst) for each callback, the Event
+			and @dst (if it has .reserve(...)) reserve space only once, and the
+			records are appended in one pass. Manage the subscriptions with
+			a SubscriptionGroup as @dst to unsubscribe them in bulk too.
+
+			For DispatchOrder::Priority, @callbacks are subscribed with priority 0.
+
+			NDEBUG complexity: O(@callbacks.size()), plus up to two reallocations:
+			* reallocation + O(Event::count()),
+			* reallocation + O(@dst.count())
+			*/
+			template<typename VectorOfSubscriptions = std::vector<SubscriptionT>>
+			void subscribeMany(std::span<const DelegateT> callbacks,
+							   VectorOfSubscriptions& dst)
+			{
+				if constexpr (requires { dst.reserve(dst.size()); })
+					dst.reserve(dst.size() + callbacks.size());
+
+				typename RecordsT::BulkScope bulk(*this);
+
+				const SubscriptionIndex first = this->addMany(callbacks);
+				for (std::size_t i = 0; i != callbacks.size(); ++i)
+					emplaceSubscription(dst, first + SubscriptionIndex(i));
+			}
+
+			/* Subscribe member function @Method of @object to the Event as a
+			batchable callback.
+
+			When the Event is raised, adjacent batchable callbacks of the same
+			@Method and the same class are invoked with a single indirect
+			call, that runs a loop with @Method inlined into it. Callbacks
+			become adjacent if they are subscribed one after another, see also
+			.optimizeOrder() and DispatchOrder::Grouped.
+
+			Otherwise, this is the same as .subscribe(fromMethod<@Method>(@object)).
+			The first batchable subscription of @Method makes .raise(...) check
+			for runs of callbacks, which costs a bit for events that have no
+			such runs. The check stops after .clear() or after a .raise(...)
+			that finds no run, e.g. once the batchable callbacks are ended. */
+			template<auto Method, internal::Class Object>
+				requires internal::MemberFunction<decltype(Method)> and
+						 internal::MethodMatchesClass<Method, Object>
+			[[nodiscard]] auto subscribe(Object& object)
+			{
+				return subscribe(makeBatchable<Method>(object));
+			}
+
+			/* Subscribe member function @Method of @object as a batchable callback,
+			see the other overload. The function saves a Subscription object in @dst. */
+			template<auto Method, internal::Class Object,
+				typename VectorOfSubscriptions = std::vector<SubscriptionT>>
+				requires internal::MemberFunction<decltype(Method)> and
+						 internal::MethodMatchesClass<Method, Object>
+			void subscribe(Object& object, VectorOfSubscriptions& dst)
+			{
+				subscribe(makeBatchable<Method>(object), dst);
+			}
+		};
+
+		template<unsigned ExpectedSubscriptions, DispatchOrder Order,
+			EventStorage Storage, typename Signature>
+		class EventQueue;
+
+		template<typename Reducer, unsigned ExpectedSubscriptions, DispatchOrder Order,
+			EventStorage Storage, typename Signature>
+		class CoalescingEvent;
+
+		template<unsigned ExpectedSubscriptions, DispatchOrder Order,
+			EventStorage Storage, typename R, typename...ClassArgs>
+		class EventQueue<ExpectedSubscriptions, Order, Storage, R(ClassArgs...)> :
+			public Event<ExpectedSubscriptions, Order, Storage, R(ClassArgs...)>
+		{
+			using EventT = Event<ExpectedSubscriptions, Order, Storage, R(ClassArgs...)>;
+
+			using RecordsT = SubscriptionRecords<Delegate<R(ClassArgs...)>, ExpectedSubscriptions, Order, Storage>;
+
+			//the copies of the arguments of an enqueued raise
+			using ItemT = std::tuple<std::decay_t<ClassArgs>...>;
+
+			/* Items are appended to _queued, dispatch(...) swaps it with
+			_dispatching. Both vectors are cleared without freeing, so once
+			they have grown to the largest batch, queueing doesn't allocate. */
+			std::vector<ItemT> _queued;
+			std::vector<ItemT> _dispatching;
+
+			//a queued argument as the parameter of type @Arg of a callback
+			template<typename Arg>
+			static decltype(auto) pass(std::decay_t<Arg>& arg)
+			{
+				if constexpr (std::is_rvalue_reference_v<Arg>)
+					return std::move(arg);
+				else
+					return (arg);
+			}
 
-			If @callback accepts parameters, usually it should not mutate them -
-			accepting arguments by value or by const-reference is recommended.
-			If @callback mutates its parameters, carefully think out how that
-			will interact with callbacks of other subscriptions
-			(the order of invocation of subscribed callbacks is unspecified).
+			MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
+			void dispatchSubscriberMajor()
+			{
+				this->restoreOrder();
 
-			NDEBUG complexity:
-			* If Event has enough allocated space: O(1)
-			* Otherwise: reallocation + O(Event::count())
-			*/
-			[[nodiscard]] auto subscribe(DelegateT&& callback)
+				{
+					typename RecordsT::DispatchScope scope(*this);
+
+					for (std::ptrdiff_t i = 0; i != std::ssize(this->_callbacks); ++i)
+					{
+						//re-read per item, a callback may end its subscription
+						for (ItemT& item : _dispatching)
+						{
+							std::apply([this, i](std::decay_t<ClassArgs>&...args)
+							{
+								this->_callbacks[i].invoke(pass<ClassArgs>(args)...);
+							}, item);
+						}
+					}
+				}
+
+				if (this->_deferred) [[unlikely]]
+					this->settle();
+			}
+			MSVC_SUPPRESS_WARNING_POP
+
+		public:
+			EventQueue(EventQueue&& other) noexcept = default;
+			EventQueue& operator=(EventQueue&& other) noexcept = default;
+
+			explicit EventQueue() = default;
+
+			explicit EventQueue(unsigned expectedSubscriptions) :
+				EventT(expectedSubscriptions)
+			{
+			}
+
+			/* Queue a raise with @args, the arguments are copied or moved into
+			the queue, nothing is invoked until .dispatch(...).
+
+			NDEBUG complexity: amortized O(1), allocation-free once the queue
+			has grown to the largest batch */
+			template<typename...Args>
+				requires std::constructible_from<ItemT, Args&&...>
+			void enqueue(Args&&...args)
+			{
+				_queued.emplace_back(std::forward<Args>(args)...);
+			}
+
+			/* Deliver all queued items to the subscribers in @order, see
+			QueueDispatch, and return the number of delivered items.
+
+			Callbacks may subscribe and unsubscribe as during .raise(...), and
+			enqueue items, which are delivered by the next .dispatch(...).
+			Callbacks must not call .dispatch(...) of the same queue.
+
+			NDEBUG complexity: O(EventQueue::count() * EventQueue::queued()) */
+			std::size_t dispatch(QueueDispatch order = QueueDispatch::ItemMajor)
+			{
+				assert(_dispatching.empty() && "dispatch(...) of a queue cannot be nested");
+
+				_queued.swap(_dispatching);
+				const std::size_t nItems = _dispatching.size();
+
+				if (order == QueueDispatch::SubscriberMajor)
+					dispatchSubscriberMajor();
+				else
+				{
+					for (ItemT& item : _dispatching)
+					{
+						std::apply([this](std::decay_t<ClassArgs>&...args)
+						{
+							this->raise(pass<ClassArgs>(args)...);
+						}, item);
+					}
+				}
+
+				_dispatching.clear();
+				return nItems;
+			}
+
+			//the number of items waiting for .dispatch(...)
+			[[nodiscard]] std::size_t queued() const
+			{
+				return _queued.size();
+			}
+
+			//drop the queued items without delivering them
+			void discardQueued()
+			{
+				_queued.clear();
+			}
+		};
+
+		template<typename Reducer, unsigned ExpectedSubscriptions, DispatchOrder Order,
+			EventStorage Storage, typename R, typename...ClassArgs>
+		class CoalescingEvent<Reducer, ExpectedSubscriptions, Order, Storage, R(ClassArgs...)> :
+			public Event<ExpectedSubscriptions, Order, Storage, R(ClassArgs...)>
+		{
+			using EventT = Event<ExpectedSubscriptions, Order, Storage, R(ClassArgs...)>;
+
+			//the copies of the arguments of the pending notification
+			using PendingT = std::tuple<std::decay_t<ClassArgs>...>;
+
+			std::optional<PendingT> _pending;
+
+			[[no_unique_address]] Reducer _reducer;
+
+			//a pending argument as the parameter of type @Arg of a callback
+			template<typename Arg>
+			static decltype(auto) pass(std::decay_t<Arg>& arg)
+			{
+				if constexpr (std::is_rvalue_reference_v<Arg>)
+					return std::move(arg);
+				else
+					return (arg);
+			}
+
+			template<typename...Args>
+			static constexpr bool Mergeable = std::same_as<Reducer, reducers::Latest> ?
+				std::is_assignable_v<PendingT&, PendingT> :
+				std::is_invocable_v<Reducer&, std::decay_t<ClassArgs>&..., Args&&...>;
+
+		public:
+			CoalescingEvent(CoalescingEvent&& other) noexcept = default;
+			CoalescingEvent& operator=(CoalescingEvent&& other) noexcept = default;
+
+			explicit CoalescingEvent(Reducer reducer = Reducer()) :
+				_reducer(std::move(reducer))
+			{
+			}
+
+			explicit CoalescingEvent(unsigned expectedSubscriptions, Reducer reducer = Reducer()) :
+				EventT(expectedSubscriptions),
+				_reducer(std::move(reducer))
+			{
+			}
+
+			/* Post a raise with @args. If no notification is pending, the
+			arguments are copied or moved into the event, otherwise they are
+			merged into the pending ones with the reducer. Nothing is invoked
+			until .flush().
+
+			NDEBUG complexity: O(1) plus the reducer */
+			template<typename...Args>
+				requires std::constructible_from<PendingT, Args&&...> and
+						 Mergeable<Args...>
+			void post(Args&&...args)
+			{
+				if (!_pending)
+					_pending.emplace(std::forward<Args>(args)...);
+				else if constexpr (std::same_as<Reducer, reducers::Latest>)
+					*_pending = PendingT(std::forward<Args>(args)...);
+				else
+				{
+					std::apply([&](std::decay_t<ClassArgs>&...pending)
+					{
+						std::invoke(_reducer, pending..., std::forward<Args>(args)...);
+					}, *_pending);
+				}
+			}
+
+			/* Raise the pending notification, if any, and return whether it
+			was raised. The notification stops being pending before the
+			callbacks are invoked, so raises posted by the callbacks are
+			delivered by the next .flush().
+
+			NDEBUG complexity: the same as .raise(...) if a notification
+			is pending, otherwise O(1) */
+			bool flush()
+			{
+				if (!_pending)
+					return false;
+
+				PendingT pending = std::move(*_pending);
+				_pending.reset();
+
+				std::apply([this](std::decay_t<ClassArgs>&...args)
+				{
+					this->raise(pass<ClassArgs>(args)...);
+				}, pending);
+
+				return true;
+			}
+
+			/* whether a raise has been posted since the last .flush()
+			NDEBUG complexity: O(1) */
+			[[nodiscard]] bool pending() const
+			{
+				return _pending.has_value();
+			}
+
+			//drop the pending notification without raising it
+			void discardPending()
+			{
+				_pending.reset();
+			}
+		};
+	}
+
+	/* Event (aka "multicast delegate") maintains a set of subscription callbacks
+	and the infrastructure for subscribing and unsubscribing the callbacks at
+	runtime.
+
+	Call Event::raise(...) or Event::operator(...) to notify/invoke all the
+	callbacks.
+
+	Specify the signature of Event as the template parameter @Signature.
+	If @Signature has non-void return type, call Event::collect(...) to
+	combine the results of the callbacks.
+
+	Only callbacks with the same signature can be subscribed to Event.
+
+	Adjust the size of Event's inline(small buffer optimization) buffer
+	for subscriptions by specifying the template parameter @ExpectedSubscriptions.
+	Properly specifying @ExpectedSubscriptions guarantees that all Event operations
+	are 1) reallocation-free 2) heap-free if the Event itself is stack-allocated.
+	Also see .reserve(...).
+
+	Specify DispatchOrder::Grouped as @Order to let Event group its callbacks
+	for faster raising, DispatchOrder::Fifo or Priority to control the order
+	of invocation, see DispatchOrder.
+
+	Specify EventStorage::SlotMap as @Storage to get SlotSubscription instead
+	of Subscription from .subscribe(...), see EventStorage.
+	*/
+	template<typename Signature = void(),
+		unsigned ExpectedSubscriptions = internal::ExpectedSubscriptionsDefault,
+		DispatchOrder Order = DispatchOrder::Unspecified,
+		EventStorage Storage = EventStorage::BackPointers>
+	class Event : public internal::Event<ExpectedSubscriptions, Order, Storage, Signature>
+	{
+		using BaseT = internal::Event<ExpectedSubscriptions, Order, Storage, Signature>;
+
+	public:
+		explicit Event() : BaseT()
+		{
+		}
+
+		/* Immediately allocate memory for @expectedSubscriptions.
+		See .reserve(...) */
+		explicit Event(unsigned expectedSubscriptions) :
+			BaseT(expectedSubscriptions)
+		{
+		}
+	};
+
+	/* EventQueue is an Event that can also record raises and deliver them
+	later in a batch, e.g. raise during the update phase of a game loop and
+	dispatch at the sync point, keeping subscriber code out of the inner
+	simulation loop.
+
+	.enqueue(...) copies or moves the arguments into a queue that is reused
+	by every batch, so queueing is allocation-free in a steady state.
+	.dispatch(...) delivers the batch item by item or subscriber by
+	subscriber, see QueueDispatch. Otherwise, EventQueue is used exactly
+	like Event, .raise(...) invokes the callbacks immediately.
+
+	The parameters of @Signature get references to the queued copies,
+	rvalue reference parameters get rvalues, as for Event::raise(...).
+	*/
+	template<typename Signature = void(),
+		unsigned ExpectedSubscriptions = internal::ExpectedSubscriptionsDefault,
+		DispatchOrder Order = DispatchOrder::Unspecified,
+		EventStorage Storage = EventStorage::BackPointers>
+	class EventQueue : public internal::EventQueue<ExpectedSubscriptions, Order, Storage, Signature>
+	{
+		using BaseT = internal::EventQueue<ExpectedSubscriptions, Order, Storage, Signature>;
+
+	public:
+		explicit EventQueue() : BaseT()
+		{
+		}
+
+		/* Immediately allocate memory for @expectedSubscriptions.
+		See .reserve(...) */
+		explicit EventQueue(unsigned expectedSubscriptions) :
+			BaseT(expectedSubscriptions)
+		{
+		}
+	};
+
+	/* CoalescingEvent is an Event that can also collapse repeated raises into
+	a single notification, e.g. "property changed" or "needs redraw" raised
+	many times per frame, while subscribers only need to learn the final
+	state once.
+
+	.post(...) records a raise. If a notification is already pending, the
+	arguments are merged into it with @Reducer: by default the latest
+	arguments win, see CallMe::reducers for custom reducers. .flush()
+	raises the pending notification once, .pending() tells whether there is
+	one. Otherwise, CoalescingEvent is used exactly like Event, .raise(...)
+	invokes the callbacks immediately.
+	*/
+	template<typename Signature = void(),
+		typename Reducer = reducers::Latest,
+		unsigned ExpectedSubscriptions = internal::ExpectedSubscriptionsDefault,
+		DispatchOrder Order = DispatchOrder::Unspecified,
+		EventStorage Storage = EventStorage::BackPointers>
+	class CoalescingEvent :
+		public internal::CoalescingEvent<Reducer, ExpectedSubscriptions, Order, Storage, Signature>
+	{
+		using BaseT = internal::CoalescingEvent<Reducer, ExpectedSubscriptions, Order, Storage, Signature>;
+
+	public:
+		explicit CoalescingEvent(Reducer reducer = Reducer()) :
+			BaseT(std::move(reducer))
+		{
+		}
+
+		/* Immediately allocate memory for @expectedSubscriptions.
+		See .reserve(...) */
+		explicit CoalescingEvent(unsigned expectedSubscriptions, Reducer reducer = Reducer()) :
+			BaseT(expectedSubscriptions, std::move(reducer))
+		{
+		}
+	};
+
+	Event() -> Event<void()>;
+
+	/* RAII-wrapper for managing the lifetime of a subscription.
+	One Subscription object represents one delegate object
+	(subscriber's callback) registered in an Event. 
+	*/
+	class Subscription
+	{
+		friend struct internal::SubscriptionAccess;
+
+		//the index of the owned subscription record
+		internal::SubscriptionIndex _index;
+
+		/* whenever _event != nullptr, the subscription is "attached"
+		to the event and owns the respective subscription record in
+		the event. Otherwise, the subscription is "detached" from the
+		event (e.g. after having been moved from) and does not own
+		anything. */
+		internal::ErasedEvent viewptr _event;
+
+		void releaseOwnership()
+		{
+			_event = nullptr;
+
+			#ifndef NDEBUG
+			_index = internal::InvalidSubscriptionIndex;
+			#endif
+		}
+
+		void unsubscribe()
+		{
+			if(_event)
+			{
+				_event->unsubscribe(_index);
+				releaseOwnership();
+			}
+		}
+
+	public:
+		DELETE_FUNCTION(Subscription(), 
+						"For optional subscriptions, use std::optional<Subscription>")		 
+
+		//only for internal use
+		Subscription(internal::SubscriptionIndex index, 
+					 internal::ErasedEvent viewptr event) noexcept :
+			_index(index),
+			_event(event)
+		{
+			_event->changeOwner(_index, this);
+			_event->validate();
+		}
+
+		/* Unregister/unsubscribe from the Event.
+		NDEBUG complexity: O(1) */
+		~Subscription()
+		{
+			unsubscribe();
+		}
+
+		Subscription(const Subscription& src)            = delete;
+		Subscription& operator=(const Subscription& src) = delete;
+
+		Subscription(Subscription&& src) noexcept :
+			_index(src._index),
+			_event(src._event)
+		{
+			if(_event)
+			{
+				/* subscription records remain unchanged, just
+				src's owned record is now owned by [this] instead
+				of src */
+				_event->changeOwner(_index, this);
+				src.releaseOwnership();
+				_event->validate();
+			}
+		}
+
+		Subscription& operator=(Subscription&& src) noexcept
+		{
+			if (this == &src)
+				return *this;
+
+			if(src._event)
+			{
+				if(_event == src._event)
+				{
+					/* [src]'s delegate is moved to [this]'s subscription
+					record. The record stays in its place (_index unchanged)
+					and is still owned by [this]. src's subscription record
+					is no longer needed and is removed from _event by
+					unsubscribing, after which src no longer owns anything. */
+					_event->moveDelegate(src._index, this->_index);
+					src.unsubscribe();
+				}
+				else//[this] is moved-from or subscribed to another event
+				{
+					unsubscribe();
+
+					//[this] acquires ownership of the src's subscription record
+					this->_index = src._index;
+					this->_event = src._event;
+
+					//redirect src's record to the new owner
+					_event->changeOwner(src._index, this);
+
+					//src no longer owns anything
+					src.releaseOwnership();
+				}
+				_event->validate();
+			}
+			else
 			{
-				_records.emplace_back(std::move(callback));
-				return Subscription(_records.size()-1, this);
+				//[this] is overwritten by an empty subscription
+				unsubscribe();
 			}
 
-			#define MsgEventCallbackMismatch "Callback signature mismatches the signature of Event"
+			return *this;
+		}
 
-			template<typename MismatchingSignature>
-				requires (not std::same_as<MismatchingSignature, Signature>)
-			DELETE_FUNCTION(auto subscribe(Delegate<MismatchingSignature>&&),
-							MsgEventCallbackMismatch)
+		//alternative implementation, slightly worse performance
+		/* Subscription& operator=(Subscription&& src) noexcept
+		{
+			if (this == &src)
+				return *this;
 
+			//remove the current subscription record owned by [this]
+			this->unsubscribe();
 
-			/* Subscribe @callback to the Event, see the other overload.
+			if(src._event)
+			{	
+				//[this] acquires ownership of the src's subscription record
+				this->_index = src._index;
+				this->_event = src._event;
 
-			The function saves a Subscription object in @dst.
+				//redirect src's record to the new owner
+				_event->changeOwner(src._index, this);
 
-			Customize the type of subscription vector @dst by passing a @dst
-			of any vector-like container type such as
-			gch::small_vector<Subscription, nSubscriptions>, see unit tests
-			for examples.
+				//src no longer owns anything
+				src.releaseOwnership();
 
-			NDEBUG complexity:
-			* If both Event and @dst have enough allocated space: O(1)
-			* Otherwise, up to two reallocations, whatever triggers:
-				* reallocation + O(Event::count()),
-				* reallocation + O(@dst.count())
-			*/
-			template<typename VectorOfSubscriptions = std::vector<Subscription>>
-			void subscribe(DelegateT&& callback,
-						   VectorOfSubscriptions& dst)
-			{
-				_records.emplace_back(std::move(callback));
-				dst.emplace_back(_records.size()-1, this);
+				_event->validate();
 			}
 
-			template<typename MismatchingSignature, typename VectorOfSubscriptions>
-				requires (not std::same_as<MismatchingSignature, Signature>)
-			DELETE_FUNCTION(void subscribe(Delegate<MismatchingSignature>&&, 
-										   VectorOfSubscriptions&),
-							MsgEventCallbackMismatch)
+			return *this;
+		} */
 
-			// the number of current subscriptions 
-			[[nodiscard]] std::ptrdiff_t count() const
-			{
-				return std::ssize(_records);
-			}
+		/* Move Subscription to @dst.
 
-			// true IFF there are currently no subscriptions
-			[[nodiscard]] bool empty() const
-			{
-				return _records.empty();
-			}
-		};
-	}
+		Customize the type of subscription vector @dst by passing a @dst
+		of any vector-like container type such as
+		gch::small_vector<Subscription, nSubscriptions>, see unit tests
+		for examples.
 
-	/* Event (aka "multicast delegate") maintains a set of subscription callbacks
-	and the infrastructure for subscribing and unsubscribing the callbacks at
-	runtime.
+		There is an overload of Event::subscribe(...) that accepts
+		VectorOfSubscriptions& as a parameter and saves a new subscription
+		there. That overload is more efficient and recommended whenever
+		you want to manage the lifetime of a new subscription with a
+		vector of subscriptions right away.
 
-	Call Event::raise(...) or Event::operator(...) to notify/invoke all the
-	callbacks.
+		This overload is appropriate for the nontrivial scenario when you
+		first need to manage a subscription individually, by saving it in
+		a scalar variable, but later runtime logic determines that individual
+		lifetime management is no longer needed and the subscription can be
+		managed with a vector of subscriptions.
 
-	Specify the signature of Event as the template parameter @Signature.
-	@Signature must have void return type.
+		NDEBUG complexity:
+		* If @dst has enough allocated space: O(1)
+		* Otherwise: reallocation + O(@dst.count())
+		*/
+		template<typename VectorOfSubscriptions = std::vector<Subscription>>
+		void move(VectorOfSubscriptions& dst)
+		{
+			dst.push_back(std::move(*this));
+		}
+	};
 
-	Only callbacks with the same signature can be subscribed to Event.
+	namespace internal
+	{
+		inline SubscriptionIndex SubscriptionAccess::index(const Subscription viewptr subscription)
+		{
+			return subscription->_index;
+		}
 
-	Adjust the size of Event's inline(small buffer optimization) buffer
-	for subscriptions by specifying the template parameter @ExpectedSubscriptions.
-	Properly specifying @ExpectedSubscriptions guarantees that all Event operations
-	are 1) reallocation-free 2) heap-free if the Event itself is stack-allocated.
-	Also see .reserve(...).
+		inline void SubscriptionAccess::setIndex(Subscription viewptr subscription, SubscriptionIndex index)
+		{
+			subscription->_index = index;
+		}
+
+		inline ErasedEvent viewptr SubscriptionAccess::event(const Subscription viewptr subscription)
+		{
+			return subscription->_event;
+		}
+
+		inline void SubscriptionAccess::setEvent(Subscription viewptr subscription, ErasedEvent viewptr event)
+		{
+			subscription->_event = event;
+		}
+
+		inline void SubscriptionAccess::releaseOwnership(Subscription viewptr subscription)
+		{
+			subscription->releaseOwnership();
+		}
+	}
+
+	/* RAII-wrapper for managing the lifetime of a subscription to an Event
+	with EventStorage::SlotMap, see EventStorage.
+
+	SlotSubscription holds a {slot, generation} handle to its record in the
+	Event's slot table instead of being pointed to by the record. So moving
+	a SlotSubscription (e.g. on reallocation of a vector of them) never
+	writes into the Event. If the Event is destroyed or cleared, the handle
+	becomes stale, which is detected, see .valid().
 	*/
-	template<typename Signature = void(),
-		unsigned ExpectedSubscriptions = internal::ExpectedSubscriptionsDefault>
-	class Event : public internal::Event<ExpectedSubscriptions, Signature>
+	class SlotSubscription
 	{
-		using BaseT = internal::Event<ExpectedSubscriptions, Signature>;
+		//shared with the Event, nullptr after having been moved from
+		internal::SlotTable viewptr _table;
+
+		std::uint32_t _slot;
+		std::uint32_t _generation;
+
+		void unsubscribe()
+		{
+			if (_table == nullptr)
+				return;
+
+			if (_table->isLive(_slot, _generation))
+				_table->_event->unsubscribe(_table->_slots[_slot]._index);
+
+			internal::SlotTable::removeReference(_table);
+			_table = nullptr;
+		}
 
 	public:
-		explicit Event() : BaseT()
+		DELETE_FUNCTION(SlotSubscription(),
+						"For optional subscriptions, use std::optional<SlotSubscription>")
+
+		/* only for internal use, @table already counts the reference
+		of the new SlotSubscription */
+		SlotSubscription(internal::SlotTable viewptr table,
+						 std::uint32_t slot, std::uint32_t generation) noexcept :
+			_table(table),
+			_slot(slot),
+			_generation(generation)
 		{
+			_table->_event->validate();
 		}
 
-		/* Immediately allocate memory for @expectedSubscriptions.
-		See .reserve(...) */
-		explicit Event(unsigned expectedSubscriptions) :
-			BaseT(expectedSubscriptions)
+		/* Unregister/unsubscribe from the Event, if it is still alive.
+		NDEBUG complexity: O(1) */
+		~SlotSubscription()
+		{
+			unsubscribe();
+		}
+
+		SlotSubscription(const SlotSubscription& src)            = delete;
+		SlotSubscription& operator=(const SlotSubscription& src) = delete;
+
+		//NDEBUG complexity: O(1), the Event is not touched
+		SlotSubscription(SlotSubscription&& src) noexcept :
+			_table(std::exchange(src._table, nullptr)),
+			_slot(src._slot),
+			_generation(src._generation)
+		{
+		}
+
+		/* The record owned by [this] is removed from its Event, then [this]
+		takes over the record of @src */
+		SlotSubscription& operator=(SlotSubscription&& src) noexcept
+		{
+			if (this == &src)
+				return *this;
+
+			unsubscribe();
+
+			_table = std::exchange(src._table, nullptr);
+			_slot = src._slot;
+			_generation = src._generation;
+
+			return *this;
+		}
+
+		/* true IFF the SlotSubscription owns a record of an alive Event, i.e.
+		it has not been moved from, and the Event has been neither destroyed
+		nor cleared since the subscription */
+		[[nodiscard]] bool valid() const
+		{
+			return _table != nullptr && _table->isLive(_slot, _generation);
+		}
+
+		/* Move SlotSubscription to @dst, see Subscription::move(...)
+
+		NDEBUG complexity:
+		* If @dst has enough allocated space: O(1)
+		* Otherwise: reallocation + O(@dst.count())
+		*/
+		template<typename VectorOfSubscriptions = std::vector<SlotSubscription>>
+		void move(VectorOfSubscriptions& dst)
 		{
+			dst.push_back(std::move(*this));
 		}
 	};
 
-	Event() -> Event<void()>;
+	/* A vector of Subscription objects that relocates its elements in bulk.
 
-	/* RAII-wrapper for managing the lifetime of a subscription.
-	One Subscription object represents one delegate object
-	(subscriber's callback) registered in an Event. 
+	std::vector<Subscription> moves its elements one by one when it grows,
+	and every move tells the event of the subscription the new address of
+	its owner with a virtual call. SubscriptionVector copies the elements
+	with memcpy instead, then tells each event the new addresses of all
+	adjacent subscriptions of that event with a single virtual call. Moving
+	a SubscriptionVector doesn't move the elements at all.
+
+	Pass SubscriptionVector as @dst to Event::subscribe(..., dst) or
+	Event::subscribeMany(..., dst), or to Subscription::move(dst).
 	*/
-	class Subscription
+	class SubscriptionVector
 	{
-		template<unsigned, typename>
-		friend class internal::Event;
+		Subscription viewptr _data = nullptr;
+		std::size_t _size = 0;
+		std::size_t _capacity = 0;
+
+		/* tells the events of the relocated subscriptions [@first, @last)
+		their new addresses. The owner table of every event is fetched with
+		a single virtual call and cached in a small hash table, then the
+		owners of every run of adjacent subscriptions of one event are
+		changed in a tight loop. Subscriptions of events with empty owner
+		tables and, if the cache is full, of further events fall back to
+		a virtual call each */
+		static void changeOwners(Subscription viewptr first, Subscription viewptr last)
+		{
+			using internal::SubscriptionAccess;
+			using internal::ErasedEvent;
+			using internal::OwnerTable;
 
-		template<typename>
-		friend class internal::SubscriptionRecord;
+			constexpr std::size_t CacheSize = 16;
+			std::array<ErasedEvent viewptr, CacheSize> events{};
+			std::array<OwnerTable, CacheSize> tables;
 
-		//the index of the owned subscription record
-		internal::SubscriptionIndex _index;
+			while (first != last)
+			{
+				ErasedEvent viewptr event = SubscriptionAccess::event(first);
 
-		/* whenever _event != nullptr, the subscription is "attached"
-		to the event and owns the respective subscription record in
-		the event. Otherwise, the subscription is "detached" from the
-		event (e.g. after having been moved from) and does not own
-		anything. */
-		internal::ErasedEvent viewptr _event;
+				Subscription viewptr run = first;
+				do
+					++run;
+				while (run != last && SubscriptionAccess::event(run) == event);
+
+				if (event == nullptr)
+				{
+					first = run;
+					continue;
+				}
+
+				//open addressing with linear probing
+				std::size_t slot = std::bit_cast<std::uintptr_t>(event) / alignof(ErasedEvent) % CacheSize;
+				std::size_t probes = 0;
+				while (events[slot] != event && events[slot] != nullptr && probes != CacheSize)
+				{
+					slot = (slot + 1) % CacheSize;
+					++probes;
+				}
+
+				if (probes != CacheSize && events[slot] == nullptr)
+				{
+					events[slot] = event;
+					tables[slot] = event->ownerTable();
+				}
+
+				if (probes == CacheSize || tables[slot].empty())
+				{
+					for (; first != run; ++first)
+						event->changeOwner(SubscriptionAccess::index(first), first);
+					continue;
+				}
+
+				const OwnerTable table = tables[slot];
+				for (; first != run; ++first)
+					table[SubscriptionAccess::index(first)] = first;
+			}
+		}
+
+		//events of the subscriptions [@first, @last) validate their records
+		static void validate([[maybe_unused]] Subscription viewptr first,
+							 [[maybe_unused]] Subscription viewptr last)
+		{
+		#ifndef NDEBUG
+			internal::ErasedEvent viewptr validated = nullptr;
+			for (; first != last; ++first)
+			{
+				internal::ErasedEvent viewptr event = internal::SubscriptionAccess::event(first);
+				if (event != nullptr && event != validated)
+					event->validate();
+				validated = event;
+			}
+		#endif
+		}
+
+		//moves [@first, @last) to @to, which may overlap
+		static void relocate(Subscription viewptr first, Subscription viewptr last,
+							 Subscription viewptr to)
+		{
+			if (first == last || first == to)
+				return;
+
+			std::memmove(static_cast<void viewptr>(to), first,
+						 std::size_t(last - first) * sizeof(Subscription));
+			changeOwners(to, to + (last - first));
+			validate(to, to + (last - first));
+		}
+
+		void reallocate(std::size_t capacity)
+		{
+			assert(capacity >= _size);
+
+			Subscription viewptr data = capacity != 0 ?
+				std::allocator<Subscription>().allocate(capacity) : nullptr;
+			if (_data != nullptr)
+			{
+				relocate(_data, _data + _size, data);
+				std::allocator<Subscription>().deallocate(_data, _capacity);
+			}
+			_data = data;
+			_capacity = capacity;
+		}
+
+		void release()
+		{
+			clear();
+			if (_data != nullptr)
+				std::allocator<Subscription>().deallocate(_data, _capacity);
+			_data = nullptr;
+			_capacity = 0;
+		}
+
+	public:
+		SubscriptionVector() = default;
+
+		SubscriptionVector(const SubscriptionVector&) = delete;
+		SubscriptionVector& operator=(const SubscriptionVector&) = delete;
+
+		//the subscriptions don't move, the buffer is stolen
+		SubscriptionVector(SubscriptionVector&& other) noexcept :
+			_data(std::exchange(other._data, nullptr)),
+			_size(std::exchange(other._size, 0)),
+			_capacity(std::exchange(other._capacity, 0))
+		{
+		}
+
+		SubscriptionVector& operator=(SubscriptionVector&& other) noexcept
+		{
+			if (this != &other)
+			{
+				release();
+				_data = std::exchange(other._data, nullptr);
+				_size = std::exchange(other._size, 0);
+				_capacity = std::exchange(other._capacity, 0);
+			}
+			return *this;
+		}
+
+		/* Unsubscribe all subscriptions.
+		NDEBUG complexity: O(size()) */
+		~SubscriptionVector()
+		{
+			release();
+		}
+
+		/* NDEBUG complexity: if reallocates, O(size()) plus a virtual call per
+		run of adjacent subscriptions of one event */
+		void reserve(std::size_t n)
+		{
+			if (n > _capacity)
+				reallocate(n);
+		}
+
+		void shrink_to_fit()
+		{
+			if (_size != _capacity)
+				reallocate(_size);
+		}
+
+		template<typename...Args>
+		Subscription& emplace_back(Args&&...args)
+		{
+			if (_size == _capacity)
+			{
+				/* construct the new element first, as @args may refer to
+				the current elements */
+				std::size_t capacity = _capacity != 0 ? 2 * _capacity : 4;
+				Subscription viewptr data = std::allocator<Subscription>().allocate(capacity);
+				new (data + _size) Subscription(std::forward<Args>(args)...);
+
+				if (_data != nullptr)
+				{
+					relocate(_data, _data + _size, data);
+					std::allocator<Subscription>().deallocate(_data, _capacity);
+				}
+				_data = data;
+				_capacity = capacity;
+			}
+			else
+				new (_data + _size) Subscription(std::forward<Args>(args)...);
+
+			return _data[_size++];
+		}
+
+		void push_back(Subscription&& subscription)
+		{
+			emplace_back(std::move(subscription));
+		}
+
+		//unsubscribes the last subscription
+		void pop_back()
+		{
+			assert(_size != 0);
+			_data[--_size].~Subscription();
+		}
+
+		/* Unsubscribe the subscriptions [@first, @last), the following
+		subscriptions are relocated in bulk. Returns the position after the
+		removed ones. */
+		Subscription viewptr erase(Subscription viewptr first, Subscription viewptr last)
+		{
+			assert(begin() <= first && first <= last && last <= end());
+
+			std::destroy(first, last);
+			relocate(last, end(), first);
+			_size -= std::size_t(last - first);
+			return first;
+		}
+
+		Subscription viewptr erase(Subscription viewptr position)
+		{
+			return erase(position, position + 1);
+		}
+
+		//unsubscribe all subscriptions, the capacity is kept
+		void clear()
+		{
+			std::destroy(begin(), end());
+			_size = 0;
+		}
 
-		void releaseOwnership()
+		Subscription viewptr begin() { return _data; }
+		Subscription viewptr end() { return _data + _size; }
+		const Subscription viewptr begin() const { return _data; }
+		const Subscription viewptr end() const { return _data + _size; }
+
+		Subscription& operator[](std::size_t i)
 		{
-			_event = nullptr;
+			assert(i < _size);
+			return _data[i];
+		}
 
-			#ifndef NDEBUG
-			_index = internal::InvalidSubscriptionIndex;
-			#endif
+		Subscription& back()
+		{
+			assert(_size != 0);
+			return _data[_size - 1];
 		}
 
-		void unsubscribe()
+		[[nodiscard]] std::size_t size() const
 		{
-			if(_event)
-			{
-				_event->unsubscribe(_index);
-				releaseOwnership();
-			}
+			return _size;
 		}
 
-	public:
-		DELETE_FUNCTION(Subscription(), 
-						"For optional subscriptions, use std::optional<Subscription>")		 
+		[[nodiscard]] std::size_t capacity() const
+		{
+			return _capacity;
+		}
 
-		//only for internal use
-		Subscription(internal::SubscriptionIndex index, 
-					 internal::ErasedEvent viewptr event) noexcept :
-			_index(index),
-			_event(event)
+		[[nodiscard]] bool empty() const
 		{
-			_event->changeOwner(_index, this);
-			_event->validate();
+			return _size == 0;
 		}
+	};
 
-		/* Unregister/unsubscribe from the Event.
-		NDEBUG complexity: O(1) */
-		~Subscription()
+	/* A vector of subscriptions, possibly to different events, that ends them
+	all at once.
+
+	Pass SubscriptionGroup as @dst to Event::subscribe(..., dst) or
+	Event::subscribeMany(..., dst). When the group is cleared or destroyed,
+	each event removes all records of the group's subscriptions with
+	a single compaction pass, instead of a swap-remove per subscription.
+	*/
+	class SubscriptionGroup
+	{
+		SubscriptionVector _subscriptions;
+
+		/* after the records are removed: the subscriptions must not
+		unsubscribe, and must stay attached until then, as a concurrent
+		event may look at the owners of its records */
+		void releaseAll()
 		{
-			unsubscribe();
+			for (Subscription& s : _subscriptions)
+				internal::SubscriptionAccess::releaseOwnership(&s);
+			_subscriptions.clear();
 		}
 
-		Subscription(const Subscription& src)            = delete;
-		Subscription& operator=(const Subscription& src) = delete;
+	public:
+		SubscriptionGroup() = default;
 
-		Subscription(Subscription&& src) noexcept :
-			_index(src._index),
-			_event(src._event)
+		SubscriptionGroup(const SubscriptionGroup&) = delete;
+		SubscriptionGroup& operator=(const SubscriptionGroup&) = delete;
+
+		//the subscriptions don't move, the vector's buffer is stolen
+		SubscriptionGroup(SubscriptionGroup&& other) noexcept = default;
+
+		SubscriptionGroup& operator=(SubscriptionGroup&& other) noexcept
 		{
-			if(_event)
+			if (this != &other)
 			{
-				/* subscription records remain unchanged, just
-				src's owned record is now owned by [this] instead
-				of src */
-				_event->changeOwner(_index, this);
-				src.releaseOwnership();
-				_event->validate();
+				clear();
+				_subscriptions = std::move(other._subscriptions);
 			}
+			return *this;
 		}
 
-		Subscription& operator=(Subscription&& src) noexcept
+		/* Unsubscribe all subscriptions of the group.
+		NDEBUG complexity: O(count() * log(count())) + O(Event::count()) per event */
+		~SubscriptionGroup()
 		{
-			if (this == &src)
-				return *this;
+			clear();
+		}
 
-			if(src._event)
+		/* Unsubscribe all subscriptions of the group in bulk, see the class comment.
+
+		NDEBUG complexity: O(count() * log(count())) + O(Event::count()) per event */
+		void clear()
+		{
+			using internal::SubscriptionAccess;
+			using internal::ErasedEvent;
+			using internal::SubscriptionIndex;
+
+			//usually all subscriptions of a group belong to one event
+			ErasedEvent viewptr single = nullptr;
+			bool oneEvent = true;
+			for (Subscription& s : _subscriptions)
 			{
-				if(_event)
+				ErasedEvent viewptr event = SubscriptionAccess::event(&s);
+				if (event == nullptr || event == single)
+					continue;
+
+				if (single != nullptr)
 				{
-					/* [src]'s delegate is moved to [this]'s subscription
-					record. The record stays in its place (_index unchanged)
-					and is still owned by [this]. src's subscription record
-					is no longer needed and is removed from _event by
-					unsubscribing, after which src no longer owns anything. */
-					_event->moveDelegate(src._index, this->_index);
-					src.unsubscribe();
+					oneEvent = false;
+					break;
 				}
-				else//[this] is default-constructed or moved-from
-				{
-					//[this] acquires ownership of the src's subscription record
-					this->_index = src._index;
-					this->_event = src._event;
+				single = event;
+			}
 
-					//redirect src's record to the new owner
-					_event->changeOwner(src._index, this);
+			std::vector<SubscriptionIndex> indices;
+			indices.reserve(_subscriptions.size());
 
-					//src no longer owns anything
-					src.releaseOwnership();
-				}
-				_event->validate();
-			}
-			else
+			if (oneEvent)
 			{
-				//[this] is overwritten by an empty subscription
-				unsubscribe();
-			}
-
-			return *this;
-		}
+				for (Subscription& s : _subscriptions)
+				{
+					if (SubscriptionAccess::event(&s) == nullptr)
+						continue;
 
-		//alternative implementation, slightly worse performance
-		/* Subscription& operator=(Subscription&& src) noexcept
-		{
-			if (this == &src)
-				return *this;
+					indices.push_back(SubscriptionAccess::index(&s));
+				}
 
-			//remove the current subscription record owned by [this]
-			this->unsubscribe();
+				if (single != nullptr)
+					single->unsubscribeMany(indices);
+				releaseAll();
+				return;
+			}
 
-			if(src._event)
-			{	
-				//[this] acquires ownership of the src's subscription record
-				this->_index = src._index;
-				this->_event = src._event;
+			//{event, index} of every attached subscription, grouped by event
+			std::vector<std::pair<ErasedEvent viewptr, SubscriptionIndex>> records;
+			records.reserve(_subscriptions.size());
+			for (Subscription& s : _subscriptions)
+			{
+				if (ErasedEvent viewptr event = SubscriptionAccess::event(&s))
+					records.emplace_back(event, SubscriptionAccess::index(&s));
+			}
 
-				//redirect src's record to the new owner
-				_event->changeOwner(src._index, this);
+			std::sort(records.begin(), records.end(), [](const auto& a, const auto& b)
+			{
+				return std::less<>{}(a.first, b.first);
+			});
 
-				//src no longer owns anything
-				src.releaseOwnership();
+			for (auto first = records.begin(); first != records.end();)
+			{
+				auto last = first;
+				indices.clear();
+				for (; last != records.end() && last->first == first->first; ++last)
+					indices.push_back(last->second);
 
-				_event->validate();
+				first->first->unsubscribeMany(indices);
+				first = last;
 			}
+			releaseAll();
+		}
 
-			return *this;
-		} */
-
-		/* Move Subscription to @dst.
+		void reserve(std::size_t n)
+		{
+			_subscriptions.reserve(n);
+		}
 
-		Customize the type of subscription vector @dst by passing a @dst
-		of any vector-like container type such as
-		gch::small_vector<Subscription, nSubscriptions>, see unit tests
-		for examples.
+		template<typename...Args>
+		Subscription& emplace_back(Args&&...args)
+		{
+			return _subscriptions.emplace_back(std::forward<Args>(args)...);
+		}
 
-		There is an overload of Event::subscribe(...) that accepts
-		VectorOfSubscriptions& as a parameter and saves a new subscription
-		there. That overload is more efficient and recommended whenever
-		you want to manage the lifetime of a new subscription with a
-		vector of subscriptions right away.
+		void push_back(Subscription&& subscription)
+		{
+			_subscriptions.push_back(std::move(subscription));
+		}
 
-		This overload is appropriate for the nontrivial scenario when you
-		first need to manage a subscription individually, by saving it in
-		a scalar variable, but later runtime logic determines that individual
-		lifetime management is no longer needed and the subscription can be
-		managed with a vector of subscriptions.
+		// the number of subscriptions in the group
+		[[nodiscard]] std::size_t size() const
+		{
+			return _subscriptions.size();
+		}
 
-		NDEBUG complexity:
-		* If @dst has enough allocated space: O(1)
-		* Otherwise: reallocation + O(@dst.count())
-		*/
-		template<typename VectorOfSubscriptions = std::vector<Subscription>>
-		void move(VectorOfSubscriptions& dst)
+		[[nodiscard]] bool empty() const
 		{
-			dst.push_back(std::move(*this));
+			return _subscriptions.empty();
 		}
 	};
 
 	namespace internal
 	{
-		template<typename Signature>
-		class SubscriptionRecord
+		template<auto Method>
+		using MethodObject = std::conditional_t<
+			MemberFunctionDeducer<decltype(Method)>::ConstFunction,
+			const typename MemberFunctionDeducer<decltype(Method)>::ClassType,
+			typename MemberFunctionDeducer<decltype(Method)>::ClassType>;
+
+		/* In this internal version of MethodEvent, the signature is
+		decomposed, the same as in internal::Event */
+		template<auto Method, unsigned ExpectedSubscriptions, typename Signature>
+		class MethodEvent;
+
+		template<auto Method, unsigned ExpectedSubscriptions, typename R, typename...ClassArgs>
+		class MethodEvent<Method, ExpectedSubscriptions, R(ClassArgs...)> :
+			public SubscriptionRecords<MethodObject<Method> viewptr, ExpectedSubscriptions>
 		{
-			template<unsigned, typename>
-			friend class CallMe::internal::Event;
+			static_assert(std::same_as<R, void>, "only void return types are supported");
 
-			using DelegateT = Delegate<Signature>;
-			DelegateT _delegate;
+			using Object = MethodObject<Method>;
 
-			// this pointer is always updated by the Subscription
-			Subscription viewptr _owner;
+			using RecordsT = SubscriptionRecords<Object viewptr, ExpectedSubscriptions>;
 
-			void changeOwner(Subscription viewptr newOwner)
+		public:
+			MethodEvent(MethodEvent&& other) noexcept = default;
+			MethodEvent& operator=(MethodEvent&& other) noexcept = default;
+
+			explicit MethodEvent()
 			{
-				_owner = newOwner;
+				#ifndef USE_SMALL_VECTOR
+				//for std::vector, reserve ExpectedSubscriptions on the heap
+				this->reserve(ExpectedSubscriptions);
+				#endif
 			}
 
-			void changeEvent(ErasedEvent viewptr newEvent)
+			explicit MethodEvent(unsigned expectedSubscriptions)
 			{
-				_owner->_event = newEvent;
+				this->reserve(expectedSubscriptions);
 			}
 
-			void releaseOwnership()
+			/* Invoke @Method on all subscribed objects and pass them the given
+			arguments @args.
+
+			The order of invocation relative to each other is unspecified.
+
+			There is no type erasure: this is a plain loop over object pointers,
+			@Method can be inlined into it.
+
+			Subscribing and unsubscribing during dispatch is allowed the same
+			as for Event::raise(...).
+
+			NDEBUG complexity: O(MethodEvent::count())
+			*/
+			MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
+			void raise(ClassArgs...args)
 			{
-				_owner->releaseOwnership();
+				{
+					typename RecordsT::DispatchScope scope(*this);
+
+					for (std::ptrdiff_t i = 0; i!=std::ssize(this->_callbacks); ++i)
+					{
+						//skip tombstones of objects unsubscribed during dispatch
+						if (Object viewptr object = this->_callbacks[i])
+							(object->*Method)(std::forward<ClassArgs>(args)...);
+					}
+				}
+
+				if (this->_deferred) [[unlikely]]
+					this->settle();
 			}
-		public:
-			SubscriptionRecord(const SubscriptionRecord& src) = delete;
-			SubscriptionRecord& operator=(const SubscriptionRecord& src) = delete;
+			MSVC_SUPPRESS_WARNING_POP
 
-			SubscriptionRecord(DelegateT&& delegate) noexcept :
-				_delegate(std::move(delegate)),
-				_owner(nullptr)
+			// the same as .raise(...)
+			void operator()(ClassArgs...args)
 			{
+				raise(std::forward<ClassArgs>(args)...);
 			}
 
-			SubscriptionRecord(SubscriptionRecord&& src) noexcept :
-				_delegate(std::move(src._delegate)),
-				_owner(src._owner)
+			/* Subscribe @object to the MethodEvent.
+
+			The function returns a Subscription object, the same as
+			Event::subscribe(...) does. Keep this object alive for as long as
+			you need @object to be subscribed. Make sure that @object is
+			alive/valid for the lifetime of the returned Subscription object.
+
+			NDEBUG complexity:
+			* If MethodEvent has enough allocated space: O(1)
+			* Otherwise: reallocation + O(MethodEvent::count())
+			*/
+			[[nodiscard]] auto subscribe(Object& object)
 			{
-				/*src._delegate = DelegateT{};
-				src.changeOwner(nullptr);*/
+				return Subscription(this->add(&object), this);
 			}
 
-			SubscriptionRecord& operator=(SubscriptionRecord&& src) noexcept
+			[[nodiscard]] auto subscribe(Object* object)
 			{
-				if (this == &src)
-					return *this;
+				assert(object != nullptr);
+				return Subscription(this->add(std::move(object)), this);
+			}
 
-				this->_delegate = std::move(src._delegate);
-				this->changeOwner(src._owner);
+			DELETE_FUNCTION(auto subscribe(Object&&),
+							MsgNoRValueObjects)
 
-				/*src._delegate = DelegateT{};
-				src.changeOwner(nullptr);*/
+			/* Subscribe @object to the MethodEvent, see the other overload.
+			The function saves a Subscription object in @dst, the same as
+			the respective overload of Event::subscribe(...) does. */
+			template<typename VectorOfSubscriptions = std::vector<Subscription>>
+			void subscribe(Object& object,
+						   VectorOfSubscriptions& dst)
+			{
+				dst.emplace_back(this->add(&object), this);
+			}
 
-				return *this;
+			template<typename VectorOfSubscriptions = std::vector<Subscription>>
+			void subscribe(Object* object,
+						   VectorOfSubscriptions& dst)
+			{
+				assert(object != nullptr);
+				dst.emplace_back(this->add(std::move(object)), this);
 			}
 		};
 	}
+
+	/* MethodEvent is an event with a single compile-time handler: it calls
+	the member function @Method on every subscribed object.
+
+	Subscriptions store only pointers to objects and raising the event is
+	a direct loop over them, without type erasure. Otherwise, MethodEvent
+	is used exactly like Event: it returns the same Subscription objects,
+	which can be kept in the same vectors of subscriptions as those of any
+	Event.
+
+	If @Method is a const member function, const objects can be subscribed.
+
+	Adjust the size of MethodEvent's inline buffer for subscriptions by
+	specifying @ExpectedSubscriptions, see Event.
+	*/
+	template<auto Method,
+		unsigned ExpectedSubscriptions = internal::ExpectedSubscriptionsDefault>
+		requires internal::MemberFunction<decltype(Method)>
+	class MethodEvent : public internal::MethodEvent<Method, ExpectedSubscriptions,
+		typename internal::MemberFunctionDeducer<decltype(Method)>::NonmemberSignature>
+	{
+		using BaseT = internal::MethodEvent<Method, ExpectedSubscriptions,
+			typename internal::MemberFunctionDeducer<decltype(Method)>::NonmemberSignature>;
+
+	public:
+		explicit MethodEvent() : BaseT()
+		{
+		}
+
+		/* Immediately allocate memory for @expectedSubscriptions.
+		See .reserve(...) */
+		explicit MethodEvent(unsigned expectedSubscriptions) :
+			BaseT(expectedSubscriptions)
+		{
+		}
+	};
+
+	/* A callable that invokes member function @Method on an object,
+	without type erasure. Make it with callMethod<@Method>(object) */
+	template<auto Method, typename Object>
+	struct MethodCall
+	{
+		Object viewptr _object;
+
+		template<typename...Args>
+		decltype(auto) operator()(Args&&...args) const
+		{
+			return (_object->*Method)(std::forward<Args>(args)...);
+		}
+	};
+
+	template<internal::MemberFunction auto Method, internal::Class Object>
+		requires internal::MethodMatchesClass<Method, Object>
+	auto callMethod(Object& object)
+	{
+		return MethodCall<Method, Object>{ &object };
+	}
+
+	template<internal::MemberFunction auto Method, internal::Class Object>
+		requires internal::MethodMatchesClass<Method, Object>
+	auto callMethod(Object* object)
+	{
+		assert(object != nullptr);
+		return MethodCall<Method, Object>{ object };
+	}
+
+	template<internal::MemberFunction auto Method, internal::Class Object>
+	DELETE_FUNCTION(auto callMethod(Object&&),
+					MsgNoRValueObjects)
+
+	namespace internal
+	{
+		template<typename T>
+		struct TagTraits
+		{
+			constexpr static bool IsTag = false;
+		};
+
+		template<auto T>
+		struct TagTraits<tag<T>>
+		{
+			constexpr static bool IsTag = true;
+			constexpr static auto Value = T;
+		};
+
+		template<typename Callable, typename...ClassArgs>
+		constexpr bool IsStaticCallable()
+		{
+			if constexpr (TagTraits<Callable>::IsTag)
+				return std::is_invocable_r_v<void, decltype(TagTraits<Callable>::Value), ClassArgs...>;
+			else
+				return std::is_invocable_r_v<void, Callable&, ClassArgs...>;
+		}
+	}
+
+	/* StaticEvent is an event with a fixed set of subscribers known at
+	compile time. There is neither type erasure, nor subscription management:
+	.raise(...) expands to direct calls of all @Callables in the order they
+	are given, that the optimizer can fully inline.
+
+	Each callable is one of:
+	* any functor, such as a lambda, stored by value;
+	* tag<&function>() for a free function known at compile time;
+	* callMethod<&Class::method>(object) for a member function of an object.
+
+	The API of .raise(...)/operator(...) mirrors Event, so that switching
+	between Event and StaticEvent takes changing a typedef. Use
+	makeStaticEvent<Signature>(callables...) to deduce @Callables.
+	*/
+	template<typename Signature, typename...Callables>
+	class StaticEvent;
+
+	template<typename R, typename...ClassArgs, typename...Callables>
+	class StaticEvent<R(ClassArgs...), Callables...>
+	{
+		static_assert(std::same_as<R, void>, "only void return types are supported");
+		static_assert((internal::IsStaticCallable<Callables, ClassArgs...>() and ...),
+					  "Every callable of StaticEvent must be invocable with the signature of StaticEvent");
+
+		std::tuple<Callables...> _callables;
+
+		template<typename Callable>
+		static void invoke(Callable& callable, ClassArgs&...args)
+		{
+			if constexpr (internal::TagTraits<Callable>::IsTag)
+				internal::TagTraits<Callable>::Value(std::forward<ClassArgs>(args)...);
+			else
+				callable(std::forward<ClassArgs>(args)...);
+		}
+
+	public:
+		explicit StaticEvent(Callables...callables) :
+			_callables(std::move(callables)...)
+		{
+		}
+
+		/* Invoke all callables in the order they were given and pass them
+		the given arguments @args */
+		MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
+		void raise(ClassArgs...args)
+		{
+			std::apply([&](Callables&...callables)
+			{
+				(invoke(callables, args...), ...);
+			}, _callables);
+		}
+		MSVC_SUPPRESS_WARNING_POP
+
+		// the same as .raise(...)
+		void operator()(ClassArgs...args)
+		{
+			raise(std::forward<ClassArgs>(args)...);
+		}
+
+		// the number of subscribers
+		[[nodiscard]] static constexpr std::ptrdiff_t count()
+		{
+			return sizeof...(Callables);
+		}
+	};
+
+	template<typename Signature, typename...Callables>
+	auto makeStaticEvent(Callables...callables)
+	{
+		return StaticEvent<Signature, Callables...>(std::move(callables)...);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,614 @@
+/*
+* MIT License
+*
+* Copyright (c) 2023 Dmitry Kim <https://github.com/bitsbakery/callme>
+*
+* Permission is hereby  granted, free of charge, to any  person obtaining a copy
+* of this software and associated  documentation files (the "Software"), to deal
+* in the Software  without restriction, including without  limitation the rights
+* to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+* copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+* IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+* FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+* AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+* LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CallMe.h"
+
+namespace CallMe
+{
+	template<std::size_t InlineCapacity = 48>
+	class TaskPool;
+
+	/* The join counter of tasks spawned on a TaskPool: every task spawned
+	into the group increments it, and decrements it when it returns.
+	TaskPool::wait(group) returns when the counter drops to 0. A task may
+	spawn children into a group of its own and wait for them, so groups
+	nest like the calls of a recursive function.
+
+	TaskGroup is neither copyable nor movable, wait for it before it is
+	destroyed.
+	*/
+	class TaskGroup
+	{
+		template<std::size_t> friend class TaskPool;
+
+		std::atomic<std::ptrdiff_t> _pending{ 0 };
+
+	public:
+		TaskGroup() = default;
+
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		~TaskGroup()
+		{
+			assert(_pending.load(std::memory_order_relaxed) == 0 &&
+				   "wait for the tasks of a group before destroying it");
+		}
+
+		//whether all tasks spawned into the group have returned
+		[[nodiscard]] bool done() const
+		{
+			return _pending.load(std::memory_order_acquire) == 0;
+		}
+	};
+
+	namespace internal
+	{
+		/* Chase-Lev work-stealing deque of pointers, after "Correct and
+		Efficient Work-Stealing for Weak Memory Models" by Lê et al.
+
+		The owner thread pushes and pops at the bottom, other threads steal
+		from the top. The ring grows when full, the replaced rings are kept
+		until the deque is destroyed, as thieves may still read them. The
+		fences of the paper are folded into seq_cst operations. */
+		template<typename T>
+		class TaskDeque
+		{
+			struct Ring
+			{
+				std::int64_t _mask;
+				std::unique_ptr<std::atomic<T*>[]> _items;
+
+				explicit Ring(std::int64_t capacity) :
+					_mask(capacity - 1),
+					_items(new std::atomic<T*>[std::size_t(capacity)])
+				{
+				}
+
+				T* get(std::int64_t i) const
+				{
+					return _items[std::size_t(i & _mask)].load(std::memory_order_relaxed);
+				}
+
+				void put(std::int64_t i, T* item)
+				{
+					_items[std::size_t(i & _mask)].store(item, std::memory_order_relaxed);
+				}
+			};
+
+			alignas(64) std::atomic<std::int64_t> _top{ 0 };
+			alignas(64) std::atomic<std::int64_t> _bottom{ 0 };
+			std::atomic<Ring*> _ring;
+
+			//the current ring and the replaced ones, owner only
+			std::vector<std::unique_ptr<Ring>> _rings;
+
+			Ring* grow(Ring* ring, std::int64_t top, std::int64_t bottom)
+			{
+				_rings.push_back(std::make_unique<Ring>(2 * (ring->_mask + 1)));
+				Ring* grown = _rings.back().get();
+				for (std::int64_t i = top; i != bottom; ++i)
+					grown->put(i, ring->get(i));
+
+				_ring.store(grown, std::memory_order_release);
+				return grown;
+			}
+
+		public:
+			//@capacity must be a power of 2
+			explicit TaskDeque(std::int64_t capacity = 256)
+			{
+				assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+				_rings.push_back(std::make_unique<Ring>(capacity));
+				_ring.store(_rings.back().get(), std::memory_order_relaxed);
+			}
+
+			TaskDeque(const TaskDeque&) = delete;
+			TaskDeque& operator=(const TaskDeque&) = delete;
+
+			//owner only
+			void push(T* item)
+			{
+				const std::int64_t bottom = _bottom.load(std::memory_order_relaxed);
+				const std::int64_t top = _top.load(std::memory_order_acquire);
+				Ring* ring = _ring.load(std::memory_order_relaxed);
+				if (bottom - top > ring->_mask)
+					ring = grow(ring, top, bottom);
+
+				ring->put(bottom, item);
+
+				//seq_cst pairs with the check of threads going to sleep
+				_bottom.store(bottom + 1, std::memory_order_seq_cst);
+			}
+
+			//owner only, the most recently pushed item or nullptr
+			T* pop()
+			{
+				const std::int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+				Ring* ring = _ring.load(std::memory_order_relaxed);
+				_bottom.store(bottom, std::memory_order_seq_cst);
+				std::int64_t top = _top.load(std::memory_order_seq_cst);
+
+				if (top > bottom)
+				{
+					_bottom.store(bottom + 1, std::memory_order_relaxed);
+					return nullptr;
+				}
+
+				T* item = ring->get(bottom);
+				if (top == bottom)
+				{
+					//the last item, thieves may race for it
+					if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+													  std::memory_order_relaxed))
+						item = nullptr;
+					_bottom.store(bottom + 1, std::memory_order_relaxed);
+				}
+				return item;
+			}
+
+			/* any thread, the least recently pushed item, nullptr if there is
+			none or if another thread took it first */
+			T* steal()
+			{
+				std::int64_t top = _top.load(std::memory_order_seq_cst);
+				const std::int64_t bottom = _bottom.load(std::memory_order_seq_cst);
+				if (top >= bottom)
+					return nullptr;
+
+				T* item = _ring.load(std::memory_order_acquire)->get(top);
+				if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+												  std::memory_order_relaxed))
+					return nullptr;
+				return item;
+			}
+
+			[[nodiscard]] bool empty() const
+			{
+				return _top.load(std::memory_order_seq_cst) >= _bottom.load(std::memory_order_seq_cst);
+			}
+		};
+	}
+
+	/* A pool of worker threads that run tasks, for fork-join parallelism
+	and jobs of many small tasks.
+
+	A task is OwningDelegate<void(), @InlineCapacity>: functors of up to
+	@InlineCapacity bytes are stored inline, without allocating. The task
+	records are recycled through free lists, so a pool that has run its
+	peak number of concurrent tasks doesn't allocate anymore.
+
+	Every worker pushes and pops the tasks it spawns at the bottom of its
+	own Chase-Lev deque, without locks, and steals from the top of the
+	deques of the others when its own is empty. Threads other than the
+	workers borrow an extra deque while spawning or waiting, if another
+	thread holds it, they fall back to a list under a mutex.
+
+	.wait(group) runs tasks until the group is done, so waiting inside a
+	task doesn't block a worker, and the calling thread helps the workers.
+	Idle workers, and waiting threads that find no task to run, sleep in
+	std::atomic::wait(), i.e. on a futex on Linux.
+
+	Tasks must not throw. TaskPool is neither copyable nor movable, wait
+	for all groups before destroying it.
+	*/
+	template<std::size_t InlineCapacity>
+	class TaskPool
+	{
+	public:
+		using TaskT = OwningDelegate<void(), InlineCapacity>;
+
+	private:
+		//a spawned task, or a free record linked by _next
+		struct Task
+		{
+			TaskT _work;
+			TaskGroup* _group = nullptr;
+			Task* _next = nullptr;
+		};
+
+		//a worker, or the thread that borrows the extra deque
+		struct alignas(64) Participant
+		{
+			internal::TaskDeque<Task> _deque;
+
+			//the free task records of the participant
+			Task* _free = nullptr;
+			std::size_t _nFree = 0;
+
+			TaskPool* _pool = nullptr;
+		};
+
+		//task records are allocated this many at a time
+		static constexpr std::size_t SlabSize = 256;
+
+		//a participant keeps at most this many free records for itself
+		static constexpr std::size_t MaxFree = 4 * SlabSize;
+
+		//the participant of the current thread, if any
+		static inline thread_local Participant* _current = nullptr;
+
+		//[0] is the extra deque, then a participant per worker
+		std::unique_ptr<Participant[]> _participants;
+		std::size_t _nParticipants;
+		std::vector<std::thread> _workers;
+
+		//true while a thread other than the workers holds the extra deque
+		std::atomic<bool> _borrowed{ false };
+
+		//guards the following members
+		std::mutex _sharedMutex;
+		std::vector<Task*> _injected;
+		Task* _sharedFree = nullptr;
+		std::vector<std::unique_ptr<Task[]>> _slabs;
+
+		std::atomic<std::size_t> _nInjected{ 0 };
+
+		//idle workers and waiting threads sleep until it changes
+		alignas(64) std::atomic<std::uint32_t> _signal{ 0 };
+		std::atomic<std::uint32_t> _sleepers{ 0 };
+
+		//the threads that sleep waiting for a group
+		std::atomic<std::uint32_t> _joiners{ 0 };
+
+		//a wake-up is in flight, further spawns don't need to notify
+		std::atomic<bool> _waking{ false };
+
+		std::atomic<bool> _stop{ false };
+
+		//link a new slab of records to @free, _sharedMutex must be locked
+		Task* allocateSlab(Task* free)
+		{
+			_slabs.push_back(std::make_unique<Task[]>(SlabSize));
+			Task* slab = _slabs.back().get();
+			for (std::size_t i = 0; i != SlabSize; ++i)
+			{
+				slab[i]._next = free;
+				free = &slab[i];
+			}
+			return free;
+		}
+
+		Task* allocate(Participant& p)
+		{
+			if (p._free == nullptr)
+			{
+				std::lock_guard lock(_sharedMutex);
+				if (_sharedFree == nullptr)
+					_sharedFree = allocateSlab(nullptr);
+
+				//take at most a slab
+				p._free = _sharedFree;
+				Task* last = _sharedFree;
+				p._nFree = 1;
+				while (last->_next != nullptr && p._nFree != SlabSize)
+				{
+					last = last->_next;
+					++p._nFree;
+				}
+				_sharedFree = last->_next;
+				last->_next = nullptr;
+			}
+
+			Task* task = p._free;
+			p._free = task->_next;
+			--p._nFree;
+			return task;
+		}
+
+		/* return @task to the free records of @p, or to the shared ones if
+		@p is nullptr. A participant that frees more than it allocates,
+		e.g. a thief, passes half of its records on. */
+		void recycle(Participant* p, Task* task)
+		{
+			if (p == nullptr)
+			{
+				std::lock_guard lock(_sharedMutex);
+				task->_next = _sharedFree;
+				_sharedFree = task;
+				return;
+			}
+
+			task->_next = p->_free;
+			p->_free = task;
+			if (++p->_nFree <= MaxFree)
+				return;
+
+			Task* last = p->_free;
+			for (std::size_t i = 1; i != MaxFree / 2; ++i)
+				last = last->_next;
+
+			std::lock_guard lock(_sharedMutex);
+			Task* passed = p->_free;
+			p->_free = last->_next;
+			p->_nFree -= MaxFree / 2;
+			last->_next = _sharedFree;
+			_sharedFree = passed;
+		}
+
+		//the participant of the current thread in this pool
+		Participant* current() const
+		{
+			return _current != nullptr && _current->_pool == this ? _current : nullptr;
+		}
+
+		void wakeOne()
+		{
+			if (_sleepers.load(std::memory_order_seq_cst) != 0 &&
+				!_waking.exchange(true, std::memory_order_acq_rel))
+			{
+				_signal.fetch_add(1, std::memory_order_release);
+				_signal.notify_one();
+			}
+		}
+
+		bool hasTasks() const
+		{
+			if (_nInjected.load(std::memory_order_seq_cst) != 0)
+				return true;
+
+			for (std::size_t i = 0; i != _nParticipants; ++i)
+			{
+				if (!_participants[i]._deque.empty())
+					return true;
+			}
+			return false;
+		}
+
+		//a task for @p to run: its own, an injected or a stolen one
+		Task* find(Participant* p)
+		{
+			if (p != nullptr)
+			{
+				if (Task* task = p->_deque.pop())
+					return task;
+			}
+
+			if (_nInjected.load(std::memory_order_relaxed) != 0)
+			{
+				std::lock_guard lock(_sharedMutex);
+				if (!_injected.empty())
+				{
+					Task* task = _injected.back();
+					_injected.pop_back();
+					_nInjected.fetch_sub(1, std::memory_order_relaxed);
+					return task;
+				}
+			}
+
+			const std::size_t self = p != nullptr ? std::size_t(p - _participants.get()) : 0;
+			for (std::size_t i = 1; i <= _nParticipants; ++i)
+			{
+				Participant& victim = _participants[(self + i) % _nParticipants];
+				if (&victim == p)
+					continue;
+
+				if (Task* task = victim._deque.steal())
+				{
+					//there may be more to steal, let another sleeper look
+					wakeOne();
+					return task;
+				}
+			}
+			return nullptr;
+		}
+
+		void run(Participant* p, Task* task)
+		{
+			task->_work.invoke();
+
+			//the captures are destroyed before the group learns that the task is done
+			TaskGroup* group = task->_group;
+			task->_work = TaskT();
+			recycle(p, task);
+
+			if (group->_pending.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+				_joiners.load(std::memory_order_seq_cst) != 0)
+			{
+				_signal.fetch_add(1, std::memory_order_release);
+				_signal.notify_all();
+			}
+		}
+
+		/* Sleep until _signal changes, unless @ready() after registering as
+		a sleeper. Returns whether to stop. */
+		template<typename Ready>
+		bool sleep(Ready&& ready)
+		{
+			const std::uint32_t signal = _signal.load(std::memory_order_acquire);
+			_sleepers.fetch_add(1, std::memory_order_seq_cst);
+
+			const bool stop = _stop.load(std::memory_order_seq_cst);
+			if (!stop && !ready() && !hasTasks())
+				_signal.wait(signal, std::memory_order_acquire);
+
+			_sleepers.fetch_sub(1, std::memory_order_seq_cst);
+			_waking.store(false, std::memory_order_release);
+			return stop;
+		}
+
+		void work(std::size_t index)
+		{
+			Participant* self = &_participants[index];
+			_current = self;
+
+			for (;;)
+			{
+				Task* task = find(self);
+
+				//new tasks often follow shortly, look a few more times before sleeping
+				for (int spin = 0; task == nullptr && spin != 16; ++spin)
+				{
+					std::this_thread::yield();
+					task = find(self);
+				}
+
+				if (task != nullptr)
+					run(self, task);
+				else if (sleep([] { return false; }))
+					return;
+			}
+		}
+
+	public:
+		//by default, a worker per hardware thread except the calling one
+		explicit TaskPool(std::size_t nWorkers =
+							  std::max(std::thread::hardware_concurrency(), 1u) - 1) :
+			_participants(new Participant[nWorkers + 1]),
+			_nParticipants(nWorkers + 1)
+		{
+			for (std::size_t i = 0; i != _nParticipants; ++i)
+				_participants[i]._pool = this;
+
+			_workers.reserve(nWorkers);
+			for (std::size_t w = 0; w != nWorkers; ++w)
+				_workers.emplace_back([this, w] { work(w + 1); });
+		}
+
+		TaskPool(const TaskPool&) = delete;
+		TaskPool& operator=(const TaskPool&) = delete;
+
+		~TaskPool()
+		{
+			assert(!hasTasks() && "wait for all groups before destroying TaskPool");
+
+			_stop.store(true, std::memory_order_seq_cst);
+			_signal.fetch_add(1, std::memory_order_release);
+			_signal.notify_all();
+
+			for (std::thread& w : _workers)
+				w.join();
+		}
+
+		[[nodiscard]] std::size_t workers() const
+		{
+			return _workers.size();
+		}
+
+		/* Spawn @task into @group, to be run by a worker or by a thread
+		waiting for a group.
+
+		NDEBUG complexity: amortized O(1). Allocation-free for tasks that
+		fit the inline storage, once the pool has run its peak number of
+		concurrent tasks. */
+		void spawn(TaskGroup& group, TaskT task)
+		{
+			group._pending.fetch_add(1, std::memory_order_relaxed);
+
+			Participant* p = current();
+			const bool borrowed = p == nullptr && !_borrowed.exchange(true, std::memory_order_acquire);
+			if (borrowed)
+				p = &_participants[0];
+
+			if (p != nullptr)
+			{
+				Task* record = allocate(*p);
+				record->_work = std::move(task);
+				record->_group = &group;
+				p->_deque.push(record);
+
+				if (borrowed)
+					_borrowed.store(false, std::memory_order_release);
+			}
+			else
+			{
+				std::lock_guard lock(_sharedMutex);
+				if (_sharedFree == nullptr)
+					_sharedFree = allocateSlab(nullptr);
+
+				Task* record = _sharedFree;
+				_sharedFree = record->_next;
+				record->_work = std::move(task);
+				record->_group = &group;
+				_injected.push_back(record);
+				_nInjected.fetch_add(1, std::memory_order_seq_cst);
+			}
+
+			wakeOne();
+		}
+
+		/* Spawn @functor constructed in the task, see the other overload
+		and OwningDelegate::make(...) */
+		template<typename Functor>
+			requires (not std::is_same_v<std::remove_cvref_t<Functor>, TaskT>) and
+					 requires(Functor&& functor) { TaskT::make(std::forward<Functor>(functor)); }
+		void spawn(TaskGroup& group, Functor&& functor)
+		{
+			spawn(group, TaskT::make(std::forward<Functor>(functor)));
+		}
+
+		/* Run tasks until all tasks of @group have returned, sleep if there
+		are no tasks to run. Call from any thread, including from tasks. */
+		void wait(TaskGroup& group)
+		{
+			Participant* p = current();
+			Participant* const previous = _current;
+			const bool borrowed = p == nullptr && !_borrowed.exchange(true, std::memory_order_acquire);
+			if (borrowed)
+			{
+				p = &_participants[0];
+				_current = p;
+			}
+
+			while (group._pending.load(std::memory_order_acquire) != 0)
+			{
+				if (Task* task = find(p))
+				{
+					run(p, task);
+					continue;
+				}
+
+				std::this_thread::yield();
+				if (group._pending.load(std::memory_order_acquire) == 0)
+					break;
+
+				_joiners.fetch_add(1, std::memory_order_seq_cst);
+				sleep([&group] { return group._pending.load(std::memory_order_seq_cst) == 0; });
+				_joiners.fetch_sub(1, std::memory_order_relaxed);
+			}
+
+			if (borrowed)
+			{
+				_current = previous;
+				_borrowed.store(false, std::memory_order_release);
+			}
+		}
+	};
+}
@@ -0,0 +1,727 @@
+/*
+* MIT License
+*
+* Copyright (c) 2023 Dmitry Kim <https://github.com/bitsbakery/callme>
+*
+* Permission is hereby  granted, free of charge, to any  person obtaining a copy
+* of this software and associated  documentation files (the "Software"), to deal
+* in the Software  without restriction, including without  limitation the rights
+* to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+* copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+* IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+* FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+* AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+* LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CallMe.Event.h"
+
+namespace CallMe
+{
+	class Timer;
+
+	/* The clock of TimerWheel, e.g. std::chrono::steady_clock. The clock
+	is stored in TimerWheel, so it may have state, e.g. a manual clock
+	advanced by tests for deterministic expiry. */
+	template<typename T>
+	concept TimerClock = requires(T & clock)
+	{
+		typename T::duration;
+		typename T::time_point;
+		{ clock.now() } -> std::convertible_to<typename T::time_point>;
+	} and std::is_integral_v<typename T::duration::rep>;
+
+	namespace internal
+	{
+		//the index of a timer record in TimerWheel
+		using TimerIndex = std::uint32_t;
+
+		//Clock-erased timer wheel interface for Timer
+		class ErasedTimerWheel
+		{
+		public:
+			virtual ~ErasedTimerWheel() = default;
+
+			virtual void cancel(TimerIndex toCancel) = 0;
+			virtual void changeOwner(TimerIndex toChange, Timer viewptr newOwner) = 0;
+		};
+
+		/* Access to the internals of Timer for timer wheels. The functions
+		are defined after Timer, so that wheels can use them before Timer
+		is complete */
+		struct TimerAccess
+		{
+			static void releaseOwnership(Timer viewptr timer);
+		};
+	}
+
+	/* RAII-wrapper for managing the lifetime of a scheduled timer, the same
+	way Subscription does for a subscription. Destroying a scheduled Timer
+	cancels it.
+
+	A Timer is "scheduled" until its callback is invoked or the timer is
+	cancelled. Moved-from timers and timers of a destroyed TimerWheel are
+	not scheduled.
+	*/
+	class Timer
+	{
+		friend struct internal::TimerAccess;
+
+		//the index of the owned timer record
+		internal::TimerIndex _index;
+
+		/* whenever _wheel != nullptr, the timer owns the respective timer
+		record of the wheel */
+		internal::ErasedTimerWheel viewptr _wheel;
+
+		void releaseOwnership()
+		{
+			_wheel = nullptr;
+		}
+
+	public:
+		DELETE_FUNCTION(Timer(),
+						"For optional timers, use std::optional<Timer>")
+
+		//only for internal use
+		Timer(internal::TimerIndex index,
+			  internal::ErasedTimerWheel viewptr wheel) noexcept :
+			_index(index),
+			_wheel(wheel)
+		{
+			_wheel->changeOwner(_index, this);
+		}
+
+		/* Cancel the timer if it is still scheduled.
+		NDEBUG complexity: O(1) */
+		~Timer()
+		{
+			cancel();
+		}
+
+		Timer(const Timer& src)            = delete;
+		Timer& operator=(const Timer& src) = delete;
+
+		Timer(Timer&& src) noexcept :
+			_index(src._index),
+			_wheel(src._wheel)
+		{
+			if (_wheel)
+			{
+				_wheel->changeOwner(_index, this);
+				src.releaseOwnership();
+			}
+		}
+
+		Timer& operator=(Timer&& src) noexcept
+		{
+			if (this == &src)
+				return *this;
+
+			cancel();
+
+			if (src._wheel)
+			{
+				//[this] acquires ownership of the src's timer record
+				_index = src._index;
+				_wheel = src._wheel;
+				_wheel->changeOwner(_index, this);
+				src.releaseOwnership();
+			}
+
+			return *this;
+		}
+
+		/* Cancel the timer, its callback won't be invoked. Does nothing if
+		the timer is not scheduled.
+		NDEBUG complexity: O(1) */
+		void cancel()
+		{
+			if (_wheel)
+			{
+				_wheel->cancel(_index);
+				releaseOwnership();
+			}
+		}
+
+		//whether the callback of the timer is still to be invoked
+		[[nodiscard]] bool scheduled() const
+		{
+			return _wheel != nullptr;
+		}
+	};
+
+	namespace internal
+	{
+		inline void TimerAccess::releaseOwnership(Timer viewptr timer)
+		{
+			timer->releaseOwnership();
+		}
+	}
+
+	/* TimerWheel schedules callbacks to be invoked after a delay. Time is
+	counted in ticks of @resolution, .advance() reads @Clock and invokes the
+	callbacks of all timers that have expired since the previous call, on
+	the calling thread. A timer never expires early, it expires at the first
+	.advance() at or after its time, rounded up to a tick.
+
+	The callbacks are @DelegateT objects, non-owning Delegate<void()> by
+	default, use OwningDelegate<void()> to let timers own their targets.
+	They are stored in the timer records of the wheel, that are reused
+	after timers expire or are cancelled, so a wheel that has grown to its
+	peak number of timers doesn't allocate anymore, see also .reserve(...).
+
+	The wheel is hierarchical: 6 levels of 64 slots, every slot is a vector
+	of the indices of its timer records, every record knows its position in
+	the slot, so that cancelling is swap-and-pop. Unlike linked lists, the
+	records of a slot are then read independently of each other, which
+	matters when a slot of scattered records expires or is redistributed.
+	The slots, like the records, keep their memory. Level 0 holds the timers
+	of the next 64 ticks, a slot per tick, level 1 the next 64^2 ticks, 64
+	ticks per slot, and so on. Every 64 ticks the next slot of level 1 is
+	redistributed to level 0, every 64^2 ticks the next slot of level 2 to
+	level 1 and level 0, etc. Timers further than 64^6 ticks ahead wait in
+	level 5 and are redistributed until their time comes.
+
+	Schedule and cancel are O(1). Expiry is O(1) per timer plus the
+	redistribution, at most once per level per timer. .advance() jumps over
+	the ticks that have nothing to do, so rare calls and long idle periods
+	are cheap.
+
+	Callbacks may schedule and cancel timers, including the timers expiring
+	in the same .advance(), but must not call .advance() of the same wheel.
+
+	TimerWheel is neither copyable nor movable, it must outlive neither its
+	timers nor its @Clock state. TimerWheel is not thread-safe.
+	*/
+	template<TimerClock Clock = std::chrono::steady_clock,
+		typename DelegateT = Delegate<void()>>
+	class TimerWheel final : public internal::ErasedTimerWheel
+	{
+	public:
+		using TimePoint = typename Clock::time_point;
+		using Duration = typename Clock::duration;
+		using Callback = DelegateT;
+
+	private:
+		static constexpr unsigned SlotBits = 6;
+		static constexpr unsigned Slots = 1u << SlotBits;
+		static constexpr std::uint64_t SlotMask = Slots - 1;
+		static constexpr unsigned Levels = 6;
+
+		//timers further ahead wait in the last level
+		static constexpr std::uint64_t MaxDelta = (std::uint64_t(1) << (SlotBits * Levels)) - 1;
+
+		static constexpr internal::TimerIndex Nil = std::numeric_limits<internal::TimerIndex>::max();
+
+		//a scheduled timer or a free record
+		struct Record
+		{
+			DelegateT _callback;
+			std::uint64_t _expiry;
+
+			//nullptr for free records
+			Timer viewptr _owner;
+
+			//level * Slots + the slot within the level
+			unsigned _slot;
+
+			//the position in the slot, the next free record for free records
+			internal::TimerIndex _position;
+		};
+
+		std::vector<Record> _records;
+		internal::TimerIndex _free = Nil;
+		std::size_t _count = 0;
+
+		std::array<std::vector<internal::TimerIndex>, Levels * Slots> _slots;
+
+		/* the level-0 slot of the tick being processed, taken out of the
+		wheel, so that timers scheduled by the callbacks 64 ticks ahead go
+		to the emptied slot rather than expire with this batch */
+		std::vector<internal::TimerIndex> _expiring;
+
+		//a bit per non-empty slot, per level
+		std::array<std::uint64_t, Levels> _occupied{};
+
+		[[no_unique_address]] Clock _clock;
+		TimePoint _origin;
+		Duration _resolution;
+
+		//the last tick processed by .advance()
+		std::uint64_t _tick = 0;
+
+		#ifndef NDEBUG
+		bool _advancing = false;
+		#endif
+
+		//the number of ticks from _origin to @time, rounded down or up
+		[[nodiscard]] std::uint64_t ticksTo(TimePoint time, bool roundUp) const
+		{
+			const Duration elapsed = time - _origin;
+			if (elapsed <= Duration::zero())
+				return 0;
+
+			std::uint64_t ticks = std::uint64_t(elapsed / _resolution);
+			if (roundUp && elapsed % _resolution != Duration::zero())
+				++ticks;
+			return ticks;
+		}
+
+		/* add record @i to the slot of its expiry relative to the next
+		tick, _expiry must be after _tick */
+		void link(internal::TimerIndex i)
+		{
+			Record& record = _records[i];
+			assert(record._expiry > _tick);
+
+			const std::uint64_t delta = std::min(record._expiry - (_tick + 1), MaxDelta);
+			const unsigned level = delta < Slots ? 0 : unsigned(std::bit_width(delta) - 1) / SlotBits;
+			const unsigned inLevel = unsigned(((_tick + 1 + delta) >> (SlotBits * level)) & SlotMask);
+
+			std::vector<internal::TimerIndex>& timers = _slots[level * Slots + inLevel];
+			record._slot = level * Slots + inLevel;
+			record._position = internal::TimerIndex(timers.size());
+			timers.push_back(i);
+			_occupied[level] |= std::uint64_t(1) << inLevel;
+		}
+
+		//remove record @i from its slot, the last timer of the slot takes its place
+		void unlink(internal::TimerIndex i)
+		{
+			const Record& record = _records[i];
+
+			//only the timers being expired are due at the processed tick
+			const bool expiring = record._expiry == _tick;
+			std::vector<internal::TimerIndex>& timers = expiring ? _expiring : _slots[record._slot];
+
+			const internal::TimerIndex last = timers.back();
+			timers[record._position] = last;
+			_records[last]._position = record._position;
+			timers.pop_back();
+
+			if (timers.empty() && !expiring)
+				_occupied[record._slot / Slots] &= ~(std::uint64_t(1) << (record._slot & SlotMask));
+		}
+
+		void release(internal::TimerIndex i)
+		{
+			Record& record = _records[i];
+			record._owner = nullptr;
+			record._position = _free;
+			_free = i;
+			--_count;
+		}
+
+		/* move the timers of @slot of a level above 0 to the lower levels,
+		they never return to @slot itself */
+		void redistribute(unsigned slot)
+		{
+			std::vector<internal::TimerIndex>& timers = _slots[slot];
+			if (timers.empty())
+				return;
+
+			for (internal::TimerIndex i : timers)
+			{
+				link(i);
+				assert(_records[i]._slot != slot);
+			}
+
+			timers.clear();
+			_occupied[slot / Slots] &= ~(std::uint64_t(1) << (slot & SlotMask));
+		}
+
+		/* the first tick after _tick that expires timers of level 0 or
+		redistributes timers of a higher level, there must be timers */
+		[[nodiscard]] std::uint64_t nextBusyTick() const
+		{
+			assert(_count != 0);
+
+			std::uint64_t busy = std::numeric_limits<std::uint64_t>::max();
+			if (_occupied[0] != 0)
+			{
+				const std::uint64_t ahead = std::rotr(_occupied[0], int((_tick + 1) & SlotMask));
+				busy = _tick + 1 + std::uint64_t(std::countr_zero(ahead));
+			}
+
+			//the slots of level L are redistributed at the multiples of 64^L
+			for (unsigned level = 1; level != Levels; ++level)
+			{
+				if (_occupied[level] == 0)
+					continue;
+
+				const unsigned shift = SlotBits * level;
+				const std::uint64_t boundary = ((_tick >> shift) + 1) << shift;
+				const std::uint64_t ahead = std::rotr(_occupied[level], int((boundary >> shift) & SlotMask));
+				busy = std::min(busy, boundary + (std::uint64_t(std::countr_zero(ahead)) << shift));
+			}
+			return busy;
+		}
+
+		//process tick @tick == _tick + 1, return the number of expired timers
+		std::size_t step(std::uint64_t tick)
+		{
+			assert(tick == _tick + 1);
+
+			//the timers of the higher levels that are due in the next 64 ticks
+			if ((tick & SlotMask) == 0)
+			{
+				for (unsigned level = 1; level != Levels; ++level)
+				{
+					const unsigned inLevel = unsigned((tick >> (SlotBits * level)) & SlotMask);
+					redistribute(level * Slots + inLevel);
+					if (inLevel != 0)
+						break;
+				}
+			}
+
+			/* The slot is taken out and processed as a batch from the back:
+			timers scheduled by the callbacks expire at later ticks, even
+			those that go to the same slot, and timers of the batch cancelled
+			by the callbacks are replaced with the last ones */
+			_tick = tick;
+			assert(_expiring.empty());
+			_expiring.swap(_slots[tick & SlotMask]);
+			_occupied[0] &= ~(std::uint64_t(1) << (tick & SlotMask));
+
+			std::size_t expired = 0;
+			while (!_expiring.empty())
+			{
+				const internal::TimerIndex i = _expiring.back();
+				Record& record = _records[i];
+				assert(record._expiry == tick);
+
+				_expiring.pop_back();
+				internal::TimerAccess::releaseOwnership(record._owner);
+				DelegateT callback = std::move(record._callback);
+				release(i);
+
+				callback.invoke();
+				++expired;
+			}
+			return expired;
+		}
+
+		void cancel(internal::TimerIndex toCancel) override
+		{
+			assert(_records[toCancel]._owner != nullptr);
+
+			unlink(toCancel);
+			_records[toCancel]._callback = DelegateT();
+			release(toCancel);
+		}
+
+		void changeOwner(internal::TimerIndex toChange, Timer viewptr newOwner) override
+		{
+			assert(_records[toChange]._owner != nullptr || newOwner != nullptr);
+			_records[toChange]._owner = newOwner;
+		}
+
+	public:
+		/* Count time in ticks of @resolution from @clock.now().
+		@resolution must be positive. */
+		explicit TimerWheel(Duration resolution, Clock clock = Clock()) :
+			_clock(std::move(clock)),
+			_origin(_clock.now()),
+			_resolution(resolution)
+		{
+			assert(resolution > Duration::zero());
+		}
+
+		TimerWheel(const TimerWheel&) = delete;
+		TimerWheel& operator=(const TimerWheel&) = delete;
+
+		//detaches the timers that are still scheduled, see Timer
+		~TimerWheel()
+		{
+			for (Record& record : _records)
+			{
+				if (record._owner != nullptr)
+					internal::TimerAccess::releaseOwnership(record._owner);
+			}
+		}
+
+		/* Schedule @callback to be invoked by the first .advance() at or
+		after @time.
+
+		NDEBUG complexity: amortized O(1), allocation-free if there is a
+		free timer record, see .reserve(...) */
+		[[nodiscard]] Timer scheduleAt(TimePoint time, DelegateT callback)
+		{
+			const std::uint64_t expiry = std::max(ticksTo(time, true), _tick + 1);
+
+			internal::TimerIndex i = _free;
+			if (i != Nil)
+			{
+				_free = _records[i]._position;
+				_records[i]._callback = std::move(callback);
+				_records[i]._expiry = expiry;
+			}
+			else
+			{
+				assert(_records.size() < Nil && "too many timers");
+				i = internal::TimerIndex(_records.size());
+				_records.push_back(Record{ std::move(callback), expiry, nullptr, 0, 0 });
+			}
+
+			link(i);
+			++_count;
+			return Timer(i, this);
+		}
+
+		/* Schedule @callback to be invoked by the first .advance() at least
+		@delay after now.
+		NDEBUG complexity: the same as .scheduleAt(...) */
+		[[nodiscard]] Timer schedule(Duration delay, DelegateT callback)
+		{
+			return scheduleAt(TimePoint(_clock.now()) + delay, std::move(callback));
+		}
+
+		/* Invoke the callbacks of the timers expired by now, in the order of
+		their expiry ticks, and return the number of invoked callbacks. The
+		order of the timers expiring on the same tick is unspecified.
+
+		NDEBUG complexity: O(expired timers + redistributed timers), plus
+		O(1) per tick that expires or redistributes timers */
+		std::size_t advance()
+		{
+			assert(!_advancing && "advance() of a wheel cannot be nested");
+			#ifndef NDEBUG
+			_advancing = true;
+			#endif
+
+			const std::uint64_t target = ticksTo(_clock.now(), false);
+			std::size_t expired = 0;
+			while (_tick < target)
+			{
+				//skip the ticks that neither expire nor redistribute timers
+				const std::uint64_t next = _count != 0 ? nextBusyTick() : target + 1;
+				if (next > target)
+				{
+					_tick = target;
+					break;
+				}
+
+				_tick = next - 1;
+				expired += step(next);
+			}
+
+			#ifndef NDEBUG
+			_advancing = false;
+			#endif
+			return expired;
+		}
+
+		//the number of scheduled timers
+		[[nodiscard]] std::size_t count() const
+		{
+			return _count;
+		}
+
+		[[nodiscard]] bool empty() const
+		{
+			return _count == 0;
+		}
+
+		//allocate timer records for @timers scheduled timers
+		void reserve(std::size_t timers)
+		{
+			_records.reserve(timers);
+		}
+
+		[[nodiscard]] Duration resolution() const
+		{
+			return _resolution;
+		}
+
+		[[nodiscard]] Clock& clock()
+		{
+			return _clock;
+		}
+	};
+
+	namespace internal
+	{
+		/* a timer callback of type @DelegateT that invokes @Method of @object
+		without owning @object */
+		template<typename DelegateT, auto Method, typename Object>
+		DelegateT timerCallback(Object viewptr object)
+		{
+			if constexpr (requires { DelegateT::make(callMethod<Method>(object)); })
+				return DelegateT::make(callMethod<Method>(object));
+			else
+				return DelegateT(object, tag<Method>());
+		}
+
+		template<typename Wheel, typename Reducer, typename Signature>
+		class DebouncedEvent;
+
+		template<typename Wheel, typename Reducer, typename R, typename...ClassArgs>
+		class DebouncedEvent<Wheel, Reducer, R(ClassArgs...)> :
+			public CoalescingEvent<Reducer, ExpectedSubscriptionsDefault, DispatchOrder::Unspecified,
+								   EventStorage::BackPointers, R(ClassArgs...)>
+		{
+			using BaseT = CoalescingEvent<Reducer, ExpectedSubscriptionsDefault, DispatchOrder::Unspecified,
+										  EventStorage::BackPointers, R(ClassArgs...)>;
+
+			Wheel viewptr _wheel;
+			typename Wheel::Duration _quiet;
+			std::optional<Timer> _timer;
+
+			void expire()
+			{
+				_timer.reset();
+				this->flush();
+			}
+
+		public:
+			explicit DebouncedEvent(Wheel& wheel, typename Wheel::Duration quiet,
+									Reducer reducer = Reducer()) :
+				BaseT(std::move(reducer)),
+				_wheel(&wheel),
+				_quiet(quiet)
+			{
+			}
+
+			DebouncedEvent(DebouncedEvent&&) = delete;
+			DebouncedEvent& operator=(DebouncedEvent&&) = delete;
+
+			/* Post a raise with @args, see CoalescingEvent::post(...), and
+			restart the quiet period. The pending notification is raised once
+			no raise has been posted for the quiet period.
+
+			NDEBUG complexity: O(1) plus the reducer */
+			template<typename...Args>
+				requires requires(BaseT& event, Args&&...args) { event.post(std::forward<Args>(args)...); }
+			void post(Args&&...args)
+			{
+				BaseT::post(std::forward<Args>(args)...);
+				_timer = _wheel->schedule(_quiet,
+					timerCallback<typename Wheel::Callback, &DebouncedEvent::expire>(this));
+			}
+		};
+
+		template<typename Wheel, typename Reducer, typename Signature>
+		class ThrottledEvent;
+
+		template<typename Wheel, typename Reducer, typename R, typename...ClassArgs>
+		class ThrottledEvent<Wheel, Reducer, R(ClassArgs...)> :
+			public CoalescingEvent<Reducer, ExpectedSubscriptionsDefault, DispatchOrder::Unspecified,
+								   EventStorage::BackPointers, R(ClassArgs...)>
+		{
+			using BaseT = CoalescingEvent<Reducer, ExpectedSubscriptionsDefault, DispatchOrder::Unspecified,
+										  EventStorage::BackPointers, R(ClassArgs...)>;
+
+			Wheel viewptr _wheel;
+			typename Wheel::Duration _interval;
+
+			//scheduled while raises are throttled
+			std::optional<Timer> _timer;
+
+			void throttle()
+			{
+				_timer = _wheel->schedule(_interval,
+					timerCallback<typename Wheel::Callback, &ThrottledEvent::expire>(this));
+			}
+
+			void expire()
+			{
+				_timer.reset();
+				if (this->pending())
+				{
+					throttle();
+					this->flush();
+				}
+			}
+
+		public:
+			explicit ThrottledEvent(Wheel& wheel, typename Wheel::Duration interval,
+									Reducer reducer = Reducer()) :
+				BaseT(std::move(reducer)),
+				_wheel(&wheel),
+				_interval(interval)
+			{
+			}
+
+			ThrottledEvent(ThrottledEvent&&) = delete;
+			ThrottledEvent& operator=(ThrottledEvent&&) = delete;
+
+			/* Raise the event with @args right away, unless it was raised less
+			than the interval ago. Otherwise post the raise, see
+			CoalescingEvent::post(...), the pending notification is raised
+			when the interval ends.
+
+			NDEBUG complexity: the same as .raise(...) or O(1) plus the reducer */
+			template<typename...Args>
+				requires requires(BaseT& event, Args&&...args) { event.post(std::forward<Args>(args)...); }
+			void post(Args&&...args)
+			{
+				if (_timer)
+					BaseT::post(std::forward<Args>(args)...);
+				else
+				{
+					throttle();
+					this->raise(std::forward<Args>(args)...);
+				}
+			}
+		};
+	}
+
+	/* DebouncedEvent is a CoalescingEvent flushed by a timer: raises posted
+	with .post(...) are collapsed and raised once, after no raise has been
+	posted for the quiet period, e.g. to react to the end of a burst of
+	keystrokes or resizes. The timer runs on @Wheel, so the notification is
+	raised from Wheel::advance().
+
+	DebouncedEvent is neither copyable nor movable, @Wheel must outlive it.
+	*/
+	template<typename Signature = void(), typename Wheel = TimerWheel<>,
+		typename Reducer = reducers::Latest>
+	class DebouncedEvent : public internal::DebouncedEvent<Wheel, Reducer, Signature>
+	{
+	public:
+		using internal::DebouncedEvent<Wheel, Reducer, Signature>::DebouncedEvent;
+	};
+
+	/* ThrottledEvent raises at most once per interval: the first raise posted
+	with .post(...) is raised right away, the raises posted during the
+	following interval are collapsed and raised when the interval ends, see
+	CoalescingEvent, which starts the next interval. The timer runs on
+	@Wheel, so the trailing notifications are raised from Wheel::advance().
+
+	ThrottledEvent is neither copyable nor movable, @Wheel must outlive it.
+	*/
+	template<typename Signature = void(), typename Wheel = TimerWheel<>,
+		typename Reducer = reducers::Latest>
+	class ThrottledEvent : public internal::ThrottledEvent<Wheel, Reducer, Signature>
+	{
+	public:
+		using internal::ThrottledEvent<Wheel, Reducer, Signature>::ThrottledEvent;
+	};
+}
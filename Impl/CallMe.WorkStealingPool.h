@@ -0,0 +1,272 @@
+/*
+* MIT License
+*
+* Copyright (c) 2023 Dmitry Kim <https://github.com/bitsbakery/callme>
+*
+* Permission is hereby  granted, free of charge, to any  person obtaining a copy
+* of this software and associated  documentation files (the "Software"), to deal
+* in the Software  without restriction, including without  limitation the rights
+* to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+* copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+* IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+* FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+* AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+* LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CallMe.Event.h"
+
+namespace CallMe
+{
+	/* A pool of threads that run chunks of index ranges in parallel,
+	the executor of Event::raiseParallel(...).
+
+	.parallelFor(...) splits the range into a contiguous part of chunks per
+	participant, the calling thread and the workers. A participant takes
+	chunks from the front of its own part, and once it is empty, steals
+	the back half of the part of another participant. So the threads
+	synchronize only when they steal, and unequal chunks are balanced.
+
+	Idle workers sleep in std::atomic::wait(). One .parallelFor(...) runs at
+	a time, a concurrent or nested call runs its chunks on the calling
+	thread.
+
+	WorkStealingPool is neither copyable nor movable.
+	*/
+	class WorkStealingPool
+	{
+	public:
+		//invoked with [begin, end) of a chunk
+		using ChunkT = Delegate<void(std::ptrdiff_t, std::ptrdiff_t)>;
+
+	private:
+		/* The chunks not taken yet from the part of a participant,
+		[begin, end) packed into one word, so that both the owner and
+		the thieves change it with a single CAS */
+		struct alignas(64) Part
+		{
+			std::atomic<std::uint64_t> _chunks{ 0 };
+		};
+
+		static std::uint64_t pack(std::uint32_t begin, std::uint32_t end)
+		{
+			return std::uint64_t(end) << 32 | begin;
+		}
+
+		static std::uint32_t begin(std::uint64_t chunks)
+		{
+			return std::uint32_t(chunks);
+		}
+
+		static std::uint32_t end(std::uint64_t chunks)
+		{
+			return std::uint32_t(chunks >> 32);
+		}
+
+		std::vector<std::thread> _workers;
+
+		//a part per participant, the part 0 belongs to the calling thread
+		std::unique_ptr<Part[]> _parts;
+
+		//incremented to start a job and to stop, workers wait on it
+		std::atomic<std::uint64_t> _generation{ 0 };
+
+		//true while the workers may join the current job
+		std::atomic<bool> _open{ false };
+
+		//the workers that joined the current job
+		std::atomic<std::ptrdiff_t> _busy{ 0 };
+
+		//the chunks of the current job that are not finished yet
+		std::atomic<std::ptrdiff_t> _remaining{ 0 };
+
+		//read by the workers without the lock, set before the last generation bump
+		std::atomic<bool> _stop{ false };
+
+		//the current job
+		ChunkT viewptr _chunk = nullptr;
+		std::ptrdiff_t _count = 0;
+		std::ptrdiff_t _grain = 0;
+
+		//serializes .parallelFor(...)
+		std::mutex _jobMutex;
+
+		//takes the front chunk of the part @p
+		bool pop(std::size_t p, std::uint32_t& chunk)
+		{
+			std::uint64_t chunks = _parts[p]._chunks.load(std::memory_order_relaxed);
+			do
+			{
+				if (begin(chunks) == end(chunks))
+					return false;
+			}
+			while (!_parts[p]._chunks.compare_exchange_weak(chunks,
+					pack(begin(chunks) + 1, end(chunks)), std::memory_order_acquire,
+					std::memory_order_relaxed));
+
+			chunk = begin(chunks);
+			return true;
+		}
+
+		//moves the back half of the part of another participant to the empty part @p
+		bool steal(std::size_t p)
+		{
+			const std::size_t nParts = _workers.size() + 1;
+			for (std::size_t i = 1; i != nParts; ++i)
+			{
+				Part& victim = _parts[(p + i) % nParts];
+				std::uint64_t chunks = victim._chunks.load(std::memory_order_relaxed);
+				while (begin(chunks) != end(chunks))
+				{
+					const std::uint32_t middle = end(chunks) - (end(chunks) - begin(chunks) + 1) / 2;
+					if (victim._chunks.compare_exchange_weak(chunks, pack(begin(chunks), middle),
+															 std::memory_order_acquire,
+															 std::memory_order_relaxed))
+					{
+						_parts[p]._chunks.store(pack(middle, end(chunks)), std::memory_order_release);
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		//runs chunks of the current job until there are none to take
+		void participate(std::size_t p)
+		{
+			std::uint32_t chunk;
+			for (;;)
+			{
+				if (!pop(p, chunk) && !(steal(p) && pop(p, chunk)))
+				{
+					if (_remaining.load(std::memory_order_acquire) == 0)
+						return;
+
+					//the last chunks are running elsewhere or a steal is in flight
+					std::this_thread::yield();
+					continue;
+				}
+
+				const std::ptrdiff_t first = std::ptrdiff_t(chunk) * _grain;
+				_chunk->invoke(first, std::min(first + _grain, _count));
+				_remaining.fetch_sub(1, std::memory_order_release);
+			}
+		}
+
+		void work(std::size_t p)
+		{
+			std::uint64_t seen = 0;
+			for (;;)
+			{
+				_generation.wait(seen, std::memory_order_acquire);
+				seen = _generation.load(std::memory_order_acquire);
+				if (_stop.load(std::memory_order_acquire))
+					return;
+
+				//the job may finish before this worker wakes up
+				_busy.fetch_add(1, std::memory_order_seq_cst);
+				if (_open.load(std::memory_order_seq_cst))
+					participate(p);
+				_busy.fetch_sub(1, std::memory_order_release);
+			}
+		}
+
+	public:
+		//by default, a worker per hardware thread except the calling one
+		explicit WorkStealingPool(std::size_t nWorkers =
+									  std::max(std::thread::hardware_concurrency(), 1u) - 1) :
+			_parts(new Part[nWorkers + 1])
+		{
+			_workers.reserve(nWorkers);
+			for (std::size_t w = 0; w != nWorkers; ++w)
+				_workers.emplace_back([this, w] { work(w + 1); });
+		}
+
+		WorkStealingPool(const WorkStealingPool&) = delete;
+		WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+		~WorkStealingPool()
+		{
+			{
+				std::lock_guard lock(_jobMutex);
+				_stop.store(true, std::memory_order_relaxed);
+				_generation.fetch_add(1, std::memory_order_release);
+			}
+			_generation.notify_all();
+
+			for (std::thread& w : _workers)
+				w.join();
+		}
+
+		[[nodiscard]] std::size_t workers() const
+		{
+			return _workers.size();
+		}
+
+		/* Invoke @chunk for consecutive ranges of at most @grain indices
+		that cover [0, @count), on the workers and the calling thread,
+		and wait until all of them return.
+
+		The ranges are run on the calling thread if there is a single one,
+		if there are no workers, or if another .parallelFor(...) is running,
+		e.g. when called from a chunk. */
+		void parallelFor(std::ptrdiff_t count, std::ptrdiff_t grain, ChunkT chunk)
+		{
+			assert(grain > 0);
+			const std::ptrdiff_t nChunks = (count + grain - 1) / grain;
+			assert(nChunks <= std::ptrdiff_t(UINT32_MAX));
+
+			std::unique_lock lock(_jobMutex, std::try_to_lock);
+			if (nChunks < 2 || _workers.empty() || !lock.owns_lock())
+			{
+				for (std::ptrdiff_t first = 0; first < count; first += grain)
+					chunk.invoke(first, std::min(first + grain, count));
+				return;
+			}
+
+			_chunk = &chunk;
+			_count = count;
+			_grain = grain;
+			_remaining.store(nChunks, std::memory_order_relaxed);
+
+			const std::size_t nParts = _workers.size() + 1;
+			for (std::size_t p = 0; p != nParts; ++p)
+			{
+				_parts[p]._chunks.store(pack(std::uint32_t(nChunks * p / nParts),
+											 std::uint32_t(nChunks * (p + 1) / nParts)),
+										std::memory_order_relaxed);
+			}
+
+			_open.store(true, std::memory_order_seq_cst);
+			_generation.fetch_add(1, std::memory_order_release);
+			_generation.notify_all();
+
+			participate(0);
+
+			//the chunk must not be invoked by late workers after the return
+			_open.store(false, std::memory_order_seq_cst);
+			while (_busy.load(std::memory_order_seq_cst) != 0)
+				std::this_thread::yield();
+		}
+	};
+}
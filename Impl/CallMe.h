@@ -28,7 +28,12 @@
 #include <stdexcept>
 #endif
 
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 namespace CallMe
 {
@@ -248,6 +253,8 @@ namespace CallMe
 		"Pass l-value references or pointers to an object. Make sure the object's "\
 		"lifetime >= lifetime of the Delegate"
 	#define MsgStaticMethodNotAllowed "For static member functions, use free function constructors/factories"
+	#define MsgDoesNotFitInline "The target does not fit into the inline storage of OwningDelegate. "\
+		"Increase InlineCapacity or allow heap storage with InlinePolicy::AllowHeap"
 
 	//COMPILE_INVALID_CTORS is only for testing,
 	//don't define in production
@@ -395,6 +402,13 @@ namespace CallMe
 			}
 		};
 
+		/* Invokes consecutive delegates in [@first, @last) for as long as
+		they have the same invoker as *@first, results are discarded.
+		Returns the number of invoked delegates. Delegate is the record
+		type of the caller, only its .invoker() and .object() are used. */
+		template<typename Delegate, typename...ClassArgs>
+		using PErasedBatchInvoker = std::ptrdiff_t(*)(Delegate* first, Delegate* last, ClassArgs...);
+
 		template<auto Method, typename Object, typename R, typename...ClassArgs>
 			requires MethodMatchesClass<Method, Object>
 		struct MethodInvoker
@@ -405,6 +419,20 @@ namespace CallMe
 				return (reinterpret_cast<Object*>(object)->*Method)(
 					std::forward<ClassArgs>(args)...);
 			}
+
+			/* implements ErasedBatchInvoker: one indirect call for the whole
+			run, the member function can be inlined into the loop */
+			MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
+			template<typename Delegate>
+			static std::ptrdiff_t invokeBatch(Delegate* first, Delegate* last, ClassArgs...args)
+			{
+				Delegate* d = first;
+				for (; d != last && d->invoker() == &invoke; ++d)
+					(reinterpret_cast<Object*>(d->object())->*Method)(
+						std::forward<ClassArgs>(args)...);
+				return d - first;
+			}
+			MSVC_SUPPRESS_WARNING_POP
 		};
 
 		template<typename R, typename...ClassArgs>
@@ -430,6 +458,11 @@ namespace CallMe
 				return _object;
 			}
 
+			PErasedInvoker<R, ClassArgs...> invoker()
+			{
+				return _invoker;
+			}
+
 			ErasedDelegate(const ErasedDelegate& other) = default;
 
 			ErasedDelegate& operator=(const ErasedDelegate& other) = default;
@@ -689,14 +722,53 @@ namespace CallMe
 		{
 			return nullptr;
 		}
+
+		/* moves the object at @from to the uninitialized storage @to
+		and destroys the object at @from */
+		using ErasedRelocator = void(*)(PErasedObject from, void* to);
+
+		/* Inline (small buffer optimization) storage of OwningDelegate.
+		_relocate != nullptr IFF the owned target lives in _buffer */
+		template<std::size_t Capacity>
+		struct OwnedInlineStorage
+		{
+			ErasedRelocator _relocate = nullptr;
+			alignas(void*) std::byte _buffer[Capacity];
+		};
+
+		//no inline storage, all owned targets live on the heap
+		template<>
+		struct OwnedInlineStorage<0>
+		{
+		};
 	}
 
-	template<typename Signature>
+	/* Where OwningDelegate is allowed to place owned targets that
+	are constructed in-place with OwningDelegate::make(...) */
+	enum class InlinePolicy
+	{
+		//inline if the target fits into the inline storage, heap otherwise
+		AllowHeap,
+		//inline only, targets that don't fit break compilation
+		InlineOnly
+	};
+
+	/* OwningDelegate exclusively owns its target.
+
+	@InlineCapacity is the size in bytes of the inline (small buffer
+	optimization) storage for targets constructed in-place with
+	OwningDelegate::make(...). Targets that don't fit are allocated on the
+	heap, unless @Policy is InlinePolicy::InlineOnly. Targets passed to
+	constructors as pointers are always owned on the heap. */
+	template<typename Signature,
+		std::size_t InlineCapacity = 0,
+		InlinePolicy Policy = InlinePolicy::AllowHeap>
 	class OwningDelegate;
 
-	template<typename R, typename...ClassArgs>
-	class OwningDelegate<R(ClassArgs...)> :
-		public internal::ErasedDelegate<R, ClassArgs...>
+	template<typename R, typename...ClassArgs, std::size_t InlineCapacity, InlinePolicy Policy>
+	class OwningDelegate<R(ClassArgs...), InlineCapacity, Policy> :
+		public internal::ErasedDelegate<R, ClassArgs...>,
+		private internal::OwnedInlineStorage<InlineCapacity>
 	{
 		using Erased = internal::ErasedDelegate<R, ClassArgs...>;
 
@@ -720,7 +792,145 @@ namespace CallMe
 		{
 		}
 
+		template<typename Object>
+		static void InlineDeleterImpl(internal::PErasedObject object)
+		{
+			reinterpret_cast<Object*>(object)->~Object();
+		}
+
+		template<typename Object>
+		static void RelocatorImpl(internal::PErasedObject from, void* to)
+		{
+			auto src = reinterpret_cast<Object*>(from);
+			::new (to) Object(std::move(*src));
+			src->~Object();
+		}
+
+		/* Never called, marks trivially copyable inline targets that are
+		relocated by copying the inline storage without an indirect call */
+		static void TrivialRelocatorImpl(internal::PErasedObject, void*)
+		{
+		}
+
+		/* relocation of inline targets must not throw, otherwise moves
+		of OwningDelegate could not be noexcept */
+		template<typename Object>
+		constexpr static bool FitsInline =
+			sizeof(Object) <= InlineCapacity and
+			alignof(Object) <= alignof(void*) and
+			std::is_nothrow_move_constructible_v<Object>;
+
+		template<typename Object>
+		constexpr static bool Placeable =
+			Policy == InlinePolicy::AllowHeap or FitsInline<Object>;
+
+		template<typename Object, typename...CtorArgs>
+		explicit OwningDelegate(std::in_place_type_t<Object>,
+								internal::PErasedInvoker<R, ClassArgs...> invoker,
+								CtorArgs&&...args) :
+			Erased(invoker, nullptr)
+		{
+			if constexpr (FitsInline<Object>)
+			{
+				this->_object = ::new (static_cast<void*>(this->_buffer))
+					Object(std::forward<CtorArgs>(args)...);
+
+				if constexpr (std::is_trivially_copyable_v<Object>)
+				{
+					this->_relocate = &TrivialRelocatorImpl;
+					_delete = NullErasedDeleterImpl;
+				}
+				else
+				{
+					this->_relocate = &RelocatorImpl<Object>;
+					_delete = &InlineDeleterImpl<Object>;
+				}
+			}
+			else
+			{
+				this->_object = new Object(std::forward<CtorArgs>(args)...);
+				_delete = &ErasedDeleterImpl<Object>;
+			}
+		}
+
+		/* the inline target of @other, if any, is moved to [this].
+		Expects that _object and _delete have already been taken over */
+		void relocateFrom(OwningDelegate& other) noexcept
+		{
+			if constexpr (InlineCapacity != 0)
+			{
+				this->_relocate = other._relocate;
+				if (this->_relocate)
+				{
+					this->_object = this->_buffer;
+					if (this->_relocate == &TrivialRelocatorImpl)
+						std::memcpy(this->_buffer, other._buffer, InlineCapacity);
+					else
+						this->_relocate(other._buffer, this->_buffer);
+
+					other._relocate = nullptr;
+					other._delete = NullErasedDeleterImpl;
+				}
+			}
+		}
+
 	public:
+		/* Construct a functor of type @Functor in-place from @args.
+
+		The functor is stored in the inline storage of the delegate if it
+		fits there, otherwise it is allocated on the heap (see InlinePolicy).
+		Move-only functors are supported. */
+		template<internal::AnyFunctor Functor, typename...CtorArgs>
+			requires internal::FunctorSignature<Functor, R, ClassArgs...> and
+					 Placeable<Functor>
+		[[nodiscard]] static OwningDelegate make(CtorArgs&&...args)
+		{
+			return OwningDelegate(std::in_place_type<Functor>,
+								  FunctorInvokerT<Functor>::invoke,
+								  std::forward<CtorArgs>(args)...);
+		}
+
+		template<internal::AnyFunctor Functor, typename...CtorArgs>
+			requires internal::FunctorSignature<Functor, R, ClassArgs...> and
+					 (not Placeable<Functor>)
+		DELETE_FUNCTION(static OwningDelegate make(CtorArgs&&...),
+						MsgDoesNotFitInline)
+
+		// the same as above, the type of the functor is deduced from @functor
+		template<typename Functor, typename FunctorT = std::remove_cvref_t<Functor>>
+			requires internal::FunctorSignature<FunctorT, R, ClassArgs...> and
+					 Placeable<FunctorT>
+		[[nodiscard]] static OwningDelegate make(Functor&& functor)
+		{
+			return OwningDelegate(std::in_place_type<FunctorT>,
+								  FunctorInvokerT<FunctorT>::invoke,
+								  std::forward<Functor>(functor));
+		}
+
+		template<typename Functor, typename FunctorT = std::remove_cvref_t<Functor>>
+			requires internal::FunctorSignature<FunctorT, R, ClassArgs...> and
+					 (not Placeable<FunctorT>)
+		DELETE_FUNCTION(static OwningDelegate make(Functor&&),
+						MsgDoesNotFitInline)
+
+		/* Construct an object of the class of @Method in-place from @args
+		and make the delegate target the object's @Method */
+		template<internal::MemberFunction auto Method, typename...CtorArgs,
+			typename Object = typename internal::MemberFunctionDeducer<decltype(Method)>::ClassType>
+			requires Placeable<Object>
+		[[nodiscard]] static OwningDelegate make(CtorArgs&&...args)
+		{
+			return OwningDelegate(std::in_place_type<Object>,
+								  MethodInvokerT<Object, Method>::invoke,
+								  std::forward<CtorArgs>(args)...);
+		}
+
+		template<internal::MemberFunction auto Method, typename...CtorArgs,
+			typename Object = typename internal::MemberFunctionDeducer<decltype(Method)>::ClassType>
+			requires (not Placeable<Object>)
+		DELETE_FUNCTION(static OwningDelegate make(CtorArgs&&...),
+						MsgDoesNotFitInline)
+
         //Functor*
 		template<internal::NonLiteFunctor Functor>
 			requires internal::FunctorSignature<Functor, R, ClassArgs...>
@@ -813,6 +1023,7 @@ namespace CallMe
 			: Erased(std::move(other)),//nulls out other._object
 			_delete(other._delete)
 		{
+			relocateFrom(other);
 		}
 
 		OwningDelegate& operator=(OwningDelegate&& other) noexcept
@@ -826,6 +1037,7 @@ namespace CallMe
 				_delete = other._delete;
 
 				Erased::operator=(std::move(other));
+				relocateFrom(other);
 			}
 
 			return *this;
@@ -862,6 +1074,227 @@ namespace CallMe
 	//
 	//////////////////////////////////////////////////////////////////////////////////////////////////
 
+	//how SharedDelegate counts references to the shared target
+	enum class RefCounting
+	{
+		//copies and destruction are safe on different threads
+		Atomic,
+		//cheaper, but all copies must be used on the same thread
+		NonAtomic
+	};
+
+	namespace internal
+	{
+		template<RefCounting Counting>
+		using RefCounter = std::conditional_t<Counting == RefCounting::Atomic,
+			std::atomic<std::size_t>,
+			std::size_t>;
+
+		/* The header of the single heap allocation that holds both
+		the reference counter and the shared target */
+		template<RefCounting Counting>
+		struct SharedBlock
+		{
+			using ErasedDestroyer = void(*)(SharedBlock* block);
+
+			RefCounter<Counting> _refs;
+			ErasedDestroyer _destroy;
+
+			explicit SharedBlock(ErasedDestroyer destroy) noexcept :
+				_refs(1),
+				_destroy(destroy)
+			{
+			}
+
+			void retain() noexcept
+			{
+				if constexpr (Counting == RefCounting::Atomic)
+					_refs.fetch_add(1, std::memory_order_relaxed);
+				else
+					++_refs;
+			}
+
+			void release() noexcept
+			{
+				if constexpr (Counting == RefCounting::Atomic)
+				{
+					if (_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+						_destroy(this);
+				}
+				else
+				{
+					if (--_refs == 0)
+						_destroy(this);
+				}
+			}
+
+			[[nodiscard]] std::size_t count() const noexcept
+			{
+				if constexpr (Counting == RefCounting::Atomic)
+					return _refs.load(std::memory_order_relaxed);
+				else
+					return _refs;
+			}
+		};
+
+		template<typename Object, RefCounting Counting>
+		struct SharedBlockFor : SharedBlock<Counting>
+		{
+			Object _object;
+
+			template<typename...CtorArgs>
+			explicit SharedBlockFor(CtorArgs&&...args) :
+				SharedBlock<Counting>(&destroy),
+				_object(std::forward<CtorArgs>(args)...)
+			{
+			}
+
+			static void destroy(SharedBlock<Counting>* block)
+			{
+				delete static_cast<SharedBlockFor*>(block);
+			}
+		};
+	}
+
+	/* SharedDelegate shares the ownership of its target between copies,
+	similar to shared_ptr. The reference counter and the target live in
+	a single heap allocation, so copying is a single increment of the
+	counter, while invocation is the same single thunk call as for
+	Delegate and OwningDelegate.
+
+	The target is constructed in-place with SharedDelegate::make(...). */
+	template<typename Signature, RefCounting Counting = RefCounting::Atomic>
+	class SharedDelegate;
+
+	template<typename R, typename...ClassArgs, RefCounting Counting>
+	class SharedDelegate<R(ClassArgs...), Counting> :
+		public internal::ErasedDelegate<R, ClassArgs...>
+	{
+		using Erased = internal::ErasedDelegate<R, ClassArgs...>;
+
+		using Block = internal::SharedBlock<Counting>;
+
+		template<typename Object>
+		using BlockFor = internal::SharedBlockFor<Object, Counting>;
+
+		template<typename Functor>
+		using FunctorInvokerT = internal::FunctorInvoker<Functor, R, ClassArgs...>;
+
+		template<typename Object, auto Method>
+		using MethodInvokerT = internal::MethodInvoker<Method, Object, R, ClassArgs...>;
+
+		Block* _block;
+
+		template<typename Object, typename...CtorArgs>
+		explicit SharedDelegate(std::in_place_type_t<Object>,
+								internal::PErasedInvoker<R, ClassArgs...> invoker,
+								CtorArgs&&...args) :
+			Erased(invoker, nullptr)
+		{
+			auto block = new BlockFor<Object>(std::forward<CtorArgs>(args)...);
+			this->_object = &block->_object;
+			_block = block;
+		}
+
+		void release() noexcept
+		{
+			if (_block)
+				_block->release();
+		}
+
+	public:
+		/* Construct a functor of type @Functor in-place from @args.
+		Move-only functors are supported. */
+		template<internal::AnyFunctor Functor, typename...CtorArgs>
+			requires internal::FunctorSignature<Functor, R, ClassArgs...>
+		[[nodiscard]] static SharedDelegate make(CtorArgs&&...args)
+		{
+			return SharedDelegate(std::in_place_type<Functor>,
+								  FunctorInvokerT<Functor>::invoke,
+								  std::forward<CtorArgs>(args)...);
+		}
+
+		// the same as above, the type of the functor is deduced from @functor
+		template<typename Functor, typename FunctorT = std::remove_cvref_t<Functor>>
+			requires internal::FunctorSignature<FunctorT, R, ClassArgs...>
+		[[nodiscard]] static SharedDelegate make(Functor&& functor)
+		{
+			return SharedDelegate(std::in_place_type<FunctorT>,
+								  FunctorInvokerT<FunctorT>::invoke,
+								  std::forward<Functor>(functor));
+		}
+
+		/* Construct an object of the class of @Method in-place from @args
+		and make the delegate target the object's @Method */
+		template<internal::MemberFunction auto Method, typename...CtorArgs,
+			typename Object = typename internal::MemberFunctionDeducer<decltype(Method)>::ClassType>
+		[[nodiscard]] static SharedDelegate make(CtorArgs&&...args)
+		{
+			return SharedDelegate(std::in_place_type<Object>,
+								  MethodInvokerT<Object, Method>::invoke,
+								  std::forward<CtorArgs>(args)...);
+		}
+
+		explicit SharedDelegate() noexcept :
+			Erased(),
+			_block(nullptr)
+		{
+		}
+
+		~SharedDelegate()
+		{
+			release();
+		}
+
+		SharedDelegate(const SharedDelegate& other) noexcept :
+			Erased(other),
+			_block(other._block)
+		{
+			if (_block)
+				_block->retain();
+		}
+
+		SharedDelegate& operator=(const SharedDelegate& other) noexcept
+		{
+			if (this == &other)
+				return *this;
+
+			//other may be owned by the target of [this], released below
+			SharedDelegate copy(other);
+			return *this = std::move(copy);
+		}
+
+		SharedDelegate(SharedDelegate&& other) noexcept :
+			Erased(std::move(other)),//nulls out other._object
+			_block(other._block)
+		{
+			other._block = nullptr;
+		}
+
+		SharedDelegate& operator=(SharedDelegate&& other) noexcept
+		{
+			if (this == &other)
+				return *this;
+
+			//order dependency: other may be owned by the target of [this]
+			SharedDelegate taken(std::move(other));
+			release();
+
+			Erased::operator=(std::move(taken));
+			_block = taken._block;
+			taken._block = nullptr;
+
+			return *this;
+		}
+
+		/* the number of SharedDelegate objects sharing the target,
+		0 for default-constructed and moved-from delegates */
+		[[nodiscard]] std::size_t useCount() const noexcept
+		{
+			return _block ? _block->count() : 0;
+		}
+	};
+
     inline namespace factory
     {
 		template<auto Function>
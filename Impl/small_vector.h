@@ -1209,6 +1209,20 @@ namespace gch
         return it + n;
     }
 
+    /**
+     * Customization point: specialize as `std::true_type` for types whose
+     * objects may be relocated, i.e. moved to new storage with the source
+     * destroyed, by copying their bytes. When `small_vector` reallocates or is
+     * moved out of inline storage, it relocates such elements with `memcpy`
+     * instead of element-wise move construction. This only takes effect for
+     * trivially destructible types and allocators without custom
+     * `construct`/`destroy`.
+     */
+    template <typename T>
+    struct is_trivially_relocatable
+        : std::is_trivially_copyable<T>
+    { };
+
     namespace detail
     {
 
@@ -1914,6 +1928,15 @@ namespace gch
                 : is_uninitialized_memcpyable_impl<From, To>
             { };
 
+            // Relocation (move + destroy of the source) by memcpy.
+            template <typename V>
+            struct is_uninitialized_relocatable
+                : bool_constant<is_trivially_relocatable<V>::value
+                &&  std::is_trivially_destructible<V>::value
+                &&! must_use_alloc_construct<alloc_ty, value_ty, V&&>::value
+                &&! must_use_alloc_destroy<alloc_ty, value_ty>::value>
+            { };
+
             template <typename Iterator>
             struct is_small_vector_iterator
                 : std::false_type
@@ -2754,6 +2777,10 @@ namespace gch
             using is_memcpyable_iterator =
                 typename alloc_interface::template is_memcpyable_iterator<Args...>;
 
+            template <typename V>
+            using is_uninitialized_relocatable =
+                typename alloc_interface::template is_uninitialized_relocatable<V>;
+
             GCH_NORETURN
                 static GCH_CPP20_CONSTEXPR
                 void
@@ -3449,8 +3476,12 @@ namespace gch
                 else
                 {
                     set_to_inline_storage ();
-                    uninitialized_move (other.begin_ptr (), other.end_ptr (), data_ptr ());
+                    uninitialized_relocate (other.begin_ptr (), other.end_ptr (), data_ptr ());
                     set_size (other.get_size ());
+
+                    // Relocated elements no longer belong to `other`.
+                    if (is_uninitialized_relocatable<value_ty>::value)
+                        other.set_size (0);
                 }
             }
 
@@ -3475,7 +3506,7 @@ namespace gch
 
                         GCH_TRY
                         {
-                            uninitialized_move (other.begin_ptr (), other.end_ptr (), data_ptr ());
+                            uninitialized_relocate (other.begin_ptr (), other.end_ptr (), data_ptr ());
                         }
                             GCH_CATCH (...)
                         {
@@ -3486,10 +3517,14 @@ namespace gch
                     else
                     {
                         set_to_inline_storage ();
-                        uninitialized_move (other.begin_ptr (), other.end_ptr (), data_ptr ());
+                        uninitialized_relocate (other.begin_ptr (), other.end_ptr (), data_ptr ());
                     }
 
                     set_size (other.get_size ());
+
+                    // Relocated elements no longer belong to `other`.
+                    if (is_uninitialized_relocatable<value_ty>::value)
+                        other.set_size (0);
                 }
             }
 
@@ -3893,6 +3928,35 @@ namespace gch
                 return uninitialized_copy (first, last, d_first);
             }
 
+            // Moves [first, last) to d_first, the source range must be destroyed
+            // or forgotten right after. See `is_trivially_relocatable`.
+            template <typename Policy = void, typename V = value_ty,
+                typename std::enable_if<is_uninitialized_relocatable<V>::value, bool>::type = true>
+            GCH_CPP20_CONSTEXPR
+                ptr
+                uninitialized_relocate (ptr first, ptr last, ptr d_first) noexcept
+            {
+#ifdef GCH_LIB_IS_CONSTANT_EVALUATED
+                if (std::is_constant_evaluated ())
+                    return uninitialized_move<Policy> (first, last, d_first);
+#endif
+
+                const size_ty num_relocate = internal_range_length (first, last);
+                if (num_relocate != 0)
+                    std::memcpy (static_cast<void *> (to_address (d_first)), to_address (first),
+                                 num_relocate * sizeof (value_ty));
+                return unchecked_next (d_first, num_relocate);
+            }
+
+            template <typename Policy = void, typename V = value_ty,
+                typename std::enable_if<! is_uninitialized_relocatable<V>::value, bool>::type = false>
+            GCH_CPP20_CONSTEXPR
+                ptr
+                uninitialized_relocate (ptr first, ptr last, ptr d_first)
+            {
+                return uninitialized_move<Policy> (first, last, d_first);
+            }
+
             GCH_CPP20_CONSTEXPR
                 ptr
                 shift_into_uninitialized (ptr pos, size_ty n_shift)
@@ -3941,7 +4005,7 @@ namespace gch
                     GCH_TRY
                     {
                         new_last = uninitialized_fill (new_last, unchecked_next (new_last, count), val);
-                    uninitialized_move (begin_ptr (), end_ptr (), new_data_ptr);
+                    uninitialized_relocate (begin_ptr (), end_ptr (), new_data_ptr);
                     }
                         GCH_CATCH (...)
                     {
@@ -4023,7 +4087,7 @@ namespace gch
                     GCH_TRY
                     {
                         new_last = uninitialized_copy (first, last, new_last);
-                    uninitialized_move<MovePolicy> (begin_ptr (), end_ptr (), new_data_ptr);
+                    uninitialized_relocate<MovePolicy> (begin_ptr (), end_ptr (), new_data_ptr);
                     }
                         GCH_CATCH (...)
                     {
@@ -4091,9 +4155,9 @@ namespace gch
                         uninitialized_fill (new_first, unchecked_next (new_first, count), val);
                     unchecked_advance  (new_last, count);
 
-                    uninitialized_move (begin_ptr (), pos, new_data_ptr);
+                    uninitialized_relocate (begin_ptr (), pos, new_data_ptr);
                     new_first = new_data_ptr;
-                    uninitialized_move (pos, end_ptr (), new_last);
+                    uninitialized_relocate (pos, end_ptr (), new_last);
                     }
                         GCH_CATCH (...)
                     {
@@ -4242,9 +4306,9 @@ namespace gch
                         uninitialized_copy (first, last, new_first);
                     unchecked_advance  (new_last, num_insert);
 
-                    uninitialized_move (begin_ptr (), pos, new_data_ptr);
+                    uninitialized_relocate (begin_ptr (), pos, new_data_ptr);
                     new_first = new_data_ptr;
-                    uninitialized_move (pos, end_ptr (), new_last);
+                    uninitialized_relocate (pos, end_ptr (), new_last);
                     }
                         GCH_CATCH (...)
                     {
@@ -4433,7 +4497,7 @@ namespace gch
                     construct (emplace_pos, std::forward<Args> (args)...);
                 GCH_TRY
                 {
-                    uninitialized_move<strong_exception_policy> (begin_ptr (), end_ptr (), new_data_ptr);
+                    uninitialized_relocate<strong_exception_policy> (begin_ptr (), end_ptr (), new_data_ptr);
                 }
                     GCH_CATCH (...)
                 {
@@ -4476,9 +4540,9 @@ namespace gch
                     construct (new_first, std::forward<Args> (args)...);
                 unchecked_advance (new_last, 1);
 
-                uninitialized_move (begin_ptr (), pos, new_data_ptr);
+                uninitialized_relocate (begin_ptr (), pos, new_data_ptr);
                 new_first = new_data_ptr;
-                uninitialized_move (pos, end_ptr (), new_last);
+                uninitialized_relocate (pos, end_ptr (), new_last);
                 }
                     GCH_CATCH (...)
                 {
@@ -4522,7 +4586,7 @@ namespace gch
 #endif
                 }
 
-                uninitialized_move (begin_ptr (), end_ptr (), new_data_ptr);
+                uninitialized_relocate (begin_ptr (), end_ptr (), new_data_ptr);
 
                 destroy_range (begin_ptr (), end_ptr ());
                 deallocate (data_ptr (), get_capacity ());
@@ -4565,7 +4629,7 @@ namespace gch
                             val...);
 
                     // Strong exception guarantee.
-                    uninitialized_move<strong_exception_policy> (begin_ptr (), end_ptr (), new_data_ptr);
+                    uninitialized_relocate<strong_exception_policy> (begin_ptr (), end_ptr (), new_data_ptr);
                     }
                         GCH_CATCH (...)
                     {
@@ -4600,7 +4664,7 @@ namespace gch
 
                 GCH_TRY
                 {
-                    uninitialized_move<strong_exception_policy> (begin_ptr (), end_ptr (), new_begin);
+                    uninitialized_relocate<strong_exception_policy> (begin_ptr (), end_ptr (), new_begin);
                 }
                     GCH_CATCH (...)
                 {
@@ -35,6 +35,25 @@ TEST_SUITE("API error tests")
 		}
 	}
 
+	TEST_CASE("OwningDelegate/target does not fit inline storage") {
+		using StrictDelegate = OwningDelegate<int(), sizeof(void*), InlinePolicy::InlineOnly>;
+		struct Big
+		{
+			int operator()() { return a[0]; }
+			int a[4] {};
+		};
+		SUBCASE("functor"){
+			CHECK_THROWS_WITH(
+				StrictDelegate::make<Big>(),
+				MsgDoesNotFitInline);
+		}
+		SUBCASE("member function"){
+			CHECK_THROWS_WITH(
+				StrictDelegate::make<&Big::operator()>(),
+				MsgDoesNotFitInline);
+		}
+	}
+
 	TEST_CASE("OwningDelegate/const functor* not allowed") {
 		int stub = 0;
 		SUBCASE("ctor") {
@@ -558,4 +577,80 @@ TEST_SUITE("API error tests")
 			);
 		}
 	}
+
+	TEST_CASE("MethodEvent/r-value objects not allowed") {
+		struct Listener
+		{
+			void notify() {}
+		};
+
+		MethodEvent<&Listener::notify> event;
+		CHECK_THROWS_WITH(
+			event.subscribe(Listener()),
+			MsgNoRValueObjects
+		);
+	}
+
+	TEST_CASE("Event/collect requires non-void return type") {
+		Event<void(int)> event;
+		CHECK_THROWS_WITH(
+			event.collect(combiners::Sum<int>{}, 1),
+			MsgCollectVoidEvent
+		);
+	}
+
+	TEST_CASE("Event/raiseUntil requires bool return type") {
+		Event<void(int)> event;
+		CHECK_THROWS_WITH(
+			event.raiseUntil(1),
+			MsgRaiseUntilNonBoolEvent
+		);
+		CHECK_THROWS_WITH(
+			event.raiseWhile(1),
+			MsgRaiseUntilNonBoolEvent
+		);
+	}
+
+	TEST_CASE("Event/raiseUntil is not available for EventStorage::SlotMap") {
+		Event<bool(int), 4, DispatchOrder::Unspecified, EventStorage::SlotMap> event;
+		auto positive = [](int i) { return i > 0; };
+		SlotSubscription s = event.subscribe(fromFunctor(positive));
+		CHECK_THROWS_WITH(
+			event.raiseUntil(1),
+			MsgRaiseUntilSlotMap
+		);
+		CHECK_THROWS_WITH(
+			event.raiseWhile(1),
+			MsgRaiseUntilSlotMap
+		);
+
+		//collect(...) stops at the first true result the same way
+		CHECK(event.collect(combiners::FirstNonEmpty<bool>{}, 1));
+		CHECK(!event.collect(combiners::FirstNonEmpty<bool>{}, -1));
+	}
+
+	TEST_CASE("Event/raiseParallel requires arguments shareable between threads") {
+		struct SerialExecutor
+		{
+			void parallelFor(std::ptrdiff_t count, std::ptrdiff_t,
+							 Delegate<void(std::ptrdiff_t, std::ptrdiff_t)> chunk)
+			{
+				chunk(0, count);
+			}
+		} executor;
+
+		Event<void(int&)> event;
+		int i = 0;
+		CHECK_THROWS_WITH(
+			event.raiseParallel(executor, i),
+			MsgRaiseParallelMutableArgs
+		);
+	}
+
+	TEST_CASE("StaticEvent/r-value objects not allowed") {
+		CHECK_THROWS_WITH(
+			callMethod<&TestObject::getConst>(TestObject()),
+			MsgNoRValueObjects
+		);
+	}
 }	
\ No newline at end of file
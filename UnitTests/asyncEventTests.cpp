@@ -0,0 +1,180 @@
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+#include "CallMe.AsyncEvent.h"
+
+using namespace CallMe;
+
+namespace
+{
+	struct Log
+	{
+		void append(const std::string& s, int i)
+		{
+			std::lock_guard lock(_mutex);
+			_entries.push_back(s + std::to_string(i));
+			_threads.push_back(std::this_thread::get_id());
+		}
+
+		std::mutex _mutex;
+		std::vector<std::string> _entries;
+		std::vector<std::thread::id> _threads;
+	};
+}
+
+TEST_SUITE("async event tests")
+{
+	TEST_CASE("messages are dispatched on the worker in order") {
+		Log log;
+		AsyncEvent<void(const std::string&, int)> event(4);
+		CHECK(event.capacity() == 4);
+		Subscription s = event.subscribe(fromMethod<&Log::append>(&log));
+
+		std::string text = "message";
+		for (int i = 0; i != 20; ++i)
+			event.raise(text, i);
+		text.clear();
+		event.waitIdle();
+
+		REQUIRE(log._entries.size() == 20);
+		CHECK(log._entries.front() == "message0");
+		CHECK(log._entries.back() == "message19");
+		for (std::thread::id id : log._threads)
+			CHECK(id != std::this_thread::get_id());
+	}
+
+	TEST_CASE("tryRaise fails while the ring is full") {
+		std::atomic<bool> release{ false };
+		std::atomic<int> invoked{ 0 };
+		auto block = [&](int)
+		{
+			while (!release.load())
+				std::this_thread::yield();
+			++invoked;
+		};
+
+		AsyncEvent<void(int)> event(2);
+		Subscription s = event.subscribe(fromFunctor(block));
+
+		//the worker may take the first message and block on it
+		int posted = 0;
+		while (event.tryRaise(posted))
+			++posted;
+		CHECK(posted >= 2);
+		CHECK(posted <= 3);
+
+		release = true;
+		event.waitIdle();
+		CHECK(invoked == posted);
+		CHECK(event.tryRaise(0));
+	}
+
+	TEST_CASE("subscription ended while messages are in flight") {
+		std::atomic<int> invoked{ 0 };
+		std::atomic<bool> ended{ false };
+		std::atomic<int> afterEnd{ 0 };
+		auto count = [&]
+		{
+			if (ended.load())
+				++afterEnd;
+			++invoked;
+		};
+
+		AsyncEvent<void()> event(1024, 2);
+		std::optional<Subscription> s = event.subscribe(fromFunctor(count));
+		for (int i = 0; i != 1000; ++i)
+			event.raise();
+
+		s.reset();
+		ended = true;
+		event.waitIdle();
+		CHECK(afterEnd == 0);
+		CHECK(invoked <= 1000);
+	}
+
+	TEST_CASE("callbacks ending subscriptions on several workers at a time") {
+		constexpr int nRounds = 50;
+		std::atomic<int> arrived{ 0 };
+		std::vector<std::optional<Subscription>> ended(2 * nRounds);
+
+		AsyncEvent<void(int)> event(16, 2);
+		auto unsubscribe = [&](int i)
+		{
+			//both workers are in the callback before either ends a subscription
+			arrived.fetch_add(1);
+			while (arrived.load() < 2 * (i / 2 + 1))
+				std::this_thread::yield();
+			ended[i].reset();
+		};
+		auto nothing = [](int) {};
+		for (std::optional<Subscription>& s : ended)
+			s = event.subscribe(fromFunctor(nothing));
+		Subscription s = event.subscribe(fromFunctor(unsubscribe));
+
+		for (int round = 0; round != nRounds; ++round)
+		{
+			event.raise(2 * round);
+			//the other worker is woken while the first one is in the callback
+			while (arrived.load() <= 2 * round)
+				std::this_thread::yield();
+			event.raise(2 * round + 1);
+		}
+		event.waitIdle();
+		CHECK(event.count() == 1);
+	}
+
+	TEST_CASE("bursts wake sleeping workers") {
+		std::atomic<int> invoked{ 0 };
+		auto count = [&] { ++invoked; };
+
+		AsyncEvent<void()> event(16, 2);
+		Subscription s = event.subscribe(fromFunctor(count));
+		for (int burst = 1; burst <= 200; ++burst)
+		{
+			for (int i = 0; i != burst % 5; ++i)
+				event.raise();
+			event.waitIdle();
+			if (burst % 50 == 0)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		CHECK(invoked == 400);
+	}
+
+	TEST_CASE("several producers and workers") {
+		std::atomic<long> sum{ 0 };
+		auto add = [&sum](int i) { sum += i; };
+		std::vector<Subscription> subscriptions;
+
+		{
+			AsyncEvent<void(int)> event(64, 3);
+			event.subscribe(fromFunctor(add), subscriptions);
+			event.subscribe(fromFunctor(add), subscriptions);
+			CHECK(event.count() == 2);
+
+			std::vector<std::thread> producers;
+			for (int p = 0; p != 4; ++p)
+			{
+				producers.emplace_back([&event]
+				{
+					for (int i = 1; i <= 500; ++i)
+						event.raise(i);
+				});
+			}
+			for (std::thread& t : producers)
+				t.join();
+
+			//the destructor dispatches the posted messages
+		}
+		CHECK(sum == 2 * 4 * 500 * 501 / 2);
+
+		//the subscriptions outlive the event
+		subscriptions.clear();
+	}
+}
@@ -0,0 +1,413 @@
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+#include "CallMe.ConcurrentEvent.h"
+
+using namespace CallMe;
+
+namespace
+{
+	struct AtomicSubscriber
+	{
+		void notify()
+		{
+			if (_ended.load(std::memory_order_relaxed))
+				++_notifiedAfterEnd;
+			++_timesNotified;
+		}
+
+		std::atomic<bool> _ended{ false };
+		std::atomic<int> _timesNotified{ 0 };
+		std::atomic<int> _notifiedAfterEnd{ 0 };
+	};
+
+	struct Counted
+	{
+		void notify()
+		{
+			++_timesNotified;
+		}
+
+		int _timesNotified = 0;
+	};
+
+	/* Subscribe groups of callbacks and hand them to a thread that ends
+	them in bulk, while subscribing single callbacks */
+	template<typename EventT>
+	void unsubscribeInBulkWhileSubscribing(EventT& event)
+	{
+		constexpr int nRounds = 200;
+		auto nothing = [] {};
+		std::vector<SubscriptionGroup> groups(nRounds);
+		std::atomic<int> ready{ 0 };
+
+		std::thread clearer([&]
+		{
+			for (int round = 0; round != nRounds; ++round)
+			{
+				while (ready.load() <= round)
+					std::this_thread::yield();
+				groups[round].clear();
+			}
+		});
+
+		for (int round = 0; round != nRounds; ++round)
+		{
+			for (int i = 0; i != 8; ++i)
+				event.subscribe(fromFunctor(nothing), groups[round]);
+			ready.store(round + 1);
+
+			for (int i = 0; i != 8; ++i)
+			{
+				Subscription s = event.subscribe(fromFunctor(nothing));
+				CHECK(event.count() >= 1);
+			}
+		}
+		clearer.join();
+		CHECK(event.empty());
+	}
+
+	/* Callbacks on two threads end subscriptions to @EventT at a time,
+	while each of them is in a read scope that the other one waits for */
+	template<typename EventT>
+	void unsubscribeInCallbacksOnTwoThreads()
+	{
+		constexpr int nRounds = 100;
+		EventT target;
+		std::vector<AtomicSubscriber> subscribers(2);
+		std::atomic<int> arrived{ 0 };
+
+		auto work = [&](int t)
+		{
+			AtomicSubscriber& s = subscribers[t];
+			std::optional<Subscription> ended;
+			int round = 0;
+
+			auto unsubscribe = [&]
+			{
+				//both threads are in the callback before either ends a subscription
+				arrived.fetch_add(1);
+				while (arrived.load() < 2 * (round + 1))
+					std::this_thread::yield();
+				target.raise();
+				ended.reset();
+			};
+
+			EventT trigger;
+			Subscription u = trigger.subscribe(fromFunctor(unsubscribe));
+			for (; round != nRounds; ++round)
+			{
+				s._ended = false;
+				ended = target.subscribe(fromMethod<&AtomicSubscriber::notify>(&s));
+				trigger.raise();
+				//the ended callback must not run after the raise returns
+				s._ended = true;
+				target.raise();
+			}
+		};
+
+		std::thread other(work, 1);
+		work(0);
+		other.join();
+
+		CHECK(target.empty());
+		for (AtomicSubscriber& s : subscribers)
+			CHECK(s._notifiedAfterEnd == 0);
+	}
+}
+
+TEST_SUITE("concurrent event tests")
+{
+	TEST_CASE("subscribe, raise, unsubscribe") {
+		ConcurrentEvent<void()> event;
+		Counted alice, bob;
+		CHECK(event.empty());
+
+		{
+			Subscription a = event.subscribe(fromMethod<&Counted::notify>(&alice));
+			Subscription b = event.subscribe(fromMethod<&Counted::notify>(&bob));
+			CHECK(event.count() == 2);
+
+			event.raise();
+			event();
+			CHECK(alice._timesNotified == 2);
+			CHECK(bob._timesNotified == 2);
+
+			Subscription moved = std::move(a);
+			event.raise();
+			CHECK(alice._timesNotified == 3);
+
+			b = std::move(moved);
+			CHECK(event.count() == 1);
+			event.raise();
+			CHECK(alice._timesNotified == 4);
+			CHECK(bob._timesNotified == 3);
+		}
+		CHECK(event.empty());
+		event.raise();
+		CHECK(alice._timesNotified == 4);
+	}
+
+	TEST_CASE("vectors of subscriptions") {
+		ConcurrentEvent<void(int)> event;
+		Event<void(int)> ordinary;
+		int sum = 0;
+		auto add = [&sum](int i) { sum += i; };
+
+		SUBCASE("SubscriptionVector") {
+			SubscriptionVector subscriptions;
+			for (int i = 0; i != 20; ++i)
+			{
+				event.subscribe(fromFunctor(add), subscriptions);
+				ordinary.subscribe(fromFunctor(add), subscriptions);
+			}
+			subscriptions.shrink_to_fit();
+
+			event.raise(1);
+			ordinary.raise(1);
+			CHECK(sum == 40);
+
+			subscriptions.erase(subscriptions.begin(), subscriptions.begin() + 10);
+			event.raise(1);
+			CHECK(sum == 55);
+		}
+		SUBCASE("SubscriptionGroup") {
+			SubscriptionGroup group;
+			for (int i = 0; i != 10; ++i)
+				event.subscribe(fromFunctor(add), group);
+			event.raise(2);
+			CHECK(sum == 20);
+
+			group.clear();
+			CHECK(event.empty());
+			event.raise(2);
+			CHECK(sum == 20);
+		}
+	}
+
+	TEST_CASE("subscriptions outlive the event") {
+		Counted alice;
+		std::optional<ConcurrentEvent<void()>> event(std::in_place);
+		Subscription s = event->subscribe(fromMethod<&Counted::notify>(&alice));
+		std::vector<Subscription> v;
+		event->subscribe(fromMethod<&Counted::notify>(&alice), v);
+
+		event.reset();
+		Subscription moved = std::move(s);
+		v.clear();
+	}
+
+	TEST_CASE("unsubscription during raise") {
+		ConcurrentEvent<void()> event;
+		Counted alice, bob;
+		std::optional<Subscription> a, b;
+
+		SUBCASE("of the next callback") {
+			auto unsubscribeNext = [&] { alice.notify(); b.reset(); };
+			a = event.subscribe(fromFunctor(unsubscribeNext));
+			b = event.subscribe(fromMethod<&Counted::notify>(&bob));
+			event.raise();
+			CHECK(alice._timesNotified == 1);
+			CHECK(bob._timesNotified == 0);
+			CHECK(event.count() == 1);
+		}
+		SUBCASE("of itself and subscription of another callback") {
+			std::optional<Subscription> c;
+			auto resubscribe = [&]
+			{
+				alice.notify();
+				c = event.subscribe(fromMethod<&Counted::notify>(&alice));
+				a.reset();
+			};
+			a = event.subscribe(fromFunctor(resubscribe));
+			b = event.subscribe(fromMethod<&Counted::notify>(&bob));
+			event.raise();
+			CHECK(bob._timesNotified == 1);
+
+			event.raise();
+			CHECK(alice._timesNotified == 2);
+			CHECK(bob._timesNotified == 2);
+		}
+	}
+
+	TEST_CASE("raising while subscribing and unsubscribing on other threads") {
+		ConcurrentEvent<void()> event;
+		constexpr int nReaders = 3;
+		constexpr int nSubscribers = 4;
+		std::atomic<bool> stop{ false };
+
+		std::atomic<int> permanentCount{ 0 };
+		auto permanent = [&] { ++permanentCount; };
+		Subscription p = event.subscribe(fromFunctor(permanent));
+
+		std::vector<std::thread> readers;
+		for (int r = 0; r != nReaders; ++r)
+		{
+			readers.emplace_back([&]
+			{
+				while (!stop.load())
+					event.raise();
+			});
+		}
+
+		std::vector<AtomicSubscriber> subscribers(nSubscribers);
+		std::thread writer([&]
+		{
+			for (int round = 0; round != 50; ++round)
+			{
+				std::vector<Subscription> subscriptions;
+				for (AtomicSubscriber& s : subscribers)
+				{
+					s._ended = false;
+					event.subscribe(fromMethod<&AtomicSubscriber::notify>(&s), subscriptions);
+				}
+				std::this_thread::yield();
+
+				while (!subscriptions.empty())
+				{
+					subscriptions.pop_back();
+					//the callback must not run after ~Subscription returns
+					subscribers[subscriptions.size()]._ended = true;
+				}
+			}
+		});
+
+		writer.join();
+		stop = true;
+		for (std::thread& t : readers)
+			t.join();
+
+		CHECK(event.count() == 1);
+		CHECK(permanentCount > 0);
+		for (AtomicSubscriber& s : subscribers)
+			CHECK(s._notifiedAfterEnd == 0);
+	}
+
+	TEST_CASE("unsubscribing in bulk while subscribing on another thread") {
+		ConcurrentEvent<void()> event;
+		unsubscribeInBulkWhileSubscribing(event);
+	}
+
+	TEST_CASE("callbacks ending subscriptions on two threads at a time") {
+		unsubscribeInCallbacksOnTwoThreads<ConcurrentEvent<void()>>();
+	}
+
+	TEST_CASE("sharded event") {
+		ShardedEvent<void(int)> event(3);
+		CHECK(event.shards() == 4);
+		int sum = 0;
+		auto add = [&sum](int i) { sum += i; };
+
+		SUBCASE("subscriptions of several threads") {
+			std::vector<Subscription> subscriptions;
+			std::mutex mutex;
+			std::vector<std::thread> threads;
+			for (int t = 0; t != 4; ++t)
+			{
+				threads.emplace_back([&]
+				{
+					std::vector<Subscription> own;
+					for (int i = 0; i != 5; ++i)
+						event.subscribe(fromFunctor(add), own);
+
+					std::lock_guard lock(mutex);
+					for (Subscription& s : own)
+						subscriptions.push_back(std::move(s));
+				});
+			}
+			for (std::thread& t : threads)
+				t.join();
+			CHECK(event.count() == 20);
+
+			event.raise(1);
+			CHECK(sum == 20);
+
+			//ended on a thread other than the subscribing one
+			subscriptions.erase(subscriptions.begin(), subscriptions.begin() + 7);
+			CHECK(event.count() == 13);
+			event.raise(1);
+			CHECK(sum == 33);
+
+			std::thread([&] { subscriptions.clear(); }).join();
+			CHECK(event.empty());
+		}
+		SUBCASE("SubscriptionGroup and moved subscriptions") {
+			SubscriptionGroup group;
+			std::thread([&]
+			{
+				for (int i = 0; i != 10; ++i)
+					event.subscribe(fromFunctor(add), group);
+			}).join();
+			Subscription s = event.subscribe(fromFunctor(add));
+			Subscription moved = std::move(s);
+			event.raise(2);
+			CHECK(sum == 22);
+
+			group.clear();
+			CHECK(event.count() == 1);
+			event.raise(2);
+			CHECK(sum == 24);
+		}
+		SUBCASE("subscriptions outlive the event") {
+			std::optional<ShardedEvent<void()>> sharded(std::in_place);
+			Subscription s = sharded->subscribe(fromFunctor([] {}));
+			sharded.reset();
+		}
+	}
+
+	TEST_CASE("unsubscribing in bulk from a shard while subscribing to it") {
+		//both threads use the shard of the subscribing thread
+		ShardedEvent<void()> event;
+		unsubscribeInBulkWhileSubscribing(event);
+	}
+
+	TEST_CASE("callbacks ending subscriptions to a sharded event on two threads at a time") {
+		unsubscribeInCallbacksOnTwoThreads<ShardedEvent<void()>>();
+	}
+
+	TEST_CASE("subscribing and unsubscribing on many threads of a sharded event") {
+		ShardedEvent<void()> event;
+		constexpr int nThreads = 4;
+		std::atomic<bool> stop{ false };
+
+		std::thread reader([&]
+		{
+			while (!stop.load())
+				event.raise();
+		});
+
+		std::vector<AtomicSubscriber> subscribers(nThreads);
+		std::vector<std::thread> writers;
+		for (int t = 0; t != nThreads; ++t)
+		{
+			writers.emplace_back([&, t]
+			{
+				AtomicSubscriber& s = subscribers[t];
+				for (int round = 0; round != 50; ++round)
+				{
+					s._ended = false;
+					{
+						Subscription subscription =
+							event.subscribe(fromMethod<&AtomicSubscriber::notify>(&s));
+						std::this_thread::yield();
+					}
+					s._ended = true;
+				}
+			});
+		}
+
+		for (std::thread& t : writers)
+			t.join();
+		stop = true;
+		reader.join();
+
+		CHECK(event.empty());
+		for (AtomicSubscriber& s : subscribers)
+			CHECK(s._notifiedAfterEnd == 0);
+	}
+}
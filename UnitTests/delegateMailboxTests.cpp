@@ -0,0 +1,148 @@
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+#include "CallMe.DelegateMailbox.h"
+
+using namespace CallMe;
+
+namespace
+{
+	struct Widget
+	{
+		void setText(const std::string& text, int revision)
+		{
+			_text = text;
+			_revision = revision;
+			++_updates;
+		}
+
+		std::string _text;
+		int _revision = 0;
+		int _updates = 0;
+	};
+}
+
+TEST_SUITE("delegate mailbox tests")
+{
+	TEST_CASE("post and drain in batches") {
+		DelegateMailbox<void(const std::string&, int)> mailbox(8);
+		CHECK(mailbox.capacity() == 8);
+		CHECK(mailbox.empty());
+
+		Widget widget;
+		std::string text = "hello";
+		for (int i = 1; i <= 5; ++i)
+			mailbox.post(fromMethod<&Widget::setText>(&widget), text, i);
+		text.clear();
+		CHECK(!mailbox.empty());
+
+		CHECK(mailbox.drain(2) == 2);
+		CHECK(widget._revision == 2);
+		CHECK(mailbox.drain() == 3);
+		CHECK(widget._updates == 5);
+		CHECK(widget._text == "hello");
+		CHECK(mailbox.drain() == 0);
+	}
+
+	TEST_CASE("tryPost fails while the ring is full") {
+		DelegateMailbox<void(int)> mailbox(4);
+		int sum = 0;
+		auto add = [&sum](int i) { sum += i; };
+
+		int posted = 0;
+		while (mailbox.tryPost(fromFunctor(add), 1))
+			++posted;
+		CHECK(posted == 4);
+
+		CHECK(mailbox.drain(1) == 1);
+		CHECK(mailbox.tryPost(fromFunctor(add), 10));
+		CHECK(mailbox.drain() == 4);
+		CHECK(sum == 14);
+	}
+
+	TEST_CASE("slots of a batch are freed when the batch ends") {
+		DelegateMailbox<void(int)> mailbox(4);
+		int sum = 0;
+		int failed = 0;
+		auto add = [&sum](int i) { sum += i; };
+		auto repost = [&](int i)
+		{
+			if (!mailbox.tryPost(fromFunctor(add), i))
+				++failed;
+		};
+
+		for (int i = 0; i != 4; ++i)
+			mailbox.post(fromFunctor(repost), 1);
+		CHECK(mailbox.drain() == 4);
+		CHECK(failed == 4);
+
+		for (int i = 0; i != 4; ++i)
+			CHECK(mailbox.tryPost(fromFunctor(add), 10));
+		CHECK(!mailbox.tryPost(fromFunctor(add), 10));
+		CHECK(mailbox.drain() == 4);
+		CHECK(sum == 40);
+	}
+
+	TEST_CASE("owning delegates and rvalue arguments") {
+		using OwningT = OwningDelegate<void(std::string&&), 2 * sizeof(void*), InlinePolicy::InlineOnly>;
+		DelegateMailbox<void(std::string&&), OwningT> mailbox(4);
+
+		auto received = std::make_shared<std::vector<std::string>>();
+		auto receive = [received](std::string&& s) { received->push_back(std::move(s)); };
+		mailbox.post(OwningT::make(std::move(receive)), "first");
+		mailbox.post(OwningT::make([received](std::string&& s) { received->push_back(std::move(s)); }), "second");
+		CHECK(received.use_count() == 3);
+
+		CHECK(mailbox.drain() == 2);
+		CHECK(*received == std::vector<std::string>{ "first", "second" });
+
+		//the callbacks are destroyed with their items
+		CHECK(received.use_count() == 1);
+	}
+
+	TEST_CASE("items that are not drained are destroyed") {
+		auto counter = std::make_shared<int>(0);
+		{
+			DelegateMailbox<void(std::shared_ptr<int>)> mailbox(4);
+			auto ignore = [](std::shared_ptr<int>) {};
+			mailbox.post(fromFunctor(ignore), counter);
+			mailbox.post(fromFunctor(ignore), counter);
+			CHECK(counter.use_count() == 3);
+		}
+		CHECK(counter.use_count() == 1);
+	}
+
+	TEST_CASE("several producers and the owner thread") {
+		DelegateMailbox<void(int)> mailbox(16);
+		long sum = 0;
+		auto add = [&sum](int i) { sum += i; };
+
+		constexpr int nProducers = 4;
+		std::atomic<int> finished{ 0 };
+		std::vector<std::thread> producers;
+		for (int p = 0; p != nProducers; ++p)
+		{
+			producers.emplace_back([&]
+			{
+				for (int i = 1; i <= 1000; ++i)
+					mailbox.post(fromFunctor(add), i);
+				++finished;
+			});
+		}
+
+		while (finished != nProducers || !mailbox.empty())
+		{
+			if (mailbox.drain(8) == 0)
+				std::this_thread::yield();
+		}
+		for (std::thread& t : producers)
+			t.join();
+
+		CHECK(sum == nProducers * 1000 * 1001 / 2);
+	}
+}
@@ -7,7 +7,9 @@
 #include "windows.h"
 #endif
 
+#include <array>
 #include <cassert>
+#include <memory>
 #include <vector>
 
 #include "CallMe.h"
@@ -277,6 +279,285 @@ TEST_SUITE("delegate tests")
 		CHECK(Counter::dtors == 2);
 	}
 
+	//counts live instances, including move-constructed ones
+	struct LiveFunctor
+	{
+		explicit LiveFunctor(int payload) :
+			payload(payload)
+		{
+			++live;
+		}
+
+		LiveFunctor(LiveFunctor&& other) noexcept :
+			payload(other.payload)
+		{
+			++live;
+			++moves;
+		}
+
+		LiveFunctor(const LiveFunctor&)            = delete;
+		LiveFunctor& operator=(const LiveFunctor&) = delete;
+		LiveFunctor& operator=(LiveFunctor&&)      = delete;
+
+		~LiveFunctor()
+		{
+			--live;
+		}
+
+		int operator()(int i) const
+		{
+			return i + payload;
+		}
+
+		int payload;
+
+		static inline int live = 0;
+		static inline int moves = 0;
+	};
+
+	template<typename OwningDelegateT>
+	bool IsStoredInline(OwningDelegateT& delegate)
+	{
+		auto object = static_cast<std::byte*>(delegate.object());
+		auto self = reinterpret_cast<std::byte*>(&delegate);
+		return self <= object && object < self + sizeof(delegate);
+	}
+
+	TEST_CASE("OwningDelegate/in-place construction")
+	{
+		LiveFunctor::live = 0;
+		LiveFunctor::moves = 0;
+
+		using InlineDelegate = OwningDelegate<int(int), 4 * sizeof(void*)>;
+
+		SUBCASE("no inline storage by default"){
+			static_assert(sizeof(OwningDelegate<int(int)>) == 3 * sizeof(void*));
+
+			auto delegate = OwningDelegate<int(int)>::make<LiveFunctor>(1);
+			CHECK(!IsStoredInline(delegate));
+			CHECK(delegate(1) == 2);
+			CHECK(LiveFunctor::live == 1);
+		}
+		SUBCASE("inline"){
+			{
+				auto delegate = InlineDelegate::make<LiveFunctor>(1);
+				CHECK(IsStoredInline(delegate));
+				CHECK(delegate(1) == 2);
+				CHECK(LiveFunctor::live == 1);
+				CHECK(LiveFunctor::moves == 0);
+			}
+			CHECK(LiveFunctor::live == 0);
+		}
+		SUBCASE("lambda, deduced functor type"){
+			int a = 2;
+			auto delegate = InlineDelegate::make([a](int i) { return i + a; });
+			CHECK(IsStoredInline(delegate));
+			CHECK(delegate(1) == 3);
+		}
+		SUBCASE("heap fallback"){
+			std::array<int, 16> big{};
+			big[15] = 3;
+			auto delegate = InlineDelegate::make([big](int i) { return i + big[15]; });
+			CHECK(!IsStoredInline(delegate));
+			CHECK(delegate(1) == 4);
+		}
+		SUBCASE("move-only functor"){
+			auto delegate = InlineDelegate::make(
+				[p = std::make_unique<int>(5)](int i) { return i + *p; });
+			CHECK(IsStoredInline(delegate));
+
+			InlineDelegate moved(std::move(delegate));
+			CHECK(IsStoredInline(moved));
+			CHECK(moved(1) == 6);
+		}
+		SUBCASE("member function"){
+			Counter::reset();
+			auto set = OwningDelegate<int(int), sizeof(TestObject)>::make<&TestObject::set>();
+			CHECK(IsStoredInline(set));
+			CHECK(set(-1) == -1);
+			CHECK(Counter::Val() == -1);
+		}
+		SUBCASE("move ctor relocates inline target"){
+			{
+				auto delegate = InlineDelegate::make<LiveFunctor>(1);
+				InlineDelegate moved(std::move(delegate));
+
+				CHECK(IsStoredInline(moved));
+				CHECK(moved(1) == 2);
+				CHECK(LiveFunctor::live == 1);
+				CHECK(LiveFunctor::moves == 1);
+			}
+			CHECK(LiveFunctor::live == 0);
+		}
+		SUBCASE("move= destroys the previous target"){
+			{
+				auto delegate = InlineDelegate::make<LiveFunctor>(1);
+				auto delegate2 = InlineDelegate::make<LiveFunctor>(2);
+				CHECK(LiveFunctor::live == 2);
+
+				delegate = std::move(delegate2);
+				CHECK(LiveFunctor::live == 1);
+				CHECK(delegate(1) == 3);
+
+				//inline target overwritten by a heap target
+				int zero = 0;
+				delegate = InlineDelegate(new auto([zero](int i) mutable { return i + zero; }));
+				CHECK(LiveFunctor::live == 0);
+				CHECK(!IsStoredInline(delegate));
+				CHECK(delegate(1) == 1);
+
+				//heap target overwritten by an inline target
+				delegate = InlineDelegate::make<LiveFunctor>(3);
+				CHECK(IsStoredInline(delegate));
+				CHECK(delegate(1) == 4);
+			}
+			CHECK(LiveFunctor::live == 0);
+		}
+		SUBCASE("vector"){
+			{
+				std::vector<InlineDelegate> v;
+				for (int i = 0; i != 10; ++i)
+					v.push_back(InlineDelegate::make<LiveFunctor>(i));//reallocates
+
+				for (int i = 0; i != 10; ++i)
+					CHECK(v[i](1) == i + 1);
+				CHECK(LiveFunctor::live == 10);
+			}
+			CHECK(LiveFunctor::live == 0);
+		}
+	}
+
+	template<RefCounting Counting>
+	void TestSharedDelegate()
+	{
+		LiveFunctor::live = 0;
+		LiveFunctor::moves = 0;
+
+		using SharedDelegateT = SharedDelegate<int(int), Counting>;
+
+		SUBCASE("copies share the target"){
+			{
+				auto delegate = SharedDelegateT::template make<LiveFunctor>(1);
+				CHECK(delegate.useCount() == 1);
+				CHECK(delegate(1) == 2);
+				{
+					SharedDelegateT copy(delegate);
+					CHECK(copy.object() == delegate.object());
+					CHECK(copy(1) == 2);
+					CHECK(delegate.useCount() == 2);
+					CHECK(LiveFunctor::live == 1);
+				}
+				CHECK(delegate.useCount() == 1);
+				CHECK(LiveFunctor::live == 1);
+			}
+			CHECK(LiveFunctor::live == 0);
+			CHECK(LiveFunctor::moves == 0);
+		}
+		SUBCASE("target outlives the original delegate"){
+			SharedDelegateT copy;
+			CHECK(copy.useCount() == 0);
+			{
+				auto delegate = SharedDelegateT::make(
+					[p = std::make_unique<int>(2)](int i) { return i + *p; });
+				copy = delegate;
+			}
+			CHECK(copy.useCount() == 1);
+			CHECK(copy(1) == 3);
+		}
+		SUBCASE("copy="){
+			{
+				auto delegate = SharedDelegateT::template make<LiveFunctor>(1);
+				auto delegate2 = SharedDelegateT::template make<LiveFunctor>(2);
+				CHECK(LiveFunctor::live == 2);
+
+				delegate2 = delegate;
+				CHECK(LiveFunctor::live == 1);
+				CHECK(delegate2(1) == 2);
+				CHECK(delegate.useCount() == 2);
+
+				CLANG_SUPPRESS_WARNING_WITH_PUSH("-Wself-assign-overloaded")
+				delegate2 = delegate2;
+				CLANG_SUPPRESS_WARNING_POP
+				CHECK(delegate.useCount() == 2);
+			}
+			CHECK(LiveFunctor::live == 0);
+		}
+		SUBCASE("move"){
+			{
+				auto delegate = SharedDelegateT::template make<LiveFunctor>(1);
+				SharedDelegateT moved(std::move(delegate));
+
+				MSVC_SUPPRESS_WARNING_WITH_PUSH(26800) //use of a moved object
+				CHECK(delegate.useCount() == 0);
+				MSVC_SUPPRESS_WARNING_POP
+				CHECK(moved.useCount() == 1);
+				CHECK(moved(1) == 2);
+
+				auto delegate2 = SharedDelegateT::template make<LiveFunctor>(2);
+				delegate2 = std::move(moved);
+				CHECK(LiveFunctor::live == 1);
+				CHECK(delegate2(1) == 2);
+			}
+			CHECK(LiveFunctor::live == 0);
+			CHECK(LiveFunctor::moves == 0);
+		}
+		SUBCASE("assigned from a delegate owned by the target"){
+			//the target holds the last reference to the delegate it is assigned from
+			struct Holder
+			{
+				SharedDelegateT _held;
+
+				explicit Holder(SharedDelegateT held) :
+					_held(std::move(held))
+				{
+				}
+
+				int operator()(int i) { return i; }
+			};
+
+			for (bool move : { false, true })
+			{
+				auto holder = SharedDelegateT::template make<Holder>(SharedDelegateT::template make<LiveFunctor>(5));
+				SharedDelegateT& held = static_cast<Holder*>(holder.object())->_held;
+				if (move)
+					holder = std::move(held);
+				else
+					holder = held;
+				CHECK(holder.useCount() == 1);
+				CHECK(holder(1) == 6);
+			}
+			CHECK(LiveFunctor::live == 0);
+		}
+		SUBCASE("member function"){
+			Counter::reset();
+			auto set = SharedDelegateT::template make<&TestObject::set>();
+			auto copy = set;
+			CHECK(copy(-1) == -1);
+			CHECK(Counter::Val() == -1);
+		}
+		SUBCASE("vector"){
+			{
+				auto delegate = SharedDelegateT::template make<LiveFunctor>(1);
+				std::vector<SharedDelegateT> v(10, delegate);
+				CHECK(delegate.useCount() == 11);
+
+				for (auto& d : v)
+					CHECK(d(1) == 2);
+			}
+			CHECK(LiveFunctor::live == 0);
+		}
+	}
+
+	TEST_CASE("SharedDelegate/atomic reference counting")
+	{
+		TestSharedDelegate<RefCounting::Atomic>();
+	}
+
+	TEST_CASE("SharedDelegate/non-atomic reference counting")
+	{
+		TestSharedDelegate<RefCounting::NonAtomic>();
+	}
+
 	TEST_CASE("Delegate/vector")
 	{
 		Counter::reset();
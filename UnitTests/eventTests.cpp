@@ -1,5 +1,10 @@
+#include <algorithm>
+#include <array>
 #include <optional>
+#include <stdexcept>
+#include <string>
 #include <memory>
+#include <vector>
 
 #include "doctest.h"
 
@@ -86,8 +91,8 @@ struct SubscriberList
 using notified = SubscriberList;
 using unnotified = SubscriberList;
 
-template<typename Signature, unsigned N>
-void Check(Event<Signature,N>& e, notified&& n, unnotified&& un = {})
+template<typename Signature, unsigned N, DispatchOrder Order, EventStorage Storage>
+void Check(Event<Signature,N,Order,Storage>& e, notified&& n, unnotified&& un = {})
 {
 	for (count& ns : n.subscribers)
 		ns.s->takeSnapshot();
@@ -107,6 +112,44 @@ inline auto makeCallback(Subscriber& s)
 	return fromMethod<&Subscriber::notify>(s);
 }
 
+struct Kind
+{
+	std::vector<int>* log;
+	int kind;
+
+	void notify() { log->push_back(kind); }
+	void notifyOther() { log->push_back(kind + 10); }
+};
+
+//true IFF equal values in @log are adjacent
+bool IsGrouped(const std::vector<int>& log)
+{
+	std::vector<int> seen;
+	for (std::size_t i = 0; i != log.size(); ++i)
+	{
+		if (i != 0 && log[i] == log[i - 1])
+			continue;
+		if (std::find(seen.begin(), seen.end(), log[i]) != seen.end())
+			return false;
+		seen.push_back(log[i]);
+	}
+	return true;
+}
+
+template<DispatchOrder Order>
+void SubscribeInterleaved(Event<void(), 4, Order>& event,
+						  std::vector<Kind>& targets,
+						  std::vector<Subscription>& subscriptions)
+{
+	for (Kind& k : targets)
+	{
+		if (k.kind == 0)
+			event.subscribe(fromMethod<&Kind::notify>(&k), subscriptions);
+		else
+			event.subscribe(fromMethod<&Kind::notifyOther>(&k), subscriptions);
+	}
+}
+
 TEST_SUITE("event tests")
 {
 	TEST_CASE("empty event may be raised") {
@@ -379,6 +422,43 @@ TEST_SUITE("event tests")
 	}
 #endif
 
+	TEST_CASE("delegates are relocated by memcpy") {
+		static_assert(gch::is_trivially_relocatable<Delegate<void()>>::value);
+		static_assert(gch::is_trivially_relocatable<Subscription*>::value);
+		static_assert(!gch::is_trivially_relocatable<Subscription>::value);
+
+		std::vector<Subscriber> subscribers(100);
+		gch::small_vector<Delegate<void()>, 4> callbacks;
+		for (Subscriber& s : subscribers)
+			callbacks.push_back(makeCallback(s));
+
+		//inline storage
+		gch::small_vector<Delegate<void()>, 4> few;
+		few.push_back(makeCallback(subscribers[0]));
+		few.push_back(makeCallback(subscribers[1]));
+		gch::small_vector<Delegate<void()>, 4> moved = std::move(few);
+		CHECK(few.empty());
+		CHECK(moved.size() == 2);
+
+		for (auto& c : callbacks)
+			c();
+		for (auto& c : moved)
+			c();
+		subscribers[0].checkNotifiedTotal(2);
+		subscribers[1].checkNotifiedTotal(2);
+		subscribers[99].checkNotifiedTotal(1);
+
+		Event<void(), 2> event1;
+		std::vector<Subscription> subscriptions;
+		for (Subscriber& s : subscribers)
+			event1.subscribe(makeCallback(s), subscriptions);
+		Event<void(), 2> event2 = std::move(event1);
+		event2.raise();
+		subscribers[50].checkNotifiedTotal(2);
+		subscriptions.clear();
+		CHECK(event2.empty());
+	}
+
 	TEST_CASE("subscriptions are signature-agnostic") {
 
 		//one vector holds subscriptions from events
@@ -504,6 +584,1363 @@ TEST_SUITE("event tests")
 		}
 	}
 
+	TEST_CASE("dispatch order") {
+		std::vector<int> log;
+		std::vector<Kind> targets;
+		for (int i = 0; i != 12; ++i)
+			targets.push_back({&log, i % 2});
+
+		std::vector<Subscription> subscriptions;
+
+		SUBCASE("optimizeOrder() groups callbacks by target kind") {
+			Event<void(), 4> event;
+			SubscribeInterleaved(event, targets, subscriptions);
+
+			event.raise();
+			CHECK(log.size() == 12);
+			CHECK(!IsGrouped(log));
+
+			event.optimizeOrder();
+			log.clear();
+			event.raise();
+			CHECK(log.size() == 12);
+			CHECK(IsGrouped(log));
+
+			//subscriptions are still valid after reordering
+			subscriptions.erase(subscriptions.begin(), subscriptions.begin() + 5);
+			log.clear();
+			event.raise();
+			CHECK(log.size() == 7);
+			CHECK(std::count(log.begin(), log.end(), 0) == 3);
+			CHECK(std::count(log.begin(), log.end(), 11) == 4);
+
+			subscriptions.clear();
+			CHECK(event.empty());
+		}
+		SUBCASE("optimizeOrder() of an empty event") {
+			Event<void(), 4> event;
+			event.optimizeOrder();
+			event.raise();
+			CHECK(log.empty());
+		}
+		SUBCASE("DispatchOrder::Grouped reorders before raising") {
+			Event<void(), 4, DispatchOrder::Grouped> event;
+			SubscribeInterleaved(event, targets, subscriptions);
+
+			event.raise();
+			CHECK(log.size() == 12);
+			CHECK(IsGrouped(log));
+
+			subscriptions.erase(subscriptions.begin() + 3);
+			subscriptions.erase(subscriptions.begin());
+			event.subscribe(fromMethod<&Kind::notify>(targets[0]), subscriptions);
+
+			log.clear();
+			event.raise();
+			CHECK(log.size() == 11);
+			CHECK(IsGrouped(log));
+
+			auto moved = std::move(event);
+			log.clear();
+			moved.raise();
+			CHECK(log.size() == 11);
+			CHECK(IsGrouped(log));
+		}
+	}
+
+	TEST_CASE("FIFO and priority dispatch") {
+		std::vector<int> log;
+		std::vector<Kind> targets;
+		for (int i = 0; i != 8; ++i)
+			targets.push_back({&log, i});
+
+		std::vector<Subscription> subscriptions;
+
+		SUBCASE("Fifo invokes in the order of subscription") {
+			Event<void(), 4, DispatchOrder::Fifo> event;
+			for (Kind& k : targets)
+				event.subscribe(fromMethod<&Kind::notify>(&k), subscriptions);
+
+			event.raise();
+			CHECK(log == std::vector{0, 1, 2, 3, 4, 5, 6, 7});
+
+			//the order survives unsubscriptions, tombstones are compacted lazily
+			subscriptions.erase(subscriptions.begin() + 5);
+			subscriptions.erase(subscriptions.begin());
+			CHECK(event.count() == 6);
+			log.clear();
+			event.raise();
+			CHECK(log == std::vector{1, 2, 3, 4, 6, 7});
+
+			subscriptions.erase(subscriptions.begin() + 1);
+			event.subscribe(fromMethod<&Kind::notify>(&targets[0]), subscriptions);
+			log.clear();
+			event.raise();
+			CHECK(log == std::vector{1, 3, 4, 6, 7, 0});
+
+			//more than half tombstones without raising
+			subscriptions.erase(subscriptions.begin(), subscriptions.begin() + 4);
+			CHECK(event.count() == 2);
+			log.clear();
+			event.raise();
+			CHECK(log == std::vector{7, 0});
+
+			subscriptions.clear();
+			CHECK(event.empty());
+		}
+		SUBCASE("Priority invokes greater priorities first, FIFO within a priority") {
+			Event<void(), 4, DispatchOrder::Priority> event;
+			const int priorities[] = {0, 5, 0, -1, 5, 2, 0, 2};
+			for (int i = 0; i != 8; ++i)
+				event.subscribe(fromMethod<&Kind::notify>(&targets[i]), priorities[i], subscriptions);
+
+			event.raise();
+			CHECK(log == std::vector{1, 4, 5, 7, 0, 2, 6, 3});
+
+			//subscriptions are still valid after sorting
+			subscriptions.erase(subscriptions.begin() + 4);
+			subscriptions.erase(subscriptions.begin());
+			log.clear();
+			event.raise();
+			CHECK(log == std::vector{1, 5, 7, 2, 6, 3});
+
+			{
+				auto low = event.subscribe(fromMethod<&Kind::notify>(&targets[0]), -5);
+				auto high = event.subscribe(fromMethod<&Kind::notify>(&targets[4]), 5);
+				auto def = event.subscribe(fromMethod<&Kind::notify>(&targets[0]));
+				log.clear();
+				event.raise();
+				CHECK(log == std::vector{1, 4, 5, 7, 2, 6, 0, 3, 0});
+			}
+
+			log.clear();
+			event.raise();
+			CHECK(log == std::vector{1, 5, 7, 2, 6, 3});
+
+			auto moved = std::move(event);
+			log.clear();
+			moved.raise();
+			CHECK(log == std::vector{1, 5, 7, 2, 6, 3});
+		}
+		SUBCASE("Priority/move-assigned subscription keeps the priority of its callback") {
+			Event<void(), 4, DispatchOrder::Priority> event;
+			auto a = event.subscribe(fromMethod<&Kind::notify>(&targets[0]), 1);
+			auto b = event.subscribe(fromMethod<&Kind::notify>(&targets[1]), 0);
+			auto c = event.subscribe(fromMethod<&Kind::notify>(&targets[2]), 3);
+			event.raise();
+			CHECK(log == std::vector{2, 0, 1});
+
+			c = std::move(b);
+			log.clear();
+			event.raise();
+			CHECK(log == std::vector{0, 1});
+		}
+		SUBCASE("Priority/subscribed during dispatch") {
+			Event<void(), 4, DispatchOrder::Priority> event;
+			std::optional<Subscription> late;
+			auto lambda = [&]
+			{
+				log.push_back(100);
+				if (!late)
+					late.emplace(event.subscribe(fromMethod<&Kind::notify>(&targets[3]), 10));
+			};
+			auto s0 = event.subscribe(fromMethod<&Kind::notify>(&targets[0]), 1);
+			auto s1 = event.subscribe(fromFunctor(lambda), 0);
+
+			event.raise();
+			CHECK(log == std::vector{0, 100});
+
+			log.clear();
+			event.raise();
+			CHECK(log == std::vector{3, 0, 100});
+		}
+	}
+
+	TEST_CASE("collect") {
+		struct Answer
+		{
+			int value;
+
+			int get(int x) const { return value + x; }
+			bool is(int x) const { return value == x; }
+			std::optional<int> find(int x) const
+			{
+				if (value == x)
+					return value;
+				return std::nullopt;
+			}
+		};
+
+		Answer a{1}, b{5}, c{3};
+		std::vector<Subscription> subscriptions;
+
+		SUBCASE("sum, min, max") {
+			Event<int(int), 2> event;
+			CHECK(event.collect(combiners::Sum<int>{}, 10) == 0);
+			CHECK(!event.collect(combiners::Min<int>{}, 10));
+
+			event.subscribe(fromMethod<&Answer::get>(a), subscriptions);
+			event.subscribe(fromMethod<&Answer::get>(b), subscriptions);
+			event.subscribe(fromMethod<&Answer::get>(c), subscriptions);
+
+			CHECK(event.collect(combiners::Sum<int>{}, 10) == 39);
+			CHECK(event.collect(combiners::Min<int>{}, 10) == 11);
+			CHECK(event.collect(combiners::Max<int>{}, 10) == 15);
+
+			//results are discarded
+			event.raise(10);
+		}
+		SUBCASE("first non-empty stops raising") {
+			Event<std::optional<int>(int), 2, DispatchOrder::Fifo> event;
+			int nInvoked = 0;
+			auto counter = [&](int) -> std::optional<int> { ++nInvoked; return std::nullopt; };
+
+			event.subscribe(fromMethod<&Answer::find>(a), subscriptions);
+			event.subscribe(fromMethod<&Answer::find>(b), subscriptions);
+			event.subscribe(fromFunctor(counter), subscriptions);
+
+			CHECK(event.collect(combiners::FirstNonEmpty<std::optional<int>>{}, 5) == 5);
+			CHECK(nInvoked == 0);
+			CHECK(!event.collect(combiners::FirstNonEmpty<std::optional<int>>{}, 7));
+			CHECK(nInvoked == 1);
+		}
+		SUBCASE("all/any short-circuit") {
+			Event<bool(int), 2, DispatchOrder::Fifo> event;
+			CHECK(event.collect(combiners::All{}, 1));
+			CHECK(!event.collect(combiners::Any{}, 1));
+
+			int nInvoked = 0;
+			auto yes = [&](int) { ++nInvoked; return true; };
+
+			event.subscribe(fromMethod<&Answer::is>(a), subscriptions);
+			event.subscribe(fromFunctor(yes), subscriptions);
+
+			CHECK(!event.collect(combiners::All{}, 2));
+			CHECK(nInvoked == 0);
+			CHECK(event.collect(combiners::All{}, 1));
+			CHECK(nInvoked == 1);
+			CHECK(event.collect(combiners::Any{}, 1));
+			CHECK(nInvoked == 1);
+			CHECK(event.collect(combiners::Any{}, 2));
+			CHECK(nInvoked == 2);
+		}
+		SUBCASE("into span") {
+			Event<int(int), 2, DispatchOrder::Fifo> event;
+			event.subscribe(fromMethod<&Answer::get>(a), subscriptions);
+			event.subscribe(fromMethod<&Answer::get>(b), subscriptions);
+			event.subscribe(fromMethod<&Answer::get>(c), subscriptions);
+
+			std::array<int, 4> results{};
+			auto written = event.collect(combiners::IntoSpan<int>(results), 0);
+			CHECK(written.size() == 3);
+			CHECK(std::vector(written.begin(), written.end()) == std::vector{1, 5, 3});
+
+			std::array<int, 2> fewer{};
+			written = event.collect(combiners::IntoSpan<int>(fewer), 0);
+			CHECK(std::vector(written.begin(), written.end()) == std::vector{1, 5});
+		}
+		SUBCASE("custom combiner, unsubscription during collect") {
+			struct Average
+			{
+				int sum = 0;
+				int n = 0;
+
+				bool operator()(int r)
+				{
+					sum += r;
+					++n;
+					return true;
+				}
+
+				double result() const { return n ? double(sum) / n : 0.0; }
+			};
+
+			Event<int(int), 2> event;
+			auto unsubscribeAll = [&](int) { subscriptions.clear(); return 100; };
+			event.subscribe(fromFunctor(unsubscribeAll), subscriptions);
+			event.subscribe(fromMethod<&Answer::get>(a), subscriptions);
+			event.subscribe(fromMethod<&Answer::get>(b), subscriptions);
+
+			Average average;
+			CHECK(event.collect(average, 0) == 100.0);
+			CHECK(average.n == 1);
+			CHECK(event.empty());
+			CHECK(event.collect(Average{}, 0) == 0.0);
+		}
+	}
+
+	TEST_CASE("raiseUntil/raiseWhile") {
+		struct Handler
+		{
+			std::vector<int>* log;
+			int id;
+			int accepted;
+
+			bool handle(int key) const
+			{
+				log->push_back(id);
+				return key == accepted;
+			}
+		};
+
+		std::vector<int> log;
+		Handler text{&log, 0, 1}, shortcut{&log, 1, 2}, fallback{&log, 2, 3};
+
+		SUBCASE("raiseUntil stops at the consumer") {
+			Event<bool(int), 4, DispatchOrder::Priority> keyPressed;
+			auto sText = keyPressed.subscribe(fromMethod<&Handler::handle>(text), 0);
+			auto sFallback = keyPressed.subscribe(fromMethod<&Handler::handle>(fallback), -10);
+			auto sShortcut = keyPressed.subscribe(fromMethod<&Handler::handle>(shortcut), 10);
+
+			auto consumer = keyPressed.raiseUntil(2);
+			REQUIRE(consumer);
+			CHECK(*consumer == &sShortcut);
+			CHECK(log == std::vector{1});
+
+			log.clear();
+			consumer = keyPressed.raiseUntil(3);
+			REQUIRE(consumer);
+			CHECK(*consumer == &sFallback);
+			CHECK(log == std::vector{1, 0, 2});
+
+			log.clear();
+			CHECK(!keyPressed.raiseUntil(4));
+			CHECK(log == std::vector{1, 0, 2});
+		}
+		SUBCASE("raiseWhile stops at the first false") {
+			Event<bool(int), 4, DispatchOrder::Fifo> validate;
+			auto isPositive = [](int x) { return x > 0; };
+			auto isEven = [](int x) { return x % 2 == 0; };
+			auto s0 = validate.subscribe(fromFunctor(isPositive));
+			auto s1 = validate.subscribe(fromFunctor(isEven));
+
+			CHECK(!validate.raiseWhile(2));
+
+			auto failed = validate.raiseWhile(3);
+			REQUIRE(failed);
+			CHECK(*failed == &s1);
+
+			failed = validate.raiseWhile(-2);
+			REQUIRE(failed);
+			CHECK(*failed == &s0);
+		}
+		SUBCASE("empty event") {
+			Event<bool(int)> event;
+			CHECK(!event.raiseUntil(1));
+			CHECK(!event.raiseWhile(1));
+		}
+		SUBCASE("consumer unsubscribes itself, tombstones are skipped") {
+			Event<bool(int), 4, DispatchOrder::Fifo> event;
+			std::optional<Subscription> self, next;
+			auto once = [&](int) { self.reset(); next.reset(); return true; };
+			self.emplace(event.subscribe(fromFunctor(once)));
+			next.emplace(event.subscribe(fromMethod<&Handler::handle>(text)));
+			auto last = event.subscribe(fromMethod<&Handler::handle>(shortcut));
+
+			auto consumer = event.raiseUntil(0);
+			REQUIRE(consumer);
+			CHECK(*consumer == nullptr);
+			CHECK(log.empty());
+			CHECK(event.count() == 1);
+
+			consumer = event.raiseUntil(2);
+			REQUIRE(consumer);
+			CHECK(*consumer == &last);
+			CHECK(log == std::vector{1});
+		}
+	}
+
+	TEST_CASE("bulk subscription") {
+		Subscriber alice, bob, carol, dave;
+		std::vector<Delegate<void()>> callbacks{
+			makeCallback(alice), makeCallback(bob), makeCallback(carol)};
+
+		SUBCASE("subscribeMany into a vector") {
+			Event<void(), 2> event;
+			std::vector<Subscription> subscriptions;
+			event.subscribe(makeCallback(dave), subscriptions);
+			event.subscribeMany(callbacks, subscriptions);
+			CHECK(subscriptions.size() == 4);
+			CHECK(event.count() == 4);
+			Check(event, notified{&alice, &bob, &carol, &dave});
+
+			subscriptions.erase(subscriptions.begin() + 2);
+			Check(event, notified{&alice, &carol, &dave}, unnotified{&bob});
+
+			event.subscribeMany({}, subscriptions);
+			CHECK(event.count() == 3);
+		}
+		SUBCASE("SubscriptionGroup of several events") {
+			Event<void(), 2> event1;
+			Event<void(), 2, DispatchOrder::Fifo> event2;
+			Subscription survivor = event1.subscribe(makeCallback(dave));
+			{
+				SubscriptionGroup group;
+				event1.subscribeMany(callbacks, group);
+				event2.subscribeMany(callbacks, group);
+				event2.subscribe(makeCallback(dave), group);
+				event1.subscribe(makeCallback(carol)).move(group);
+				CHECK(group.size() == 8);
+				CHECK(event1.count() == 5);
+				CHECK(event2.count() == 4);
+
+				Check(event1, notified{&alice, &bob, count(&carol, 2), &dave});
+				event2.raise();
+			}
+			CHECK(event1.count() == 1);
+			CHECK(event2.empty());
+			Check(event1, notified{&dave}, unnotified{&alice, &bob, &carol});
+		}
+		SUBCASE("SubscriptionGroup outlives the event, moves and clear()") {
+			SubscriptionGroup group;
+			{
+				Event<void(), 2> event;
+				event.subscribeMany(callbacks, group);
+			}
+			Event<void(), 2> event;
+			event.subscribeMany(callbacks, group);
+			CHECK(event.count() == 3);
+
+			SubscriptionGroup moved = std::move(group);
+			CHECK(event.count() == 3);
+			Check(event, notified{&alice, &bob, &carol});
+
+			group = std::move(moved);
+			CHECK(event.count() == 3);
+			group.clear();
+			CHECK(group.empty());
+			CHECK(event.empty());
+		}
+		SUBCASE("subscribeMany and SubscriptionGroup during dispatch") {
+			Event<void(), 2> event;
+			std::optional<SubscriptionGroup> group{std::in_place};
+			int nRaised = 0;
+			auto churn = [&]
+			{
+				if (++nRaised == 1)
+					event.subscribeMany(callbacks, *group);
+				else
+					group.reset();
+			};
+			auto s = event.subscribe(fromFunctor(churn));
+
+			Check(event, notified{}, unnotified{&alice, &bob, &carol});
+			CHECK(event.count() == 4);
+			Check(event, notified{}, unnotified{&alice, &bob, &carol});
+			CHECK(event.count() == 1);
+		}
+	}
+
+	TEST_CASE("SubscriptionVector") {
+		std::vector<Subscriber> subscribers(100);
+		Event<void(), 2> event1;
+		Event<void(), 2, DispatchOrder::Fifo> event2;
+		Event<void(), 2, DispatchOrder::Unspecified, EventStorage::ControlBlock> event3;
+
+		auto checkAll = [&](int nTimes)
+		{
+			event1.raise();
+			event2.raise();
+			event3.raise();
+			for (Subscriber& s : subscribers)
+				s.checkNotifiedTotal(nTimes);
+		};
+
+		SUBCASE("growth across events") {
+			SubscriptionVector subscriptions;
+			for (std::size_t i = 0; i != subscribers.size(); ++i)
+			{
+				//runs of various lengths
+				switch (i % 7 % 3)
+				{
+				case 0: event1.subscribe(makeCallback(subscribers[i]), subscriptions); break;
+				case 1: event2.subscribe(makeCallback(subscribers[i]), subscriptions); break;
+				default: event3.subscribe(makeCallback(subscribers[i])).move(subscriptions); break;
+				}
+			}
+			CHECK(subscriptions.size() == 100);
+			CHECK(subscriptions.capacity() >= 100);
+			checkAll(1);
+
+			subscriptions.shrink_to_fit();
+			CHECK(subscriptions.capacity() == 100);
+			checkAll(2);
+
+			SubscriptionVector moved = std::move(subscriptions);
+			CHECK(subscriptions.empty());
+			checkAll(3);
+
+			moved.clear();
+			CHECK(event1.empty());
+			CHECK(event2.empty());
+			CHECK(event3.empty());
+		}
+		SUBCASE("erase") {
+			SubscriptionVector subscriptions;
+			std::vector<Delegate<void()>> callbacks;
+			for (Subscriber& s : subscribers)
+				callbacks.push_back(makeCallback(s));
+			event1.subscribeMany(std::span(callbacks).first(50), subscriptions);
+			event2.subscribeMany(std::span(callbacks).last(50), subscriptions);
+
+			Subscription* next = subscriptions.erase(subscriptions.begin() + 40,
+													 subscriptions.begin() + 60);
+			CHECK(next == subscriptions.begin() + 40);
+			CHECK(subscriptions.size() == 80);
+			CHECK(event1.count() == 40);
+			CHECK(event2.count() == 40);
+
+			subscriptions.erase(subscriptions.begin());
+			subscriptions.pop_back();
+			event1.raise();
+			event2.raise();
+			for (std::size_t i = 0; i != subscribers.size(); ++i)
+			{
+				bool erased = i == 0 || (40 <= i && i < 60) || i == 99;
+				subscribers[i].checkNotifiedTotal(erased ? 0 : 1);
+			}
+		}
+		SUBCASE("push_back of own element") {
+			SubscriptionVector subscriptions;
+			for (int i = 0; i != 4; ++i)
+				event1.subscribe(makeCallback(subscribers[i]), subscriptions);
+			CHECK(subscriptions.size() == subscriptions.capacity());
+
+			subscriptions.push_back(std::move(subscriptions[0]));
+			CHECK(subscriptions.size() == 5);
+			CHECK(event1.count() == 4);
+			subscriptions.erase(subscriptions.begin());
+			CHECK(event1.count() == 4);
+			subscriptions.back() = std::move(subscriptions[1]);
+			CHECK(event1.count() == 3);
+		}
+		SUBCASE("more events than cached") {
+			std::vector<Event<void(), 2>> events(20);
+			SubscriptionVector subscriptions;
+			for (std::size_t i = 0; i != subscribers.size(); ++i)
+				events[i % events.size()].subscribe(makeCallback(subscribers[i]), subscriptions);
+			subscriptions.shrink_to_fit();
+
+			for (auto& e : events)
+				e.raise();
+			for (Subscriber& s : subscribers)
+				s.checkNotifiedTotal(1);
+
+			subscriptions.clear();
+			for (auto& e : events)
+				CHECK(e.empty());
+		}
+		SUBCASE("events outlive or not") {
+			SubscriptionVector subscriptions;
+			{
+				Event<void(), 2> temporary;
+				temporary.subscribe(makeCallback(subscribers[0]), subscriptions);
+				event1.subscribe(makeCallback(subscribers[1]), subscriptions);
+			}
+			for (int i = 2; i != 10; ++i)
+				event1.subscribe(makeCallback(subscribers[i]), subscriptions);
+			subscriptions.erase(subscriptions.begin());
+			CHECK(event1.count() == 9);
+			event1.raise();
+			subscribers[1].checkNotifiedTotal(1);
+		}
+	}
+
+	TEST_CASE("slot map storage") {
+		using SlotEvent = Event<void(), 2, DispatchOrder::Unspecified, EventStorage::SlotMap>;
+		Subscriber alice, bob, carol;
+
+		SUBCASE("subscribe/unsubscribe") {
+			SlotEvent event;
+			std::optional<SlotSubscription> a = event.subscribe(makeCallback(alice));
+			std::optional<SlotSubscription> b = event.subscribe(makeCallback(bob));
+			CHECK(a->valid());
+			CHECK(event.count() == 2);
+			Check(event, notified{&alice, &bob});
+
+			a.reset();
+			CHECK(event.count() == 1);
+			Check(event, notified{&bob}, unnotified{&alice});
+
+			//the slot of alice is reused
+			a = event.subscribe(makeCallback(carol));
+			Check(event, notified{&bob, &carol}, unnotified{&alice});
+
+			b.reset();
+			a.reset();
+			CHECK(event.empty());
+		}
+		SUBCASE("moves don't touch the event") {
+			SlotEvent event;
+			SlotSubscription a = event.subscribe(makeCallback(alice));
+			SlotSubscription b = std::move(a);
+			CHECK(!a.valid());
+			CHECK(b.valid());
+			Check(event, notified{&alice});
+
+			SlotSubscription c = event.subscribe(makeCallback(bob));
+			c = std::move(b);
+			CHECK(event.count() == 1);
+			Check(event, notified{&alice}, unnotified{&bob});
+
+			c = event.subscribe(makeCallback(carol));
+			CHECK(event.count() == 1);
+			Check(event, notified{&carol}, unnotified{&alice});
+		}
+		SUBCASE("vector of subscriptions grows") {
+			SlotEvent event;
+			std::vector<SlotSubscription> subscriptions;
+			std::vector<Subscriber> subscribers(100);
+			for (Subscriber& s : subscribers)
+				event.subscribe(makeCallback(s), subscriptions);
+			event.subscribe(makeCallback(alice)).move(subscriptions);
+			CHECK(event.count() == 101);
+
+			subscriptions.erase(subscriptions.begin(), subscriptions.begin() + 50);
+			CHECK(event.count() == 51);
+			Check(event, notified{&alice});
+			for (std::size_t i = 0; i != subscribers.size(); ++i)
+				subscribers[i].checkNotifiedTotal(i < 50 ? 0 : 1);
+
+			subscriptions.clear();
+			CHECK(event.empty());
+		}
+		SUBCASE("stale subscriptions") {
+			std::optional<SlotSubscription> outlived;
+			{
+				SlotEvent event;
+				outlived = event.subscribe(makeCallback(alice));
+				CHECK(outlived->valid());
+			}
+			CHECK(!outlived->valid());
+			outlived.reset();
+
+			SlotEvent event;
+			SlotSubscription a = event.subscribe(makeCallback(alice));
+			event.clear();
+			CHECK(!a.valid());
+
+			//the cleared slot is reused, the stale handle doesn't remove the new record
+			SlotSubscription b = event.subscribe(makeCallback(bob));
+			a = event.subscribe(makeCallback(carol));
+			CHECK(event.count() == 2);
+			Check(event, notified{&bob, &carol});
+		}
+		SUBCASE("event move") {
+			SlotEvent event1;
+			SlotSubscription a = event1.subscribe(makeCallback(alice));
+			SlotEvent event2 = std::move(event1);
+			CHECK(a.valid());
+			CHECK(event1.empty());
+			Check(event2, notified{&alice});
+
+			SlotEvent event3;
+			SlotSubscription b = event3.subscribe(makeCallback(bob));
+			event3 = std::move(event2);
+			CHECK(!b.valid());
+			CHECK(a.valid());
+			Check(event3, notified{&alice}, unnotified{&bob});
+
+			SlotSubscription c = event1.subscribe(makeCallback(carol));
+			Check(event1, notified{&carol}, unnotified{&alice});
+		}
+		SUBCASE("reentrancy") {
+			SlotEvent event;
+			std::vector<SlotSubscription> subscriptions;
+			int nRaised = 0;
+			auto churn = [&]
+			{
+				if (++nRaised == 1)
+				{
+					event.subscribe(makeCallback(alice), subscriptions);
+					event.subscribe(makeCallback(bob), subscriptions);
+				}
+				else
+					subscriptions.erase(subscriptions.begin());
+			};
+			SlotSubscription s = event.subscribe(fromFunctor(churn));
+
+			Check(event, notified{}, unnotified{&alice, &bob});
+			CHECK(event.count() == 3);
+			Check(event, notified{&bob}, unnotified{&alice});
+			CHECK(event.count() == 2);
+		}
+		SUBCASE("FIFO and priority") {
+			std::vector<int> log;
+			std::vector<Kind> kinds{{&log, 1}, {&log, 2}, {&log, 3}};
+			Event<void(), 2, DispatchOrder::Priority, EventStorage::SlotMap> event;
+			std::vector<SlotSubscription> subscriptions;
+			event.subscribe(fromMethod<&Kind::notify>(&kinds[0]), subscriptions);
+			event.subscribe(fromMethod<&Kind::notify>(&kinds[1]), 5, subscriptions);
+			event.subscribe(fromMethod<&Kind::notify>(&kinds[2]), subscriptions);
+			event.raise();
+			CHECK(log == std::vector<int>{2, 1, 3});
+
+			subscriptions.erase(subscriptions.begin());
+			log.clear();
+			event.raise();
+			CHECK(log == std::vector<int>{2, 3});
+
+			Event<void(), 2, DispatchOrder::Fifo, EventStorage::SlotMap> fifo;
+			std::vector<Delegate<void()>> callbacks{
+				makeCallback(alice), makeCallback(bob), makeCallback(carol)};
+			std::vector<SlotSubscription> many;
+			fifo.subscribeMany(callbacks, many);
+			many.erase(many.begin() + 1);
+			Check(fifo, notified{&alice, &carol}, unnotified{&bob});
+		}
+	}
+
+	TEST_CASE("control block storage") {
+		using ControlledEvent = Event<void(), 2, DispatchOrder::Unspecified, EventStorage::ControlBlock>;
+		Subscriber alice, bob, carol;
+
+		SUBCASE("subscribe/unsubscribe") {
+			ControlledEvent event;
+			std::optional<Subscription> a = event.subscribe(makeCallback(alice));
+			std::vector<Subscription> subscriptions;
+			event.subscribe(makeCallback(bob), subscriptions);
+			event.subscribe(makeCallback(carol)).move(subscriptions);
+			Check(event, notified{&alice, &bob, &carol});
+
+			a.reset();
+			Check(event, notified{&bob, &carol}, unnotified{&alice});
+
+			subscriptions.erase(subscriptions.begin());
+			Check(event, notified{&carol}, unnotified{&alice, &bob});
+
+			a = std::move(subscriptions.back());
+			subscriptions.clear();
+			Check(event, notified{&carol}, unnotified{&alice, &bob});
+			a.reset();
+			CHECK(event.empty());
+		}
+		SUBCASE("subscriptions outlive the event") {
+			std::vector<Subscription> subscriptions;
+			{
+				ControlledEvent event;
+				event.subscribe(makeCallback(alice), subscriptions);
+				event.subscribe(makeCallback(bob), subscriptions);
+			}
+			Subscription moved = std::move(subscriptions.front());
+			subscriptions.front() = std::move(subscriptions.back());
+			subscriptions.clear();
+		}
+		SUBCASE("event move") {
+			ControlledEvent event1;
+			Subscription a = event1.subscribe(makeCallback(alice));
+			ControlledEvent event2 = std::move(event1);
+			CHECK(event1.empty());
+			Check(event2, notified{&alice});
+
+			ControlledEvent event3;
+			std::optional<Subscription> b = event3.subscribe(makeCallback(bob));
+			event3 = std::move(event2);
+			Check(event3, notified{&alice}, unnotified{&bob});
+
+			//the stale subscription does not touch the new records of event1
+			Subscription c = event1.subscribe(makeCallback(carol));
+			b.reset();
+			Check(event1, notified{&carol}, unnotified{&alice});
+			CHECK(event3.count() == 1);
+		}
+		SUBCASE("clear()") {
+			ControlledEvent event;
+			std::optional<Subscription> a = event.subscribe(makeCallback(alice));
+			event.clear();
+			Subscription b = event.subscribe(makeCallback(bob));
+			a.reset();
+			CHECK(event.count() == 1);
+			Check(event, notified{&bob}, unnotified{&alice});
+		}
+		SUBCASE("SubscriptionGroup") {
+			std::vector<Delegate<void()>> callbacks{
+				makeCallback(alice), makeCallback(bob), makeCallback(carol)};
+			ControlledEvent event1;
+			SubscriptionGroup group;
+			event1.subscribeMany(callbacks, group);
+			{
+				ControlledEvent event2;
+				event2.subscribeMany(callbacks, group);
+			}
+			Event<void(), 2> event3;
+			event3.subscribeMany(callbacks, group);
+			Check(event1, notified{&alice, &bob, &carol});
+			group.clear();
+			CHECK(event1.empty());
+			CHECK(event3.empty());
+		}
+		SUBCASE("reentrancy") {
+			ControlledEvent event;
+			std::optional<Subscription> a = event.subscribe(makeCallback(alice));
+			std::optional<Subscription> self;
+			auto unsubscribeAll = [&]
+			{
+				a.reset();
+				self.reset();
+			};
+			self = event.subscribe(fromFunctor(unsubscribeAll));
+			event.raise();
+			CHECK(event.empty());
+		}
+	}
+
+	TEST_CASE("subscription move-assigned across events") {
+		Subscriber alice, bob;
+		Event<void(), 2> event1;
+		Event<void(), 2, DispatchOrder::Fifo> event2;
+		Subscription a = event1.subscribe(makeCallback(alice));
+		Subscription b = event2.subscribe(makeCallback(bob));
+		a = std::move(b);
+		CHECK(event1.empty());
+		CHECK(event2.count() == 1);
+		event2.raise();
+		bob.checkNotifiedTotal(1);
+		alice.checkNotifiedTotal(0);
+	}
+
+	TEST_CASE("batchable subscriptions") {
+		std::vector<int> log;
+		std::vector<Kind> targets;
+		for (int i = 0; i != 6; ++i)
+			targets.push_back({&log, i % 2});
+
+		std::vector<Subscription> subscriptions;
+
+		SUBCASE("runs of the same method") {
+			Event<void(), 4> event;
+			for (Kind& k : targets)
+				event.subscribe<&Kind::notify>(k, subscriptions);
+			event.subscribe(fromMethod<&Kind::notifyOther>(&targets[0]), subscriptions);
+
+			event.raise();
+			CHECK(log.size() == 7);
+			CHECK(std::count(log.begin(), log.end(), 10) == 1);
+
+			//unsubscription breaks runs into pieces
+			subscriptions.erase(subscriptions.begin() + 1);
+			log.clear();
+			event.raise();
+			CHECK(log.size() == 6);
+			CHECK(std::count(log.begin(), log.end(), 10) == 1);
+		}
+		SUBCASE("interleaved methods") {
+			Event<void(), 4> event;
+			for (Kind& k : targets)
+			{
+				if (k.kind == 0)
+					event.subscribe<&Kind::notify>(k, subscriptions);
+				else
+					event.subscribe<&Kind::notifyOther>(k, subscriptions);
+			}
+
+			event.raise();
+			CHECK(log == std::vector{0, 11, 0, 11, 0, 11});
+
+			event.optimizeOrder();
+			log.clear();
+			event.raise();
+			CHECK(log.size() == 6);
+			CHECK(IsGrouped(log));
+		}
+		SUBCASE("scalar subscription") {
+			Event<void(), 4, DispatchOrder::Grouped> event;
+			{
+				Subscription s = event.subscribe<&Kind::notify>(targets[0]);
+				event.raise();
+				CHECK(log.size() == 1);
+			}
+			event.raise();
+			CHECK(log.size() == 1);
+			CHECK(event.empty());
+		}
+		SUBCASE("batchable subscriptions after the previous ones ended") {
+			Event<void(), 4> event;
+			event.subscribe<&Kind::notify>(targets[0], subscriptions);
+			event.subscribe(fromMethod<&Kind::notifyOther>(&targets[1]), subscriptions);
+			subscriptions.erase(subscriptions.begin());
+
+			//finds no run and stops checking for them
+			event.raise();
+			CHECK(log == std::vector{11});
+
+			event.subscribe<&Kind::notify>(targets[2], subscriptions);
+			event.subscribe<&Kind::notify>(targets[4], subscriptions);
+			log.clear();
+			event.raise();
+			CHECK(log == std::vector{11, 0, 0});
+
+			event.clear();
+			event.subscribe<&Kind::notifyOther>(targets[3], subscriptions);
+			event.subscribe<&Kind::notifyOther>(targets[5], subscriptions);
+			log.clear();
+			event.raise();
+			CHECK(log == std::vector{11, 11});
+		}
+	}
+
+	struct Listener
+	{
+		int sum = 0;
+
+		void onPrice(int price) { sum += price; }
+		void check(int* out) const { *out += sum; }
+	};
+
+	TEST_CASE("MethodEvent") {
+		Listener a, b, c;
+
+		SUBCASE("subscribe/unsubscribe") {
+			MethodEvent<&Listener::onPrice, 2> event;
+			static_assert(std::is_same_v<decltype(event.subscribe(a)), Subscription>);
+
+			std::optional<Subscription> subA { std::in_place, event.subscribe(a) };
+			std::optional<Subscription> subB { std::in_place, event.subscribe(&b) };
+			std::vector<Subscription> subscriptions;
+			event.subscribe(c, subscriptions);
+			CHECK(event.count() == 3);
+
+			event.raise(1);
+			event(2);
+			CHECK(a.sum == 3);
+			CHECK(b.sum == 3);
+			CHECK(c.sum == 3);
+
+			subA.reset();
+			event.raise(10);
+			CHECK(a.sum == 3);
+			CHECK(b.sum == 13);
+			CHECK(c.sum == 13);
+
+			subscriptions.clear();
+			event.raise(100);
+			CHECK(b.sum == 113);
+			CHECK(c.sum == 13);
+			CHECK(event.count() == 1);
+		}
+		SUBCASE("const member function, const objects") {
+			MethodEvent<&Listener::check> event;
+			const Listener constListener{ 5 };
+			a.sum = 1;
+			auto subA = event.subscribe(a);
+			auto subConst = event.subscribe(constListener);
+
+			int total = 0;
+			event.raise(&total);
+			CHECK(total == 6);
+		}
+		SUBCASE("subscriptions of Event and MethodEvent in one vector") {
+			std::vector<Subscription> subscriptions;
+
+			MethodEvent<&Listener::onPrice> methodEvent;
+			methodEvent.subscribe(a, subscriptions);
+
+			Event<void(int)> event;
+			event.subscribe(fromMethod<&Listener::onPrice>(&b), subscriptions);
+
+			methodEvent(1);
+			event(2);
+			CHECK(a.sum == 1);
+			CHECK(b.sum == 2);
+
+			subscriptions.clear();
+			CHECK(methodEvent.empty());
+			CHECK(event.empty());
+		}
+		SUBCASE("move") {
+			std::optional<MethodEvent<&Listener::onPrice>> src{ std::in_place };
+			auto subA = src->subscribe(a);
+			auto subB = src->subscribe(b);
+
+			MethodEvent<&Listener::onPrice> dst(std::move(*src));
+			src.reset();
+			dst.raise(1);
+			CHECK(a.sum == 1);
+			CHECK(b.sum == 1);
+		}
+		SUBCASE("subscription outlives event") {
+			std::optional<Subscription> subA;
+			{
+				MethodEvent<&Listener::onPrice> event;
+				subA.emplace(event.subscribe(a));
+			}
+			subA.reset();
+		}
+	}
+
+	void addPrice(int price, int* out)
+	{
+		*out += price;
+	}
+
+	struct Accumulator
+	{
+		int sum = 0;
+
+		void onPrice(int price, int* out) { sum += price; *out += price; }
+	};
+
+	TEST_CASE("EventQueue") {
+		EventQueue<void(const std::string&, int)> queue;
+		std::vector<std::string> log;
+		auto first = [&log](const std::string& s, int i) { log.push_back("a" + s + std::to_string(i)); };
+		auto second = [&log](const std::string& s, int i) { log.push_back("b" + s + std::to_string(i)); };
+		Subscription a = queue.subscribe(fromFunctor(first));
+		Subscription b = queue.subscribe(fromFunctor(second));
+
+		std::string text = "x";
+		queue.enqueue(text, 1);
+		queue.enqueue("y", 2);
+		text.clear();
+		CHECK(queue.queued() == 2);
+		CHECK(log.empty());
+
+		SUBCASE("item-major") {
+			CHECK(queue.dispatch() == 2);
+			CHECK(log == std::vector<std::string>{ "ax1", "bx1", "ay2", "by2" });
+		}
+		SUBCASE("subscriber-major") {
+			CHECK(queue.dispatch(QueueDispatch::SubscriberMajor) == 2);
+			CHECK(log == std::vector<std::string>{ "ax1", "ay2", "bx1", "by2" });
+		}
+		SUBCASE("immediate raise and discarded items") {
+			queue.raise("z", 3);
+			CHECK(log == std::vector<std::string>{ "az3", "bz3" });
+			queue.discardQueued();
+			CHECK(queue.dispatch() == 0);
+			CHECK(log.size() == 2);
+		}
+		CHECK(queue.queued() == 0);
+		CHECK(queue.dispatch() == 0);
+	}
+
+	TEST_CASE("EventQueue/reentrancy") {
+		EventQueue<void(int), internal::ExpectedSubscriptionsDefault, DispatchOrder::Fifo> queue;
+		std::vector<int> log;
+		std::optional<Subscription> a, b;
+
+		SUBCASE("unsubscription during subscriber-major dispatch") {
+			auto once = [&](int i) { log.push_back(i); a.reset(); };
+			auto all = [&](int i) { log.push_back(10 * i); };
+			a = queue.subscribe(fromFunctor(once));
+			b = queue.subscribe(fromFunctor(all));
+			queue.enqueue(1);
+			queue.enqueue(2);
+
+			queue.dispatch(QueueDispatch::SubscriberMajor);
+			CHECK(log == std::vector<int>{ 1, 10, 20 });
+			CHECK(queue.count() == 1);
+		}
+		SUBCASE("items enqueued during dispatch go to the next batch") {
+			auto requeue = [&](int i)
+			{
+				log.push_back(i);
+				if (i < 3)
+					queue.enqueue(i + 1);
+			};
+			a = queue.subscribe(fromFunctor(requeue));
+			queue.enqueue(1);
+
+			CHECK(queue.dispatch(QueueDispatch::SubscriberMajor) == 1);
+			CHECK(queue.dispatch() == 1);
+			CHECK(queue.dispatch() == 1);
+			CHECK(queue.dispatch() == 0);
+			CHECK(log == std::vector<int>{ 1, 2, 3 });
+		}
+	}
+
+	TEST_CASE("EventQueue/rvalue parameters") {
+		EventQueue<void(std::unique_ptr<int>&&)> queue;
+		int sum = 0;
+		auto take = [&sum](std::unique_ptr<int>&& p)
+		{
+			std::unique_ptr<int> taken = std::move(p);
+			sum += *taken;
+		};
+		Subscription s = queue.subscribe(fromFunctor(take));
+
+		queue.enqueue(std::make_unique<int>(4));
+		queue.enqueue(std::make_unique<int>(5));
+		queue.dispatch(QueueDispatch::SubscriberMajor);
+		CHECK(sum == 9);
+	}
+
+	TEST_CASE("CoalescingEvent") {
+		CoalescingEvent<void(const std::string&, int)> changed;
+		std::vector<std::string> log;
+		auto record = [&log](const std::string& s, int i) { log.push_back(s + std::to_string(i)); };
+		Subscription a = changed.subscribe(fromFunctor(record));
+		Subscription b = changed.subscribe(fromFunctor(record));
+		CHECK(!changed.pending());
+		CHECK(!changed.flush());
+
+		std::string text = "x";
+		changed.post(text, 1);
+		changed.post("y", 2);
+		changed.post("z", 3);
+		text.clear();
+		CHECK(changed.pending());
+		CHECK(log.empty());
+
+		SUBCASE("the latest raise wins") {
+			CHECK(changed.flush());
+			CHECK(log == std::vector<std::string>{ "z3", "z3" });
+			CHECK(!changed.pending());
+			CHECK(!changed.flush());
+			CHECK(log.size() == 2);
+		}
+		SUBCASE("immediate raise and discarded notification") {
+			changed.raise("w", 4);
+			CHECK(log == std::vector<std::string>{ "w4", "w4" });
+			CHECK(changed.pending());
+			changed.discardPending();
+			CHECK(!changed.pending());
+			CHECK(!changed.flush());
+			CHECK(log.size() == 2);
+		}
+	}
+
+	TEST_CASE("CoalescingEvent/reducer") {
+		auto accumulate = [](int& dx, int& dy, int x, int y) { dx += x; dy += y; };
+		CoalescingEvent<void(int, int), decltype(accumulate)> moved(accumulate);
+		std::vector<int> log;
+		auto record = [&log](int dx, int dy) { log.push_back(dx); log.push_back(dy); };
+		Subscription s = moved.subscribe(fromFunctor(record));
+
+		for (int i = 1; i <= 4; ++i)
+			moved.post(i, -i);
+		CHECK(moved.flush());
+		CHECK(log == std::vector<int>{ 10, -10 });
+
+		SUBCASE("raises posted during flush go to the next flush") {
+			std::optional<Subscription> repost;
+			bool reposted = false;
+			auto again = [&](int, int) { if (!std::exchange(reposted, true)) moved.post(1, 0); };
+			repost = moved.subscribe(fromFunctor(again));
+
+			moved.post(11, 0);
+			CHECK(moved.flush());
+			CHECK(moved.pending());
+			CHECK(moved.flush());
+			CHECK(!moved.flush());
+			CHECK(log == std::vector<int>{ 10, -10, 11, 0, 1, 0 });
+		}
+	}
+
+	TEST_CASE("CoalescingEvent/rvalue parameters") {
+		CoalescingEvent<void(std::unique_ptr<int>&&)> event;
+		int sum = 0;
+		auto take = [&sum](std::unique_ptr<int>&& p)
+		{
+			std::unique_ptr<int> taken = std::move(p);
+			sum += *taken;
+		};
+		Subscription s = event.subscribe(fromFunctor(take));
+
+		event.post(std::make_unique<int>(4));
+		event.post(std::make_unique<int>(5));
+		CHECK(event.flush());
+		CHECK(sum == 5);
+	}
+
+	TEST_CASE("StaticEvent") {
+		std::vector<int> order;
+		Accumulator accumulator;
+
+		auto event = makeStaticEvent<void(int, int*)>(
+			[&order](int, int*) { order.push_back(1); },
+			tag<&addPrice>(),
+			callMethod<&Accumulator::onPrice>(accumulator),
+			[&order](int price, int* out) { order.push_back(2); *out += price; });
+
+		static_assert(decltype(event)::count() == 4);
+
+		int out = 0;
+		event.raise(10, &out);
+		CHECK(out == 30);
+		CHECK(accumulator.sum == 10);
+		CHECK(order == std::vector{1, 2});
+
+		event(1, &out);
+		CHECK(out == 33);
+		CHECK(accumulator.sum == 11);
+
+		SUBCASE("callMethod with object pointer") {
+			StaticEvent<void(int, int*), MethodCall<&Accumulator::onPrice, Accumulator>>
+				pointerEvent(callMethod<&Accumulator::onPrice>(&accumulator));
+			pointerEvent(1, &out);
+			CHECK(accumulator.sum == 12);
+		}
+		SUBCASE("empty") {
+			StaticEvent<void()> empty;
+			empty.raise();
+			static_assert(decltype(empty)::count() == 0);
+		}
+	}
+
+	TEST_CASE("reentrancy") {
+		Event<void(), 2> event;
+		Subscriber alice, bob, carol;
+		std::vector<Subscription> subscriptions;
+
+		SUBCASE("callback unsubscribes itself") {
+			std::optional<Subscription> self;
+			int nSelf = 0;
+			auto unsubscribeSelf = [&]() { ++nSelf; self.reset(); };
+
+			alice.subscription.emplace(event.subscribe(makeCallback(alice)));
+			self.emplace(event.subscribe(fromFunctor(unsubscribeSelf)));
+			bob.subscription.emplace(event.subscribe(makeCallback(bob)));
+
+			Check(event, notified{&alice, &bob});
+			CHECK(nSelf == 1);
+			CHECK(event.count() == 2);
+
+			Check(event, notified{&alice, &bob});
+			CHECK(nSelf == 1);
+		}
+		SUBCASE("callback unsubscribes everyone") {
+			auto unsubscribeAll = [&]() { subscriptions.clear(); };
+
+			event.subscribe(makeCallback(alice), subscriptions);
+			event.subscribe(fromFunctor(unsubscribeAll), subscriptions);
+			event.subscribe(makeCallback(bob), subscriptions);
+			event.subscribe(makeCallback(carol), subscriptions);
+
+			Check(event, notified{&alice}, unnotified{&bob, &carol});
+			CHECK(event.empty());
+			Check(event, notified{}, unnotified{&alice, &bob, &carol});
+		}
+		SUBCASE("callback subscribes others") {
+			std::vector<Subscriber> late(50);
+			auto subscribeLate = [&]()
+			{
+				for (Subscriber& s : late)
+					event.subscribe(makeCallback(s), subscriptions);
+			};
+			std::optional<Subscription> subscriber {
+				std::in_place, event.subscribe(fromFunctor(subscribeLate)) };
+			alice.subscription.emplace(event.subscribe(makeCallback(alice)));
+
+			//the new subscriptions reallocate the records
+			Check(event, notified{&alice}, unnotified{&late[0], &late[49]});
+			CHECK(event.count() == 52);
+
+			subscriber.reset();
+			Check(event, notified{&alice, &late[0], &late[49]});
+			CHECK(event.count() == 51);
+		}
+		SUBCASE("callback subscribes and unsubscribes a new subscription") {
+			auto subscribeUnsubscribe = [&]()
+			{
+				Subscription s = event.subscribe(makeCallback(carol));
+				event.subscribe(makeCallback(bob), subscriptions);
+			};
+			std::optional<Subscription> subscriber {
+				std::in_place, event.subscribe(fromFunctor(subscribeUnsubscribe)) };
+
+			Check(event, notified{}, unnotified{&bob, &carol});
+			CHECK(event.count() == 2);
+
+			subscriber.reset();
+			Check(event, notified{&bob}, unnotified{&carol});
+		}
+		SUBCASE("recursive raise") {
+			int depth = 0;
+			auto recurse = [&]()
+			{
+				if (++depth < 3)
+					event.raise();
+				else
+					alice.subscription.reset();
+			};
+			std::optional<Subscription> recursion {
+				std::in_place, event.subscribe(fromFunctor(recurse)) };
+			alice.subscription.emplace(event.subscribe(makeCallback(alice)));
+			bob.subscription.emplace(event.subscribe(makeCallback(bob)));
+
+			//the innermost raise unsubscribes alice before anyone is notified
+			Check(event, notified{count(&bob, 3)}, unnotified{&alice});
+			CHECK(event.count() == 2);
+		}
+		SUBCASE("subscription moved during dispatch") {
+			auto move = [&]() { alice.subscription = std::move(bob.subscription); };
+			std::optional<Subscription> mover {
+				std::in_place, event.subscribe(fromFunctor(move)) };
+			alice.subscription.emplace(event.subscribe(makeCallback(alice)));
+			bob.subscription.emplace(event.subscribe(makeCallback(bob)));
+
+			//alice's record now holds bob's callback
+			Check(event, notified{&bob}, unnotified{&alice});
+			CHECK(event.count() == 2);
+
+			mover.reset();
+			Check(event, notified{&bob}, unnotified{&alice});
+		}
+		SUBCASE("clear() during dispatch") {
+			auto clear = [&]() { event.clear(); };
+			event.subscribe(fromFunctor(clear), subscriptions);
+			event.subscribe(makeCallback(alice), subscriptions);
+
+			Check(event, notified{}, unnotified{&alice});
+			CHECK(event.empty());
+		}
+		SUBCASE("exception during dispatch") {
+			auto unsubscribeAndThrow = [&]()
+			{
+				alice.subscription.reset();
+				throw std::runtime_error("callback failed");
+			};
+			std::optional<Subscription> thrower {
+				std::in_place, event.subscribe(fromFunctor(unsubscribeAndThrow)) };
+			alice.subscription.emplace(event.subscribe(makeCallback(alice)));
+
+			CHECK_THROWS_AS(event.raise(), std::runtime_error);
+			CHECK(event.count() == 1);
+
+			thrower.reset();
+			bob.subscription.emplace(event.subscribe(makeCallback(bob)));
+			Check(event, notified{&bob}, unnotified{&alice});
+			CHECK(event.count() == 1);
+		}
+		SUBCASE("batchable callbacks unsubscribe each other") {
+			std::vector<Subscriber> batch(4);
+			auto unsubscribeNext = [&]() { subscriptions.erase(subscriptions.begin() + 2); };
+
+			event.subscribe<&Subscriber::notify>(batch[0], subscriptions);
+			event.subscribe(fromFunctor(unsubscribeNext), subscriptions);
+			event.subscribe<&Subscriber::notify>(batch[1], subscriptions);
+			event.subscribe<&Subscriber::notify>(batch[2], subscriptions);
+
+			Check(event, notified{&batch[0], &batch[2]}, unnotified{&batch[1]});
+		}
+	}
+
+	TEST_CASE("MethodEvent/reentrancy") {
+		struct SelfUnsubscriber
+		{
+			std::optional<Subscription> subscription;
+			int nNotified = 0;
+
+			void notify()
+			{
+				++nNotified;
+				subscription.reset();
+			}
+		};
+
+		MethodEvent<&SelfUnsubscriber::notify> event;
+		SelfUnsubscriber a, b;
+		a.subscription.emplace(event.subscribe(a));
+		b.subscription.emplace(event.subscribe(b));
+
+		event.raise();
+		event.raise();
+		CHECK(a.nNotified == 1);
+		CHECK(b.nNotified == 1);
+		CHECK(event.empty());
+	}
+
 	TEST_CASE("event move/empty events") {
 		SUBCASE("move-construct from an empty event"){
 			Event eventSrc;
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+#include "CallMe.TaskPool.h"
+
+using namespace CallMe;
+
+namespace
+{
+	template<typename Pool>
+	long fib(Pool& pool, int n)
+	{
+		if (n < 2)
+			return n;
+
+		long a = 0;
+		TaskGroup children;
+		pool.spawn(children, [&pool, &a, n] { a = fib(pool, n - 1); });
+		const long b = fib(pool, n - 2);
+		pool.wait(children);
+		return a + b;
+	}
+
+	template<typename Pool>
+	void quicksort(Pool& pool, int* first, int* last)
+	{
+		while (last - first > 32)
+		{
+			const int pivot = first[(last - first) / 2];
+			int* middle = std::partition(first, last, [pivot](int i) { return i < pivot; });
+			int* upper = std::partition(middle, last, [pivot](int i) { return i == pivot; });
+
+			TaskGroup children;
+			pool.spawn(children, [&pool, first, middle] { quicksort(pool, first, middle); });
+			first = upper;
+			quicksort(pool, first, last);
+			pool.wait(children);
+			return;
+		}
+		std::sort(first, last);
+	}
+}
+
+TEST_SUITE("task pool tests")
+{
+	TEST_CASE("spawned tasks run once") {
+		for (std::size_t nWorkers : { 0, 1, 3 })
+		{
+			TaskPool<> pool(nWorkers);
+			CHECK(pool.workers() == nWorkers);
+
+			std::vector<std::atomic<int>> runs(2'000);
+			TaskGroup group;
+			CHECK(group.done());
+			for (std::atomic<int>& r : runs)
+				pool.spawn(group, [&r] { ++r; });
+			pool.wait(group);
+			CHECK(group.done());
+
+			int wrong = 0;
+			for (std::atomic<int>& r : runs)
+				wrong += r != 1;
+			CHECK(wrong == 0);
+
+			//waiting for a done group returns at once
+			pool.wait(group);
+		}
+	}
+
+	TEST_CASE("fork-join") {
+		TaskPool<> pool(3);
+
+		SUBCASE("fib") {
+			CHECK(fib(pool, 20) == 6'765);
+		}
+		SUBCASE("quicksort") {
+			std::vector<int> v(50'000);
+			std::mt19937 random(7);
+			for (int& i : v)
+				i = int(random() % 1'000);
+			quicksort(pool, v.data(), v.data() + v.size());
+			CHECK(std::is_sorted(v.begin(), v.end()));
+		}
+		SUBCASE("a task spawns more tasks than a deque holds at first") {
+			std::atomic<int> sum{ 0 };
+			TaskGroup outer;
+			pool.spawn(outer, [&]
+			{
+				TaskGroup inner;
+				for (int i = 1; i <= 5'000; ++i)
+					pool.spawn(inner, [&sum, i] { sum += i; });
+				pool.wait(inner);
+			});
+			pool.wait(outer);
+			CHECK(sum == 5'000 * 5'001 / 2);
+		}
+	}
+
+	TEST_CASE("task storage") {
+		TaskPool<32> pool(2);
+		TaskGroup group;
+		auto counter = std::make_shared<int>(0);
+
+		SUBCASE("captures are destroyed before wait returns") {
+			for (int i = 0; i != 100; ++i)
+				pool.spawn(group, [counter] { (void)counter; });
+			pool.wait(group);
+			CHECK(counter.use_count() == 1);
+		}
+		SUBCASE("move-only and oversized functors") {
+			std::atomic<int> sum{ 0 };
+			auto owned = std::make_unique<int>(5);
+			pool.spawn(group, [&sum, owned = std::move(owned)] { sum += *owned; });
+
+			std::array<int, 64> big{};
+			std::iota(big.begin(), big.end(), 0);
+			pool.spawn(group, [&sum, big, counter] { sum += std::accumulate(big.begin(), big.end(), 0); });
+			pool.wait(group);
+			CHECK(sum == 5 + 63 * 64 / 2);
+			CHECK(counter.use_count() == 1);
+		}
+		SUBCASE("delegates") {
+			struct Adder
+			{
+				std::atomic<int>* _sum;
+				void add() { ++*_sum; }
+			};
+			std::atomic<int> sum{ 0 };
+			pool.spawn(group, TaskPool<32>::TaskT::make<&Adder::add>(&sum));
+			TaskPool<32>::TaskT task = TaskPool<32>::TaskT::make([&sum] { sum += 10; });
+			pool.spawn(group, std::move(task));
+			pool.wait(group);
+			CHECK(sum == 11);
+		}
+	}
+
+	TEST_CASE("spawning and waiting on many threads") {
+		TaskPool<> pool(2);
+		constexpr int nThreads = 4;
+		std::atomic<long> total{ 0 };
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t != nThreads; ++t)
+		{
+			threads.emplace_back([&, t]
+			{
+				for (int round = 0; round != 20; ++round)
+				{
+					TaskGroup group;
+					std::atomic<long> sum{ 0 };
+					for (int i = 0; i != 100; ++i)
+						pool.spawn(group, [&sum, i] { sum += i; });
+					if (t == 0)
+						CHECK(fib(pool, 10) == 55);
+					pool.wait(group);
+					CHECK(sum == 99 * 100 / 2);
+					total += sum;
+				}
+			});
+		}
+		for (std::thread& t : threads)
+			t.join();
+		CHECK(total == nThreads * 20 * (99 * 100 / 2));
+	}
+
+	TEST_CASE("pools of one thread") {
+		TaskPool<> first(1), second(1);
+		TaskGroup outer;
+		std::atomic<long> result{ 0 };
+
+		//a worker of the first pool spawns on the second one and waits for it
+		first.spawn(outer, [&]
+		{
+			result = fib(second, 12);
+			result += fib(first, 12);
+		});
+		first.wait(outer);
+		CHECK(result == 288);
+	}
+}
@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+
+#include "CallMe.TimerWheel.h"
+
+using namespace CallMe;
+using namespace std::chrono_literals;
+
+namespace
+{
+	//a clock that only moves when a test sets _now
+	struct ManualClock
+	{
+		using rep = std::int64_t;
+		using period = std::milli;
+		using duration = std::chrono::milliseconds;
+		using time_point = std::chrono::time_point<ManualClock>;
+		static constexpr bool is_steady = true;
+
+		time_point* _now;
+
+		time_point now() const
+		{
+			return *_now;
+		}
+	};
+
+	using Wheel = TimerWheel<ManualClock>;
+
+	struct Alarm
+	{
+		void ring()
+		{
+			++_rings;
+		}
+
+		int _rings = 0;
+	};
+}
+
+TEST_SUITE("timer wheel tests")
+{
+	TEST_CASE("schedule, expire, cancel") {
+		ManualClock::time_point now{};
+		Wheel wheel(1ms, ManualClock{ &now });
+		Alarm alice, bob;
+		CHECK(wheel.empty());
+
+		Timer a = wheel.schedule(5ms, fromMethod<&Alarm::ring>(&alice));
+		Timer b = wheel.schedule(5ms, fromMethod<&Alarm::ring>(&bob));
+		CHECK(wheel.count() == 2);
+		CHECK(a.scheduled());
+
+		now += 4ms;
+		CHECK(wheel.advance() == 0);
+		CHECK(alice._rings == 0);
+
+		SUBCASE("expire") {
+			now += 1ms;
+			CHECK(wheel.advance() == 2);
+			CHECK(alice._rings == 1);
+			CHECK(bob._rings == 1);
+			CHECK(!a.scheduled());
+			CHECK(wheel.empty());
+		}
+		SUBCASE("cancel and destroy") {
+			a.cancel();
+			CHECK(!a.scheduled());
+			{
+				Timer moved = std::move(b);
+				CHECK(!b.scheduled());
+				CHECK(moved.scheduled());
+			}
+			CHECK(wheel.empty());
+			now += 1ms;
+			CHECK(wheel.advance() == 0);
+			CHECK(alice._rings + bob._rings == 0);
+		}
+		SUBCASE("move-assign") {
+			a = std::move(b);
+			CHECK(wheel.count() == 1);
+			now += 1ms;
+			CHECK(wheel.advance() == 1);
+			CHECK(alice._rings == 0);
+			CHECK(bob._rings == 1);
+		}
+	}
+
+	TEST_CASE("timers never expire early") {
+		ManualClock::time_point now{};
+		Wheel wheel(10ms, ManualClock{ &now });
+		Alarm alarm;
+
+		now += 3ms;
+		Timer t = wheel.schedule(15ms, fromMethod<&Alarm::ring>(&alarm));
+
+		//due at 18ms, rounded up to the tick at 20ms
+		now = ManualClock::time_point(19ms);
+		CHECK(wheel.advance() == 0);
+		now = ManualClock::time_point(20ms);
+		CHECK(wheel.advance() == 1);
+
+		//a time in the past expires on the next tick
+		Timer late = wheel.scheduleAt(ManualClock::time_point(5ms), fromMethod<&Alarm::ring>(&alarm));
+		CHECK(wheel.advance() == 0);
+		now += 10ms;
+		CHECK(wheel.advance() == 1);
+		CHECK(alarm._rings == 2);
+	}
+
+	TEST_CASE("timers of all levels expire on their ticks") {
+		ManualClock::time_point now{};
+		Wheel wheel(1ms, ManualClock{ &now });
+
+		struct Due
+		{
+			ManualClock::time_point _at;
+			ManualClock::time_point* _now;
+			std::optional<ManualClock::time_point> _expired;
+
+			void expire() { _expired = *_now; }
+		};
+
+		std::mt19937_64 random(42);
+		std::vector<std::int64_t> delays = { 1, 63, 64, 65, 4'095, 4'096, 4'097,
+											 262'143, 262'144, 16'777'216, 68'719'476'736 + 5 };
+		for (int i = 0; i != 2'000; ++i)
+			delays.push_back(std::int64_t(random() % 300'000) + 1);
+
+		std::vector<Due> dues;
+		dues.reserve(delays.size());
+		std::vector<Timer> timers;
+		for (std::int64_t delay : delays)
+		{
+			dues.push_back(Due{ now + std::chrono::milliseconds(delay), &now, std::nullopt });
+			timers.push_back(wheel.schedule(std::chrono::milliseconds(delay),
+											fromMethod<&Due::expire>(&dues.back())));
+		}
+
+		//advance in irregular steps, some of them much longer than a tick
+		std::vector<ManualClock::time_point> advances;
+		std::size_t expired = 0;
+		auto advance = [&]
+		{
+			advances.push_back(now);
+			expired += wheel.advance();
+		};
+		while (now < ManualClock::time_point(400'000ms))
+		{
+			now += std::chrono::milliseconds(random() % 700 + 1);
+			advance();
+		}
+
+		now = ManualClock::time_point(68'719'476'736ms + 4ms);
+		advance();
+		CHECK(wheel.count() == 1);
+		now += 1ms;
+		advance();
+		CHECK(expired == delays.size());
+		CHECK(wheel.empty());
+
+		//every timer expired at the first advance at or after its time
+		for (const Due& due : dues)
+		{
+			REQUIRE(due._expired.has_value());
+			CHECK(*due._expired == *std::lower_bound(advances.begin(), advances.end(), due._at));
+		}
+	}
+
+	TEST_CASE("callbacks schedule and cancel timers") {
+		ManualClock::time_point now{};
+		Wheel wheel(1ms, ManualClock{ &now });
+		int nExpired = 0;
+		std::optional<Timer> first, second, later;
+
+		SUBCASE("of the same tick") {
+			//whichever expires first cancels the other one
+			auto cancelSecond = [&] { ++nExpired; second.reset(); };
+			auto cancelFirst = [&] { ++nExpired; first.reset(); };
+			first = wheel.schedule(2ms, fromFunctor(cancelSecond));
+			second = wheel.schedule(2ms, fromFunctor(cancelFirst));
+
+			now += 2ms;
+			CHECK(wheel.advance() == 1);
+			CHECK(nExpired == 1);
+			CHECK(wheel.empty());
+		}
+		SUBCASE("scheduled without delay expire on the next tick") {
+			auto count = [&] { ++nExpired; };
+			auto reschedule = [&]
+			{
+				++nExpired;
+				later = wheel.schedule(0ms, fromFunctor(count));
+			};
+			first = wheel.schedule(1ms, fromFunctor(reschedule));
+
+			now += 1ms;
+			CHECK(wheel.advance() == 1);
+			CHECK(later->scheduled());
+
+			now += 1ms;
+			CHECK(wheel.advance() == 1);
+			CHECK(nExpired == 2);
+		}
+	}
+
+	TEST_CASE("callbacks schedule timers into the slot being expired") {
+		ManualClock::time_point now{};
+		Wheel wheel(1ms, ManualClock{ &now });
+
+		//64 ticks ahead is the slot of level 0 that is being processed
+		struct Rearming
+		{
+			Wheel* _wheel;
+			ManualClock::time_point* _now;
+			std::vector<ManualClock::time_point> _fired;
+			std::optional<Timer> _timer;
+
+			void fire()
+			{
+				_fired.push_back(*_now);
+				if (_fired.size() != 3)
+					_timer = _wheel->schedule(64ms, fromMethod<&Rearming::fire>(this));
+			}
+		};
+		Rearming rearming{ &wheel, &now, {}, std::nullopt };
+		std::vector<ManualClock::time_point>& fired = rearming._fired;
+		std::optional<Timer>& timer = rearming._timer;
+		timer = wheel.schedule(10ms, fromMethod<&Rearming::fire>(&rearming));
+
+		now += 10ms;
+		CHECK(wheel.advance() == 1);
+		CHECK(fired.size() == 1);
+		CHECK(timer->scheduled());
+
+		now += 63ms;
+		CHECK(wheel.advance() == 0);
+		now += 1ms;
+		CHECK(wheel.advance() == 1);
+
+		//a single long advance expires every timer at its own tick
+		now += 1s;
+		CHECK(wheel.advance() == 1);
+		CHECK(fired == std::vector<ManualClock::time_point>{
+			ManualClock::time_point(10ms), ManualClock::time_point(74ms), ManualClock::time_point(1074ms) });
+		CHECK(wheel.empty());
+
+		SUBCASE("throttle with an interval of 64 ticks") {
+			ThrottledEvent<void(int), Wheel> throttled(wheel, 64ms);
+			std::vector<int> log;
+			auto record = [&log](int i) { log.push_back(i); };
+			Subscription sub = throttled.subscribe(fromFunctor(record));
+
+			throttled.post(1);
+			throttled.post(2);
+			now += 64ms;
+			wheel.advance();
+			CHECK(log == std::vector<int>{ 1, 2 });
+
+			//the trailing raise started the next interval
+			throttled.post(3);
+			now += 63ms;
+			wheel.advance();
+			CHECK(log.size() == 2);
+			now += 1ms;
+			wheel.advance();
+			CHECK(log == std::vector<int>{ 1, 2, 3 });
+		}
+	}
+
+	TEST_CASE("timers outlive the wheel") {
+		ManualClock::time_point now{};
+		Alarm alarm;
+		std::optional<Wheel> wheel(std::in_place, 1ms, ManualClock{ &now });
+		Timer t = wheel->schedule(1ms, fromMethod<&Alarm::ring>(&alarm));
+		std::vector<Timer> timers;
+		timers.push_back(wheel->schedule(1s, fromMethod<&Alarm::ring>(&alarm)));
+
+		wheel.reset();
+		CHECK(!t.scheduled());
+		CHECK(!timers.front().scheduled());
+		Timer moved = std::move(t);
+		timers.clear();
+	}
+
+	TEST_CASE("owning callbacks") {
+		using OwningT = OwningDelegate<void()>;
+		ManualClock::time_point now{};
+		TimerWheel<ManualClock, OwningT> wheel(1ms, ManualClock{ &now });
+		wheel.reserve(4);
+
+		auto counter = std::make_shared<int>(0);
+		Timer kept = wheel.schedule(1ms, OwningT::make([counter] { ++*counter; }));
+		Timer cancelled = wheel.schedule(1ms, OwningT::make([counter] { ++*counter; }));
+		CHECK(counter.use_count() == 3);
+
+		cancelled.cancel();
+		CHECK(counter.use_count() == 2);
+
+		now += 1ms;
+		CHECK(wheel.advance() == 1);
+		CHECK(*counter == 1);
+		CHECK(counter.use_count() == 1);
+	}
+
+	TEST_CASE("debounce") {
+		ManualClock::time_point now{};
+		Wheel wheel(1ms, ManualClock{ &now });
+		DebouncedEvent<void(int), Wheel> typed(wheel, 10ms);
+		std::vector<int> log;
+		auto record = [&log](int i) { log.push_back(i); };
+		Subscription s = typed.subscribe(fromFunctor(record));
+
+		for (int key = 1; key <= 5; ++key)
+		{
+			typed.post(key);
+			now += 5ms;
+			wheel.advance();
+		}
+		CHECK(log.empty());
+		CHECK(typed.pending());
+
+		now += 5ms;
+		wheel.advance();
+		CHECK(log == std::vector<int>{ 5 });
+		CHECK(!typed.pending());
+		CHECK(wheel.empty());
+	}
+
+	TEST_CASE("throttle") {
+		ManualClock::time_point now{};
+		auto sum = [](int& pending, int delta) { pending += delta; };
+		Wheel wheel(1ms, ManualClock{ &now });
+		ThrottledEvent<void(int), Wheel, decltype(sum)> scrolled(wheel, 10ms, sum);
+		std::vector<int> log;
+		auto record = [&log](int i) { log.push_back(i); };
+		Subscription s = scrolled.subscribe(fromFunctor(record));
+
+		scrolled.post(1);
+		CHECK(log == std::vector<int>{ 1 });
+
+		for (int i = 0; i != 4; ++i)
+		{
+			now += 2ms;
+			wheel.advance();
+			scrolled.post(2);
+		}
+		CHECK(log == std::vector<int>{ 1 });
+
+		//the trailing raise at 10ms starts the next interval
+		now += 2ms;
+		wheel.advance();
+		CHECK(log == std::vector<int>{ 1, 8 });
+		scrolled.post(3);
+		CHECK(log.size() == 2);
+
+		now += 10ms;
+		wheel.advance();
+		CHECK(log == std::vector<int>{ 1, 8, 3 });
+
+		//quiet for an interval, the next raise is immediate again
+		now += 10ms;
+		wheel.advance();
+		CHECK(wheel.empty());
+		scrolled.post(4);
+		CHECK(log == std::vector<int>{ 1, 8, 3, 4 });
+	}
+
+	TEST_CASE("steady clock") {
+		TimerWheel<> wheel(1ms);
+		Alarm alarm;
+		Timer t = wheel.schedule(0ms, fromMethod<&Alarm::ring>(&alarm));
+		while (t.scheduled())
+			wheel.advance();
+		CHECK(alarm._rings == 1);
+	}
+}
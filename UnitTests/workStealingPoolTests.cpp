@@ -0,0 +1,133 @@
+#include <atomic>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+#include "CallMe.WorkStealingPool.h"
+
+using namespace CallMe;
+
+namespace
+{
+	struct Tenant
+	{
+		void recompute(const std::string& name, int times)
+		{
+			_name = name;
+			_total += times;
+			_thread = std::this_thread::get_id();
+		}
+
+		std::string _name;
+		int _total = 0;
+		std::thread::id _thread;
+	};
+}
+
+TEST_SUITE("work stealing pool tests")
+{
+	TEST_CASE("parallelFor covers the range once") {
+		WorkStealingPool pool(3);
+		CHECK(pool.workers() == 3);
+
+		for (std::ptrdiff_t count : { 0, 1, 7, 64, 1000 })
+		{
+			for (std::ptrdiff_t grain : { 1, 3, 16 })
+			{
+				std::vector<std::atomic<int>> visits(count);
+				auto chunk = [&](std::ptrdiff_t first, std::ptrdiff_t last)
+				{
+					CHECK(last - first <= grain);
+					for (std::ptrdiff_t i = first; i != last; ++i)
+						++visits[i];
+				};
+				pool.parallelFor(count, grain, fromFunctor(chunk));
+
+				int wrong = 0;
+				for (std::atomic<int>& v : visits)
+					wrong += v != 1;
+				CHECK(wrong == 0);
+			}
+		}
+	}
+
+	TEST_CASE("nested and concurrent parallelFor") {
+		WorkStealingPool pool(2);
+		std::atomic<int> sum{ 0 };
+
+		auto inner = [&](std::ptrdiff_t first, std::ptrdiff_t last)
+		{
+			sum += int(last - first);
+		};
+		auto outer = [&](std::ptrdiff_t first, std::ptrdiff_t last)
+		{
+			for (std::ptrdiff_t i = first; i != last; ++i)
+				pool.parallelFor(10, 2, fromFunctor(inner));
+		};
+
+		std::thread other([&] { pool.parallelFor(20, 1, fromFunctor(outer)); });
+		pool.parallelFor(20, 1, fromFunctor(outer));
+		other.join();
+		CHECK(sum == 400);
+	}
+
+	TEST_CASE("pool without workers") {
+		WorkStealingPool pool(0);
+		int sum = 0;
+		auto chunk = [&](std::ptrdiff_t first, std::ptrdiff_t last) { sum += int(last - first); };
+		pool.parallelFor(100, 7, fromFunctor(chunk));
+		CHECK(sum == 100);
+	}
+
+	TEST_CASE("Event::raiseParallel") {
+		WorkStealingPool pool(3);
+		Event<void(const std::string&, int)> event;
+		std::vector<Tenant> tenants(100);
+		std::vector<Subscription> subscriptions;
+		for (Tenant& t : tenants)
+			event.subscribe(fromMethod<&Tenant::recompute>(&t), subscriptions);
+
+		SUBCASE("all callbacks are invoked once") {
+			event.raiseParallel(pool, ParallelGrain{ 4 }, std::string("tenant"), 2);
+			event.raiseParallel(pool, "tenant", 3);
+
+			int wrong = 0;
+			for (Tenant& t : tenants)
+				wrong += t._total != 5 || t._name != "tenant";
+			CHECK(wrong == 0);
+		}
+		SUBCASE("a single chunk runs on the calling thread") {
+			event.raiseParallel(pool, ParallelGrain{ 100 }, "tenant", 1);
+			int elsewhere = 0;
+			for (Tenant& t : tenants)
+				elsewhere += t._thread != std::this_thread::get_id();
+			CHECK(elsewhere == 0);
+		}
+		SUBCASE("batchable callbacks and tombstones") {
+			Event<void(const std::string&, int)> batched;
+			std::vector<Subscription> batchedSubscriptions;
+			for (Tenant& t : tenants)
+				batched.subscribe<&Tenant::recompute>(t, batchedSubscriptions);
+			batchedSubscriptions.erase(batchedSubscriptions.begin(), batchedSubscriptions.begin() + 10);
+
+			batched.raiseParallel(pool, ParallelGrain{ 8 }, "batch", 1);
+			CHECK(std::accumulate(tenants.begin(), tenants.end(), 0,
+								  [](int sum, const Tenant& t) { return sum + t._total; }) == 90);
+		}
+		SUBCASE("unsubscription by the calling thread's callback is deferred") {
+			std::optional<Subscription> s;
+			int invoked = 0;
+			auto once = [&](const std::string&, int) { ++invoked; s.reset(); };
+			s = event.subscribe(fromFunctor(once));
+
+			event.raiseParallel(pool, ParallelGrain{ 200 }, "tenant", 1);
+			event.raiseParallel(pool, ParallelGrain{ 200 }, "tenant", 1);
+			CHECK(invoked == 1);
+			CHECK(event.count() == 100);
+		}
+	}
+}